@@ -0,0 +1,13 @@
+using UnrealBuildTool;
+
+// Engine-free wire math shared by the PROGRAMM game module, the editor tools and the PowerLineCoreTests
+// low-level test program. Core only: anything that needs UObjects, the renderer or a world stays in PROGRAMM.
+public class PowerLineCore : ModuleRules
+{
+	public PowerLineCore(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PublicDependencyModuleNames.Add("Core");
+	}
+}
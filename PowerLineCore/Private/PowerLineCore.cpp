@@ -0,0 +1,1512 @@
+#include "PowerLineCore.h"
+
+#include "Math/RandomStream.h"
+#include "Algo/Sort.h"
+#include "Async/ParallelFor.h"
+#include "Modules/ModuleManager.h"
+
+IMPLEMENT_MODULE(FDefaultModuleImpl, PowerLineCore);
+
+namespace PowerLineCore
+{
+	uint32 HashLine(const FVector& A, const FVector& B, int32 LineId)
+	{
+		// Quantize to reduce jitter when actors move by tiny amounts (also keeps hash stable in editor).
+		auto Q = [](const FVector& V) {
+			// 1 cm precision
+			return FIntVector(
+				FMath::RoundToInt(V.X),
+				FMath::RoundToInt(V.Y),
+				FMath::RoundToInt(V.Z));
+			};
+
+		uint32 H = 0;
+		H = HashCombine(H, GetTypeHash(Q(A)));
+		H = HashCombine(H, GetTypeHash(Q(B)));
+		H = HashCombine(H, GetTypeHash(LineId));
+		return H;
+	}
+
+	float ComputeSag(const FSagParams& Params, const FVector& A, const FVector& B, int32 LineId)
+	{
+		const float MinS = FMath::Min(Params.MinCm, Params.MaxCm);
+		const float MaxS = FMath::Max(Params.MinCm, Params.MaxCm);
+
+		float Value = 0.f;
+		if (Params.bDeterministic)
+		{
+			FRandomStream R(Params.Seed ^ (int32)HashLine(A, B, LineId));
+			Value = R.FRandRange(MinS, MaxS);
+		}
+		else
+		{
+			Value = FMath::FRandRange(MinS, MaxS);
+		}
+
+		return FMath::Max(0.f, Value * Params.Scale);
+	}
+
+	int32 ComputeSegments(const FSegmentParams& Params, float LengthCm)
+	{
+		if (!Params.bAuto)
+		{
+			return FMath::Max(1, Params.Fixed);
+		}
+
+		const float Step = FMath::Max(10.f, Params.TargetLengthCm);
+		const int32 Raw = FMath::CeilToInt(LengthCm / Step);
+		return FMath::Clamp(Raw, FMath::Max(1, Params.Min), FMath::Max(1, Params.Max));
+	}
+
+	bool ComputeHanging(const FHangingParams& Params, const FVector& A, const FVector& B, int32 LineId, FHangingResult& Out)
+	{
+		Out = FHangingResult();
+
+		if (Params.PoolSize <= 0) return false;
+		if (Params.Chance <= 0.f) return false;
+
+		const float MinN = FMath::Clamp(FMath::Min(Params.DistanceRange.X, Params.DistanceRange.Y), 0.f, 1.f);
+		const float MaxN = FMath::Clamp(FMath::Max(Params.DistanceRange.X, Params.DistanceRange.Y), 0.f, 1.f);
+		if (MaxN <= MinN) return false;
+
+		FRandomStream R;
+		if (Params.bDeterministic)
+		{
+			R.Initialize(Params.Seed ^ (int32)HashLine(A, B, LineId));
+		}
+		else
+		{
+			R.GenerateNewSeed();
+		}
+
+		if (R.FRand() > Params.Chance) return false;
+
+		Out.MeshIndex = R.RandRange(0, Params.PoolSize - 1);
+		Out.NormalizedDistance = R.FRandRange(MinN, MaxN);
+		Out.YawDeg = (Params.RandomYawDeg > 0.f) ? R.FRandRange(-Params.RandomYawDeg, Params.RandomYawDeg) : 0.f;
+		return true;
+	}
+
+	void ResolveSpan(const FSpanInput& Span, const FDistrictParams* District, float& OutSag, int32& OutSegments)
+	{
+		OutSag = Span.WireSag;
+		OutSegments = FMath::Max(2, Span.WireSegments);
+
+		if (District)
+		{
+			OutSag = ComputeSag(District->Sag, Span.Start, Span.End, Span.LineId);
+			// Use both sources so per-wire segments can always increase detail,
+			// while district auto/fixed policy still affects baseline segmentation.
+			const int32 DistrictSegments = ComputeSegments(District->Segments, FVector::Dist(Span.Start, Span.End));
+			OutSegments = FMath::Max(2, FMath::Max(Span.WireSegments, DistrictSegments));
+		}
+	}
+
+	bool BuildSaggedCurve(const FVector& Start, const FVector& End, float Sag, int32 NumSegments, TArray<FVector>& OutPoints)
+	{
+		OutPoints.Reset();
+
+		auto PointAt = [&](float T) {
+			const FVector P = FMath::Lerp(Start, End, T);
+			const float SagFactor = FMath::Clamp(4.f * T * (1.f - T), 0.f, 1.f);
+			return P - FVector(0, 0, Sag * SagFactor);
+			};
+
+		const int32 SampleCount = FMath::Clamp(NumSegments * 8, 32, 512);
+		TArray<FVector, TInlineAllocator<129>> Samples;
+		Samples.Reserve(SampleCount + 1);
+
+		TArray<float, TInlineAllocator<129>> CumLen;
+		CumLen.Reserve(SampleCount + 1);
+
+		float TotalLen = 0.f;
+		FVector Prev = PointAt(0.f);
+		Samples.Add(Prev);
+		CumLen.Add(0.f);
+
+		for (int32 i = 1; i <= SampleCount; ++i)
+		{
+			const float T = (float)i / (float)SampleCount;
+			const FVector Cur = PointAt(T);
+			TotalLen += FVector::Dist(Prev, Cur);
+			Samples.Add(Cur);
+			CumLen.Add(TotalLen);
+			Prev = Cur;
+		}
+
+		if (TotalLen <= KINDA_SMALL_NUMBER)
+		{
+			return false;
+		}
+
+		// Targets are increasing, so walk the samples once.
+		OutPoints.Reserve(NumSegments + 1);
+		int32 Idx = 1;
+		for (int32 i = 0; i <= NumSegments; ++i)
+		{
+			const float TargetLen = (TotalLen * (float)i) / (float)NumSegments;
+			while (Idx < CumLen.Num() - 1 && CumLen[Idx] < TargetLen)
+			{
+				++Idx;
+			}
+
+			const float L0 = CumLen[Idx - 1];
+			const float L1 = CumLen[Idx];
+			const float A = (L1 > L0) ? FMath::Clamp((TargetLen - L0) / (L1 - L0), 0.f, 1.f) : 0.f;
+			OutPoints.Add(FMath::Lerp(Samples[Idx - 1], Samples[Idx], A));
+		}
+
+		return true;
+	}
+
+	bool BuildSaggedBundle(const FVector& Start, const FVector& End, float Sag, int32 NumSegments,
+		TArrayView<const FVector> StartOffsets, TArrayView<const FVector> EndOffsets, TArray<FVector>& OutPoints)
+	{
+		OutPoints.Reset();
+
+		const int32 NumConductors = FMath::Min(StartOffsets.Num(), EndOffsets.Num());
+		if (NumConductors == 0 || NumSegments < 1) return false;
+
+		auto SagFactorAt = [](float T) {
+			return FMath::Clamp(4.f * T * (1.f - T), 0.f, 1.f);
+			};
+
+		// Same sampling as BuildSaggedCurve, but on the centre curve only and keeping the curve parameter.
+		const int32 SampleCount = FMath::Clamp(NumSegments * 8, 32, 512);
+		TArray<float, TInlineAllocator<129>> CumLen;
+		CumLen.Reserve(SampleCount + 1);
+		CumLen.Add(0.f);
+
+		float TotalLen = 0.f;
+		FVector Prev = Start;
+		for (int32 i = 1; i <= SampleCount; ++i)
+		{
+			const float T = (float)i / (float)SampleCount;
+			const FVector Cur = FMath::Lerp(Start, End, T) - FVector(0, 0, Sag * SagFactorAt(T));
+			TotalLen += FVector::Dist(Prev, Cur);
+			CumLen.Add(TotalLen);
+			Prev = Cur;
+		}
+
+		if (TotalLen <= KINDA_SMALL_NUMBER)
+		{
+			return false;
+		}
+
+		// Curve parameter and sag drop of every output point, shared by all conductors.
+		TArray<float, TInlineAllocator<65>> Params;
+		TArray<FVector, TInlineAllocator<65>> Centre;
+		Params.Reserve(NumSegments + 1);
+		Centre.Reserve(NumSegments + 1);
+
+		int32 Idx = 1;
+		for (int32 i = 0; i <= NumSegments; ++i)
+		{
+			const float TargetLen = (TotalLen * (float)i) / (float)NumSegments;
+			while (Idx < CumLen.Num() - 1 && CumLen[Idx] < TargetLen)
+			{
+				++Idx;
+			}
+
+			const float L0 = CumLen[Idx - 1];
+			const float L1 = CumLen[Idx];
+			const float A = (L1 > L0) ? FMath::Clamp((TargetLen - L0) / (L1 - L0), 0.f, 1.f) : 0.f;
+			const float T = ((float)(Idx - 1) + A) / (float)SampleCount;
+
+			Params.Add(T);
+			Centre.Add(FMath::Lerp(Start, End, T) - FVector(0, 0, Sag * SagFactorAt(T)));
+		}
+
+		// Each conductor is the centre curve plus its offset blended from start to end.
+		OutPoints.SetNumUninitialized(NumConductors * (NumSegments + 1));
+		FVector* Out = OutPoints.GetData();
+		for (int32 c = 0; c < NumConductors; ++c)
+		{
+			const FVector A = StartOffsets[c];
+			const FVector D = EndOffsets[c] - A;
+			for (int32 i = 0; i <= NumSegments; ++i)
+			{
+				*Out++ = Centre[i] + A + D * Params[i];
+			}
+		}
+
+		return true;
+	}
+
+	bool BuildBrokenPieces(TArrayView<const FVector> Points, float BreakT, float GroundZA, float GroundZB,
+		TArray<FVector>& OutA, TArray<FVector>& OutB)
+	{
+		OutA.Reset();
+		OutB.Reset();
+
+		const int32 NumSegments = Points.Num() - 1;
+		if (NumSegments < 2) return false;
+
+		float TotalLen = 0.f;
+		for (int32 i = 0; i < NumSegments; ++i)
+		{
+			TotalLen += FVector::Dist(Points[i], Points[i + 1]);
+		}
+
+		const int32 SegA = FMath::Clamp(FMath::RoundToInt(NumSegments * BreakT), 1, NumSegments - 1);
+		const int32 SegB = NumSegments - SegA;
+		const FVector Cut = Points[SegA];
+
+		// Piece hangs straight down from its anchor after a short reach towards the cut; whatever is longer than the
+		// drop to the ground lies on the ground, continuing towards the cut.
+		auto Dangle = [Cut](const FVector& Anchor, float GroundZ, float Length, int32 Segs, TArray<FVector>& Out) {
+			const FVector Dir = FVector(Cut.X - Anchor.X, Cut.Y - Anchor.Y, 0.f).GetSafeNormal();
+			const float Drop = FMath::Clamp(Anchor.Z - GroundZ, 0.f, Length);
+			const float Reach = Drop * 0.1f;
+
+			Out.Reserve(Segs + 1);
+			for (int32 i = 0; i <= Segs; ++i)
+			{
+				const float S = Length * (float)i / (float)Segs;
+				if (S <= Drop)
+				{
+					const float U = Drop > KINDA_SMALL_NUMBER ? S / Drop : 1.f;
+					Out.Add(Anchor + Dir * (Reach * FMath::Sin(U * HALF_PI)) - FVector(0.f, 0.f, S));
+				}
+				else
+				{
+					Out.Add(Anchor + Dir * (Reach + S - Drop) - FVector(0.f, 0.f, Drop));
+				}
+			}
+			};
+
+		Dangle(Points[0], GroundZA, TotalLen * SegA / NumSegments, SegA, OutA);
+		Dangle(Points.Last(), GroundZB, TotalLen * SegB / NumSegments, SegB, OutB);
+		return true;
+	}
+
+	bool BuildSpan(const FSpanInput& Span, const FDistrictParams* District, TArray<FVector>& OutPoints)
+	{
+		float Sag = 0.f;
+		int32 Segments = 2;
+		ResolveSpan(Span, District, Sag, Segments);
+		return BuildSaggedCurve(Span.Start, Span.End, Sag, Segments, OutPoints);
+	}
+
+	// ============================
+	// Shape cache
+	// ============================
+
+	FShapeKey FShapeCache::MakeKey(const FVector& Delta, float Sag, int32 Segments)
+	{
+		FShapeKey Key;
+		Key.Delta = FIntVector(
+			FMath::RoundToInt(Delta.X),
+			FMath::RoundToInt(Delta.Y),
+			FMath::RoundToInt(Delta.Z));
+		Key.SagMm = FMath::RoundToInt(Sag * 10.f);
+		Key.Segments = Segments;
+		return Key;
+	}
+
+	TSharedRef<FShape, ESPMode::ThreadSafe> FShapeCache::BuildShape(const FShapeKey& Key)
+	{
+		// Build from the quantized key so every wire sharing it gets the exact same curve.
+		TSharedRef<FShape, ESPMode::ThreadSafe> Shape = MakeShared<FShape, ESPMode::ThreadSafe>();
+		BuildSaggedCurve(FVector::ZeroVector, FVector(Key.Delta), (float)Key.SagMm * 0.1f, Key.Segments, Shape->Points);
+		return Shape;
+	}
+
+	FShapePtr FShapeCache::Find(const FShapeKey& Key)
+	{
+		if (const int32* Found = Index.Find(Key))
+		{
+			++Hits;
+			FEntry& Entry = Entries[*Found];
+			Entry.bReferenced = true;
+			return Entry.Shape;
+		}
+		return nullptr;
+	}
+
+	FShapePtr FShapeCache::Add(const FShapeKey& Key, const TSharedRef<FShape, ESPMode::ThreadSafe>& Shape)
+	{
+		++Misses;
+
+		if (const int32* Found = Index.Find(Key))
+		{
+			return Entries[*Found].Shape;
+		}
+
+		// MaxEntries lowered since the last Add: trim from the back.
+		const int32 Capacity = FMath::Max(1, MaxEntries);
+		while (Entries.Num() > Capacity)
+		{
+			Index.Remove(Entries.Last().Key);
+			Entries.Pop();
+			++Evictions;
+		}
+
+		Shape->ShapeId = NextShapeId++;
+		FShapePtr Result = Shape;
+
+		int32 Slot = Entries.Num();
+		if (Slot < Capacity)
+		{
+			Entries.AddDefaulted();
+		}
+		else
+		{
+			// Clock: give every referenced entry a second chance, take the first one that was not found since.
+			// Wires drawn with an evicted shape keep it alive through their own pointer.
+			for (;;)
+			{
+				ClockHand = ClockHand < Entries.Num() ? ClockHand : 0;
+				FEntry& Candidate = Entries[ClockHand];
+				if (!Candidate.bReferenced) break;
+				Candidate.bReferenced = false;
+				++ClockHand;
+			}
+
+			Slot = ClockHand++;
+			Index.Remove(Entries[Slot].Key);
+			++Evictions;
+		}
+
+		FEntry& Entry = Entries[Slot];
+		Entry.Key = Key;
+		Entry.Shape = Result;
+		Entry.bReferenced = false;
+		Index.Add(Key, Slot);
+		return Result;
+	}
+
+	FShapePtr FShapeCache::FindOrBuild(const FVector& Delta, float Sag, int32 Segments)
+	{
+		const FShapeKey Key = MakeKey(Delta, Sag, Segments);
+		if (FShapePtr Found = Find(Key))
+		{
+			return Found;
+		}
+
+		return Add(Key, BuildShape(Key));
+	}
+
+	SIZE_T FShapeCache::GetAllocatedSize() const
+	{
+		SIZE_T Bytes = Index.GetAllocatedSize() + Entries.GetAllocatedSize();
+		for (const FEntry& Entry : Entries)
+		{
+			Bytes += sizeof(FShape) + Entry.Shape->Points.GetAllocatedSize();
+		}
+		return Bytes;
+	}
+
+	void FShapeCache::Reset()
+	{
+		Index.Reset();
+		Entries.Reset();
+		ClockHand = 0;
+		Hits = 0;
+		Misses = 0;
+		Evictions = 0;
+		Bypassed = 0;
+	}
+
+	// ============================
+	// Wind
+	// ============================
+
+	FWindAttributes PackWindAttributes(float SpanT0, float SpanT1, uint32 LineHash, float AmplitudeCm)
+	{
+		FWindAttributes Out;
+		Out.SpanT0 = (uint16)FMath::RoundToInt(FMath::Clamp(SpanT0, 0.f, 1.f) * 65535.f);
+		Out.SpanT1 = (uint16)FMath::RoundToInt(FMath::Clamp(SpanT1, 0.f, 1.f) * 65535.f);
+		Out.Phase = (uint16)(LineHash & 0xFFFF);
+		Out.Amplitude = (uint16)FMath::Clamp(FMath::RoundToInt(AmplitudeCm * 10.f), 0, 65535);
+		return Out;
+	}
+
+	void UnpackWindAttributes(const FWindAttributes& In, float& OutSpanT0, float& OutSpanT1, float& OutPhase, float& OutAmplitudeCm)
+	{
+		OutSpanT0 = (float)In.SpanT0 / 65535.f;
+		OutSpanT1 = (float)In.SpanT1 / 65535.f;
+		OutPhase = (float)In.Phase / 65536.f * UE_TWO_PI;
+		OutAmplitudeCm = (float)In.Amplitude * 0.1f;
+	}
+
+	FVector3f ComputeWindOffset(const FWindParams& Wind, float TimeSeconds, float SpanT, float Phase, float AmplitudeCm)
+	{
+		const float Shape = 4.f * SpanT * (1.f - SpanT);
+		const float Angle = UE_TWO_PI * Wind.Frequency * TimeSeconds + Phase;
+
+		// Mean lean + slow sway, plus a faster ripple travelling along the span.
+		const float Sway = 0.5f + 0.5f * FMath::Sin(Angle) + Wind.Gust * FMath::Sin(2.7f * Angle + 3.f * SpanT);
+		return Wind.Direction * (Wind.Strength * AmplitudeCm * Shape * Sway);
+	}
+
+	float GetMaxWindOffset(const FWindParams& Wind, float AmplitudeCm)
+	{
+		return FMath::Abs(Wind.Strength) * AmplitudeCm * (1.f + FMath::Abs(Wind.Gust));
+	}
+
+	// ============================
+	// Cable simulation
+	// ============================
+
+	void FCableState::Init(const TArray<FVector>& Points)
+	{
+		const int32 N = Points.Num();
+		Origin = N > 0 ? Points[0] : FVector::ZeroVector;
+		X.SetNumUninitialized(N);
+		Y.SetNumUninitialized(N);
+		Z.SetNumUninitialized(N);
+
+		float Length = 0.f;
+		for (int32 i = 0; i < N; ++i)
+		{
+			const FVector3f P = FVector3f(Points[i] - Origin);
+			X[i] = P.X;
+			Y[i] = P.Y;
+			Z[i] = P.Z;
+			if (i > 0)
+			{
+				Length += FVector3f::Dist(P, FVector3f(X[i - 1], Y[i - 1], Z[i - 1]));
+			}
+		}
+
+		PX = X;
+		PY = Y;
+		PZ = Z;
+		RestLength = N > 1 ? Length / (float)(N - 1) : 0.f;
+		Accumulator = 0.f;
+		LastMaxSpeed = 0.f;
+	}
+
+	void FCableState::AddImpulse(const FVector& Center, float Radius, const FVector& Velocity, float SubstepSeconds)
+	{
+		if (Radius <= 0.f) return;
+
+		const FVector3f C = FVector3f(Center - Origin);
+		const FVector3f Dv = FVector3f(Velocity) * SubstepSeconds;
+		for (int32 i = 1; i + 1 < X.Num(); ++i)
+		{
+			const float Dist = FVector3f::Dist(C, FVector3f(X[i], Y[i], Z[i]));
+			if (Dist >= Radius) continue;
+
+			// Verlet velocity is (X - PX) / dt: moving the previous position back adds velocity.
+			const float W = 1.f - Dist / Radius;
+			PX[i] -= Dv.X * W;
+			PY[i] -= Dv.Y * W;
+			PZ[i] -= Dv.Z * W;
+		}
+	}
+
+	float FCableState::Step(const FCableSimParams& Params, const FVector& PinA, const FVector& PinB, float DeltaSeconds)
+	{
+		const int32 N = X.Num();
+		if (N < 2 || Params.SubstepSeconds <= 0.f) return 0.f;
+
+		const float H = Params.SubstepSeconds;
+		Accumulator = FMath::Min(Accumulator + DeltaSeconds, H * (float)FMath::Max(1, Params.MaxSubsteps));
+		if (Accumulator < H) return LastMaxSpeed;
+
+		const FVector3f A = FVector3f(PinA - Origin);
+		const FVector3f B = FVector3f(PinB - Origin);
+		const float Keep = 1.f - FMath::Clamp(Params.Damping, 0.f, 1.f);
+		const float G = Params.GravityZ * H * H;
+
+		float* RESTRICT Xs = X.GetData();
+		float* RESTRICT Ys = Y.GetData();
+		float* RESTRICT Zs = Z.GetData();
+		float* RESTRICT PXs = PX.GetData();
+		float* RESTRICT PYs = PY.GetData();
+		float* RESTRICT PZs = PZ.GetData();
+
+		while (Accumulator >= H)
+		{
+			Accumulator -= H;
+
+			// Integrate (independent per particle, vectorizes).
+			for (int32 i = 0; i < N; ++i)
+			{
+				const float NX = Xs[i] + (Xs[i] - PXs[i]) * Keep;
+				const float NY = Ys[i] + (Ys[i] - PYs[i]) * Keep;
+				const float NZ = Zs[i] + (Zs[i] - PZs[i]) * Keep + G;
+				PXs[i] = Xs[i];
+				PYs[i] = Ys[i];
+				PZs[i] = Zs[i];
+				Xs[i] = NX;
+				Ys[i] = NY;
+				Zs[i] = NZ;
+			}
+
+			Xs[0] = A.X; Ys[0] = A.Y; Zs[0] = A.Z;
+			Xs[N - 1] = B.X; Ys[N - 1] = B.Y; Zs[N - 1] = B.Z;
+
+			// Link lengths (Gauss-Seidel; pinned ends take no correction).
+			for (int32 Iter = 0; Iter < Params.Iterations; ++Iter)
+			{
+				for (int32 i = 0; i + 1 < N; ++i)
+				{
+					const float DX = Xs[i + 1] - Xs[i];
+					const float DY = Ys[i + 1] - Ys[i];
+					const float DZ = Zs[i + 1] - Zs[i];
+					const float Len = FMath::Sqrt(DX * DX + DY * DY + DZ * DZ);
+					if (Len <= KINDA_SMALL_NUMBER) continue;
+
+					const float WA = (i == 0) ? 0.f : 1.f;
+					const float WB = (i + 1 == N - 1) ? 0.f : 1.f;
+					const float WSum = WA + WB;
+					if (WSum <= 0.f) continue;
+
+					const float K = (Len - RestLength) / (Len * WSum);
+					Xs[i] += DX * K * WA;
+					Ys[i] += DY * K * WA;
+					Zs[i] += DZ * K * WA;
+					Xs[i + 1] -= DX * K * WB;
+					Ys[i + 1] -= DY * K * WB;
+					Zs[i + 1] -= DZ * K * WB;
+				}
+			}
+		}
+
+		float MaxSpeedSq = 0.f;
+		for (int32 i = 0; i < N; ++i)
+		{
+			const float VX = Xs[i] - PXs[i];
+			const float VY = Ys[i] - PYs[i];
+			const float VZ = Zs[i] - PZs[i];
+			MaxSpeedSq = FMath::Max(MaxSpeedSq, VX * VX + VY * VY + VZ * VZ);
+		}
+
+		LastMaxSpeed = FMath::Sqrt(MaxSpeedSq) / H;
+		return LastMaxSpeed;
+	}
+
+	void FCableState::GetPoints(TArray<FVector>& Out) const
+	{
+		Out.SetNumUninitialized(X.Num());
+		for (int32 i = 0; i < X.Num(); ++i)
+		{
+			Out[i] = Origin + FVector(X[i], Y[i], Z[i]);
+		}
+	}
+
+	// ============================
+	// Wire queries
+	// ============================
+
+	float ClosestSegmentSegment(const FVector3f& P0, const FVector3f& P1, const FVector3f& Q0, const FVector3f& Q1, float& OutS, float& OutT)
+	{
+		const FVector3f D1 = P1 - P0;
+		const FVector3f D2 = Q1 - Q0;
+		const FVector3f R = P0 - Q0;
+		const float A = D1 | D1;
+		const float E = D2 | D2;
+		const float F = D2 | R;
+
+		float S = 0.f;
+		float T = 0.f;
+		if (A <= SMALL_NUMBER && E <= SMALL_NUMBER)
+		{
+			// Both degenerate
+		}
+		else if (A <= SMALL_NUMBER)
+		{
+			T = FMath::Clamp(F / E, 0.f, 1.f);
+		}
+		else
+		{
+			const float C = D1 | R;
+			if (E <= SMALL_NUMBER)
+			{
+				S = FMath::Clamp(-C / A, 0.f, 1.f);
+			}
+			else
+			{
+				const float B = D1 | D2;
+				const float Denom = A * E - B * B;
+				S = (Denom > SMALL_NUMBER) ? FMath::Clamp((B * F - C * E) / Denom, 0.f, 1.f) : 0.f;
+				T = (B * S + F) / E;
+
+				if (T < 0.f)
+				{
+					T = 0.f;
+					S = FMath::Clamp(-C / A, 0.f, 1.f);
+				}
+				else if (T > 1.f)
+				{
+					T = 1.f;
+					S = FMath::Clamp((B - C) / A, 0.f, 1.f);
+				}
+			}
+		}
+
+		OutS = S;
+		OutT = T;
+		return ((P0 + D1 * S) - (Q0 + D2 * T)).SizeSquared();
+	}
+
+	float ClosestPointSegment(const FVector3f& P, const FVector3f& A, const FVector3f& B, float& OutT)
+	{
+		const FVector3f AB = B - A;
+		const float LenSq = AB | AB;
+		OutT = (LenSq > SMALL_NUMBER) ? FMath::Clamp(((P - A) | AB) / LenSq, 0.f, 1.f) : 0.f;
+		return (P - (A + AB * OutT)).SizeSquared();
+	}
+
+	void AppendWireSegments(TArrayView<const FVector> Points, const FVector& Origin, int32 Wire, TArray<FWireSegment>& Out)
+	{
+		float Along = 0.f;
+		for (int32 i = 0; i + 1 < Points.Num(); ++i)
+		{
+			FWireSegment& Seg = Out.AddDefaulted_GetRef();
+			Seg.A = FVector3f(Points[i] - Origin);
+			Seg.B = FVector3f(Points[i + 1] - Origin);
+			Seg.Wire = Wire;
+			Seg.DistanceAlongWire = Along;
+			Along += FVector3f::Dist(Seg.A, Seg.B);
+		}
+	}
+
+	void FSegmentBVH::Build(TArray<FWireSegment>&& InSegments, const FVector& InOrigin, int32 LeafSize)
+	{
+		Segments = MoveTemp(InSegments);
+		Origin = InOrigin;
+		Nodes.Reset();
+
+		if (Segments.Num() == 0) return;
+
+		LeafSize = FMath::Max(1, LeafSize);
+		Nodes.Reserve(2 * (Segments.Num() / LeafSize) + 1);
+		Nodes.AddDefaulted();
+
+		struct FTask
+		{
+			int32 Node;
+			int32 First;
+			int32 Count;
+		};
+
+		TArray<FTask, TInlineAllocator<64>> Stack;
+		Stack.Add({ 0, 0, Segments.Num() });
+
+		while (Stack.Num() > 0)
+		{
+			const FTask Task = Stack.Pop();
+
+			FVector3f Min(MAX_flt);
+			FVector3f Max(-MAX_flt);
+			FVector3f CMin(MAX_flt);
+			FVector3f CMax(-MAX_flt);
+			for (int32 i = Task.First; i < Task.First + Task.Count; ++i)
+			{
+				const FWireSegment& Seg = Segments[i];
+				Min = Min.ComponentMin(Seg.A).ComponentMin(Seg.B);
+				Max = Max.ComponentMax(Seg.A).ComponentMax(Seg.B);
+
+				const FVector3f C = (Seg.A + Seg.B) * 0.5f;
+				CMin = CMin.ComponentMin(C);
+				CMax = CMax.ComponentMax(C);
+			}
+
+			Nodes[Task.Node].Min = Min;
+			Nodes[Task.Node].Max = Max;
+
+			// Split on the widest centroid axis at the median.
+			const FVector3f Extent = CMax - CMin;
+			const int32 Axis = (Extent.X >= Extent.Y && Extent.X >= Extent.Z) ? 0 : (Extent.Y >= Extent.Z ? 1 : 2);
+
+			if (Task.Count <= LeafSize || Extent[Axis] <= KINDA_SMALL_NUMBER)
+			{
+				Nodes[Task.Node].First = Task.First;
+				Nodes[Task.Node].Count = Task.Count;
+				continue;
+			}
+
+			Algo::Sort(TArrayView<FWireSegment>(Segments.GetData() + Task.First, Task.Count),
+				[Axis](const FWireSegment& X, const FWireSegment& Y) {
+					return (X.A[Axis] + X.B[Axis]) < (Y.A[Axis] + Y.B[Axis]);
+				});
+
+			const int32 Left = Nodes.Num();
+			Nodes.AddDefaulted(2);
+			Nodes[Task.Node].First = Left;
+			Nodes[Task.Node].Count = 0;
+
+			const int32 Half = Task.Count / 2;
+			Stack.Add({ Left, Task.First, Half });
+			Stack.Add({ Left + 1, Task.First + Half, Task.Count - Half });
+		}
+	}
+
+	FBox FSegmentBVH::GetBounds() const
+	{
+		if (Nodes.Num() == 0) return FBox(ForceInit);
+		return FBox(FVector(Nodes[0].Min) + Origin, FVector(Nodes[0].Max) + Origin);
+	}
+
+	static float BoxDistSq(const FVector3f& P, const FVector3f& Min, const FVector3f& Max)
+	{
+		const FVector3f D = (Min - P).ComponentMax(P - Max).ComponentMax(FVector3f::ZeroVector);
+		return D.SizeSquared();
+	}
+
+	// Segment P0 + Dir * t, t in [0, TMax] against an AABB (slab test).
+	static bool SegmentOverlapsBox(const FVector3f& P0, const FVector3f& Dir, const FVector3f& Min, const FVector3f& Max, float TMax)
+	{
+		float T0 = 0.f;
+		float T1 = TMax;
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			if (FMath::Abs(Dir[Axis]) < KINDA_SMALL_NUMBER)
+			{
+				if (P0[Axis] < Min[Axis] || P0[Axis] > Max[Axis]) return false;
+				continue;
+			}
+
+			const float Inv = 1.f / Dir[Axis];
+			float TA = (Min[Axis] - P0[Axis]) * Inv;
+			float TB = (Max[Axis] - P0[Axis]) * Inv;
+			if (TA > TB) Swap(TA, TB);
+
+			T0 = FMath::Max(T0, TA);
+			T1 = FMath::Min(T1, TB);
+			if (T0 > T1) return false;
+		}
+		return true;
+	}
+
+	bool FSegmentBVH::CapsuleCast(const FVector& Start, const FVector& End, float Radius, bool bAnyHit, FSegmentHit& OutHit) const
+	{
+		if (Nodes.Num() == 0) return false;
+
+		const FVector3f P0 = FVector3f(Start - Origin);
+		const FVector3f P1 = FVector3f(End - Origin);
+		const FVector3f Dir = P1 - P0;
+		const float Len = Dir.Size();
+		const float R = FMath::Max(0.f, Radius);
+		const float R2 = R * R;
+		const FVector3f Grow(R);
+
+		// Query parameter in [0, 1] of the best entry so far.
+		float BestT = 1.f;
+		int32 BestIdx = INDEX_NONE;
+		float BestS = 0.f;
+
+		TArray<int32, TInlineAllocator<64>> Stack;
+		Stack.Add(0);
+
+		while (Stack.Num() > 0)
+		{
+			const FNode& Node = Nodes[Stack.Pop()];
+			if (!SegmentOverlapsBox(P0, Dir, Node.Min - Grow, Node.Max + Grow, BestT)) continue;
+
+			if (Node.Count == 0)
+			{
+				Stack.Add(Node.First);
+				Stack.Add(Node.First + 1);
+				continue;
+			}
+
+			for (int32 i = Node.First; i < Node.First + Node.Count; ++i)
+			{
+				const FWireSegment& Seg = Segments[i];
+
+				float T = 0.f;
+				float S = 0.f;
+				const float D2 = ClosestSegmentSegment(P0, P1, Seg.A, Seg.B, T, S);
+				if (D2 > R2) continue;
+
+				// Step back from the closest approach to the capsule surface.
+				const float Back = (Len > KINDA_SMALL_NUMBER) ? FMath::Sqrt(R2 - D2) / Len : 0.f;
+				const float HitT = FMath::Max(0.f, T - Back);
+				if (BestIdx == INDEX_NONE || HitT < BestT)
+				{
+					BestT = HitT;
+					BestIdx = i;
+					BestS = S;
+				}
+
+				if (bAnyHit) break;
+			}
+
+			if (bAnyHit && BestIdx != INDEX_NONE) break;
+		}
+
+		if (BestIdx == INDEX_NONE) return false;
+
+		const FWireSegment& Seg = Segments[BestIdx];
+		OutHit.Wire = Seg.Wire;
+		OutHit.Segment = BestIdx;
+		OutHit.Distance = BestT * Len;
+		OutHit.DistanceAlongWire = Seg.DistanceAlongWire + BestS * FVector3f::Dist(Seg.A, Seg.B);
+		OutHit.Location = FVector(FMath::Lerp(Seg.A, Seg.B, BestS)) + Origin;
+		return true;
+	}
+
+	bool FSegmentBVH::FindNearest(const FVector& Point, float MaxDistance, FSegmentHit& OutHit) const
+	{
+		if (Nodes.Num() == 0) return false;
+
+		const FVector3f P = FVector3f(Point - Origin);
+		float BestSq = FMath::Square(FMath::Max(0.f, MaxDistance));
+		int32 BestIdx = INDEX_NONE;
+		float BestT = 0.f;
+
+		TArray<int32, TInlineAllocator<64>> Stack;
+		Stack.Add(0);
+
+		while (Stack.Num() > 0)
+		{
+			const FNode& Node = Nodes[Stack.Pop()];
+			if (BoxDistSq(P, Node.Min, Node.Max) > BestSq) continue;
+
+			if (Node.Count == 0)
+			{
+				// Nearer child last so it is popped first (tightens BestSq sooner).
+				const FNode& L = Nodes[Node.First];
+				const FNode& R = Nodes[Node.First + 1];
+				const bool bLeftFirst = BoxDistSq(P, L.Min, L.Max) <= BoxDistSq(P, R.Min, R.Max);
+				Stack.Add(bLeftFirst ? Node.First + 1 : Node.First);
+				Stack.Add(bLeftFirst ? Node.First : Node.First + 1);
+				continue;
+			}
+
+			for (int32 i = Node.First; i < Node.First + Node.Count; ++i)
+			{
+				float T = 0.f;
+				const float DistSq = ClosestPointSegment(P, Segments[i].A, Segments[i].B, T);
+				if (DistSq <= BestSq)
+				{
+					BestSq = DistSq;
+					BestIdx = i;
+					BestT = T;
+				}
+			}
+		}
+
+		if (BestIdx == INDEX_NONE) return false;
+
+		const FWireSegment& Seg = Segments[BestIdx];
+		OutHit.Wire = Seg.Wire;
+		OutHit.Segment = BestIdx;
+		OutHit.Distance = FMath::Sqrt(BestSq);
+		OutHit.DistanceAlongWire = Seg.DistanceAlongWire + BestT * FVector3f::Dist(Seg.A, Seg.B);
+		OutHit.Location = FVector(FMath::Lerp(Seg.A, Seg.B, BestT)) + Origin;
+		return true;
+	}
+
+	int32 FSegmentBVH::FindInRadius(const FVector& Point, float Radius, TArray<FSegmentHit>& OutHits) const
+	{
+		if (Nodes.Num() == 0 || Radius < 0.f) return 0;
+
+		const FVector3f P = FVector3f(Point - Origin);
+		const float RadiusSq = Radius * Radius;
+		const int32 FirstOut = OutHits.Num();
+
+		TArray<int32, TInlineAllocator<64>> Stack;
+		Stack.Add(0);
+
+		while (Stack.Num() > 0)
+		{
+			const FNode& Node = Nodes[Stack.Pop()];
+			if (BoxDistSq(P, Node.Min, Node.Max) > RadiusSq) continue;
+
+			if (Node.Count == 0)
+			{
+				Stack.Add(Node.First);
+				Stack.Add(Node.First + 1);
+				continue;
+			}
+
+			for (int32 i = Node.First; i < Node.First + Node.Count; ++i)
+			{
+				const FWireSegment& Seg = Segments[i];
+				float T = 0.f;
+				const float DistSq = ClosestPointSegment(P, Seg.A, Seg.B, T);
+				if (DistSq > RadiusSq) continue;
+
+				// Keep the closest segment per wire (few wires per query, linear scan is fine).
+				FSegmentHit* Existing = nullptr;
+				for (int32 h = FirstOut; h < OutHits.Num(); ++h)
+				{
+					if (OutHits[h].Wire == Seg.Wire)
+					{
+						Existing = &OutHits[h];
+						break;
+					}
+				}
+
+				const float Dist = FMath::Sqrt(DistSq);
+				if (Existing && Existing->Distance <= Dist) continue;
+
+				FSegmentHit& Hit = Existing ? *Existing : OutHits.AddDefaulted_GetRef();
+				Hit.Wire = Seg.Wire;
+				Hit.Segment = i;
+				Hit.Distance = Dist;
+				Hit.DistanceAlongWire = Seg.DistanceAlongWire + T * FVector3f::Dist(Seg.A, Seg.B);
+				Hit.Location = FVector(FMath::Lerp(Seg.A, Seg.B, T)) + Origin;
+			}
+		}
+
+		return OutHits.Num() - FirstOut;
+	}
+
+	// ============================
+	// Auto wiring
+	// ============================
+
+	void AutoWire(TArrayView<const FVector> Points, TArrayView<const uint32> Groups, const FAutoWireParams& Params, TArray<FAutoWireLink>& OutLinks)
+	{
+		OutLinks.Reset();
+		const int32 Num = Points.Num();
+		if (Num < 2 || Params.MaxSpanCm <= 0.f) return;
+
+		const bool bGroups = Groups.Num() == Num;
+		const bool bTree = Params.Policy == EAutoWirePolicy::MinimumSpanningTree;
+		const int32 K = FMath::Clamp(bTree ? FMath::Max(Params.K, Params.TreeCandidates) : Params.K, 1, 32);
+		const double MaxSq = FMath::Square((double)Params.MaxSpanCm);
+
+		// Spatial hash on XY with cell = max span: all candidates of a point are in the 3x3 cells around it.
+		const double InvCell = 1.0 / (double)Params.MaxSpanCm;
+		TArray<FIntPoint> Cells;
+		Cells.SetNumUninitialized(Num);
+		TArray<int32> Order;
+		Order.SetNumUninitialized(Num);
+		for (int32 i = 0; i < Num; ++i)
+		{
+			Cells[i] = FIntPoint(FMath::FloorToInt32(Points[i].X * InvCell), FMath::FloorToInt32(Points[i].Y * InvCell));
+			Order[i] = i;
+		}
+
+		Algo::Sort(Order, [&Cells](int32 L, int32 R) {
+			return Cells[L].X != Cells[R].X ? Cells[L].X < Cells[R].X : Cells[L].Y < Cells[R].Y;
+			});
+
+		TMap<FIntPoint, FIntPoint> CellRanges; // Cell -> (first, count) in Order
+		for (int32 i = 0; i < Num; ++i)
+		{
+			FIntPoint& Range = CellRanges.FindOrAdd(Cells[Order[i]], FIntPoint(i, 0));
+			++Range.Y;
+		}
+
+		// K nearest per point, written to a fixed slot range (no locks).
+		TArray<FAutoWireLink> Candidates;
+		Candidates.SetNum(Num * K);
+
+		ParallelFor(Num, [&](int32 i)
+		{
+			const FVector& P = Points[i];
+			TArray<TPair<double, int32>, TInlineAllocator<32>> Best; // Sorted by distance
+
+			for (int32 DY = -1; DY <= 1; ++DY)
+			{
+				for (int32 DX = -1; DX <= 1; ++DX)
+				{
+					const FIntPoint* Range = CellRanges.Find(Cells[i] + FIntPoint(DX, DY));
+					if (!Range) continue;
+
+					for (int32 o = Range->X; o < Range->X + Range->Y; ++o)
+					{
+						const int32 j = Order[o];
+						if (j == i || (bGroups && Groups[j] != Groups[i])) continue;
+
+						const double DistSq = FVector::DistSquared(P, Points[j]);
+						if (DistSq > MaxSq || (Best.Num() == K && DistSq >= Best.Last().Key)) continue;
+
+						int32 At = Best.Num();
+						while (At > 0 && Best[At - 1].Key > DistSq)
+						{
+							--At;
+						}
+						Best.Insert(TPair<double, int32>(DistSq, j), At);
+						if (Best.Num() > K)
+						{
+							Best.Pop();
+						}
+					}
+				}
+			}
+
+			for (int32 n = 0; n < Best.Num(); ++n)
+			{
+				FAutoWireLink& Link = Candidates[i * K + n];
+				Link.A = FMath::Min(i, Best[n].Value);
+				Link.B = FMath::Max(i, Best[n].Value);
+				Link.Length = (float)FMath::Sqrt(Best[n].Key);
+			}
+		});
+
+		// Drop empty slots and links found from both ends.
+		Candidates.RemoveAllSwap([](const FAutoWireLink& L) { return L.A == INDEX_NONE; });
+		Algo::Sort(Candidates, [](const FAutoWireLink& L, const FAutoWireLink& R) {
+			if (L.Length != R.Length) return L.Length < R.Length;
+			return L.A != R.A ? L.A < R.A : L.B < R.B;
+			});
+
+		int32 Kept = 0;
+		for (int32 i = 0; i < Candidates.Num(); ++i)
+		{
+			const FAutoWireLink& L = Candidates[i];
+			if (Kept > 0 && Candidates[Kept - 1].A == L.A && Candidates[Kept - 1].B == L.B) continue;
+			Candidates[Kept++] = L;
+		}
+		Candidates.SetNum(Kept);
+
+		if (!bTree)
+		{
+			OutLinks = MoveTemp(Candidates);
+			return;
+		}
+
+		// Kruskal (candidates are already sorted by length).
+		TArray<int32> Parent;
+		Parent.SetNumUninitialized(Num);
+		for (int32 i = 0; i < Num; ++i)
+		{
+			Parent[i] = i;
+		}
+		auto Find = [&Parent](int32 V) {
+			while (Parent[V] != V)
+			{
+				Parent[V] = Parent[Parent[V]];
+				V = Parent[V];
+			}
+			return V;
+			};
+
+		for (const FAutoWireLink& L : Candidates)
+		{
+			const int32 RA = Find(L.A);
+			const int32 RB = Find(L.B);
+			if (RA == RB) continue;
+
+			Parent[RA] = RB;
+			OutLinks.Add(L);
+			if (OutLinks.Num() == Num - 1) break;
+		}
+	}
+
+	// ============================
+	// Connectivity graph
+	// ============================
+
+	// Vertices the search around a cut visits before falling back to the tour scan.
+	static constexpr int32 LocalSearchVertices = 64;
+
+	int32 FConnectivityGraph::AddVertex()
+	{
+		int32 V;
+		if (FreeVertices.Num() > 0)
+		{
+			V = FreeVertices.Pop();
+		}
+		else
+		{
+			V = VertexNode.AddUninitialized();
+			NonTreeCount.AddUninitialized();
+			Source.AddUninitialized();
+			Visit.AddUninitialized();
+			Adjacency.AddDefaulted();
+		}
+
+		NonTreeCount[V] = 0;
+		Source[V] = 0;
+		Visit[V] = 0;
+		Adjacency[V].Reset();
+		VertexNode[V] = AllocateNode(V);
+		++NumAlive;
+		++NumTrees;
+		return V;
+	}
+
+	void FConnectivityGraph::RemoveVertex(int32 V)
+	{
+		if (!IsValidVertex(V)) return;
+
+		while (Adjacency[V].Num() > 0)
+		{
+			RemoveEdge(Adjacency[V].Last());
+		}
+
+		// Isolated now: its tour is its own node.
+		FreeNode(VertexNode[V]);
+		VertexNode[V] = INDEX_NONE;
+		FreeVertices.Add(V);
+		--NumAlive;
+		--NumTrees;
+	}
+
+	int32 FConnectivityGraph::AddEdge(int32 A, int32 B)
+	{
+		if (!IsValidVertex(A) || !IsValidVertex(B)) return INDEX_NONE;
+
+		const int32 E = FreeEdges.Num() > 0 ? FreeEdges.Pop() : Edges.AddDefaulted();
+		Edges[E] = FEdge();
+		Edges[E].A = A;
+		Edges[E].B = B;
+		Adjacency[A].Add(E);
+		if (B == A) return E;
+		Adjacency[B].Add(E);
+
+		// Two trees: their tours are spliced together, O(log n). Inside one tree: a spare path for later cuts.
+		if (AreConnected(A, B))
+		{
+			SetNonTree(E, true);
+		}
+		else
+		{
+			Link(E);
+			--NumTrees;
+		}
+		return E;
+	}
+
+	void FConnectivityGraph::RemoveEdge(int32 E)
+	{
+		if (!IsValidEdge(E)) return;
+
+		const FEdge Edge = Edges[E];
+		Adjacency[Edge.A].RemoveSingleSwap(E);
+		if (Edge.B == Edge.A)
+		{
+			Edges[E] = FEdge();
+			FreeEdges.Add(E);
+			return;
+		}
+		Adjacency[Edge.B].RemoveSingleSwap(E);
+
+		if (Edge.Arcs[0] == INDEX_NONE)
+		{
+			SetNonTree(E, false);
+			Edges[E] = FEdge();
+			FreeEdges.Add(E);
+			return;
+		}
+
+		int32 RootA, RootB;
+		Cut(E, RootA, RootB);
+		Edges[E] = FEdge();
+		FreeEdges.Add(E);
+
+		// Only the smaller piece is searched, and only through its non-tree edge ends.
+		const int32 Small = Nodes[RootA].Vertices <= Nodes[RootB].Vertices ? RootA : RootB;
+		const int32 Start = FindRoot(VertexNode[Edge.A]) == Small ? Edge.A : Edge.B;
+		const int32 Replacement = FindReplacement(Small, Start);
+		if (Replacement == INDEX_NONE)
+		{
+			++NumTrees;
+			return;
+		}
+
+		SetNonTree(Replacement, false);
+		Link(Replacement);
+	}
+
+	void FConnectivityGraph::SetSource(int32 V, bool bSource)
+	{
+		if (!IsValidVertex(V) || (Source[V] != 0) == bSource) return;
+
+		Source[V] = bSource ? 1 : 0;
+		UpdateToRoot(VertexNode[V]);
+	}
+
+	void FConnectivityGraph::GetComponent(int32 V, TArray<int32>& OutVertices) const
+	{
+		if (!IsValidVertex(V)) return;
+
+		const int32 Root = FindRoot(VertexNode[V]);
+		OutVertices.Reserve(OutVertices.Num() + Nodes[Root].Vertices);
+
+		TArray<int32, TInlineAllocator<64>> Stack;
+		Stack.Add(Root);
+		while (Stack.Num() > 0)
+		{
+			const FTourNode& N = Nodes[Stack.Pop()];
+			if (N.Vertex != INDEX_NONE)
+			{
+				OutVertices.Add(N.Vertex);
+			}
+			if (N.Left != INDEX_NONE) Stack.Add(N.Left);
+			if (N.Right != INDEX_NONE) Stack.Add(N.Right);
+		}
+	}
+
+	SIZE_T FConnectivityGraph::GetAllocatedSize() const
+	{
+		SIZE_T Bytes = VertexNode.GetAllocatedSize() + NonTreeCount.GetAllocatedSize() + Source.GetAllocatedSize()
+			+ Visit.GetAllocatedSize() + Adjacency.GetAllocatedSize() + FreeVertices.GetAllocatedSize()
+			+ Edges.GetAllocatedSize() + FreeEdges.GetAllocatedSize()
+			+ Nodes.GetAllocatedSize() + FreeNodes.GetAllocatedSize();
+
+		// Heap part only (inline storage is counted in Adjacency).
+		for (const TArray<int32, TInlineAllocator<4>>& Adj : Adjacency)
+		{
+			Bytes += Adj.GetAllocatedSize();
+		}
+		return Bytes;
+	}
+
+	// Spanning forest: tree edges are arcs in the Euler tours
+
+	void FConnectivityGraph::Link(int32 E)
+	{
+		FEdge& Edge = Edges[E];
+		Edge.Arcs[0] = AllocateNode(INDEX_NONE);
+		Edge.Arcs[1] = AllocateNode(INDEX_NONE);
+
+		// A's tour (from A), arc A->B, B's tour (from B), arc B->A.
+		const int32 TourA = Reroot(Edge.A);
+		const int32 TourB = Reroot(Edge.B);
+		Join(Join(Join(TourA, Edge.Arcs[0]), TourB), Edge.Arcs[1]);
+	}
+
+	void FConnectivityGraph::Cut(int32 E, int32& OutA, int32& OutB)
+	{
+		FEdge& Edge = Edges[E];
+		int32 First = Edge.Arcs[0];
+		int32 Second = Edge.Arcs[1];
+		int32 PosFirst = GetPosition(First);
+		int32 PosSecond = GetPosition(Second);
+		if (PosFirst > PosSecond)
+		{
+			Swap(First, Second);
+			Swap(PosFirst, PosSecond);
+		}
+
+		// Tour = L, First, M, Second, R: M is one tree, R + L the other.
+		int32 L, Rest, Arc, M, R;
+		SplitRoot(FindRoot(First), PosFirst, L, Rest);
+		SplitRoot(Rest, 1, Arc, Rest);
+		SplitRoot(Rest, PosSecond - PosFirst - 1, M, Rest);
+		SplitRoot(Rest, 1, Arc, R);
+
+		FreeNode(Edge.Arcs[0]);
+		FreeNode(Edge.Arcs[1]);
+		Edge.Arcs[0] = INDEX_NONE;
+		Edge.Arcs[1] = INDEX_NONE;
+
+		OutA = M;
+		OutB = Join(R, L);
+	}
+
+	int32 FConnectivityGraph::FindReplacement(int32 SmallRoot, int32 Start)
+	{
+		// Nothing can lead out: trees and radial feeders split here, whatever the piece size.
+		if (Nodes[SmallRoot].NonTree == 0) return INDEX_NONE;
+
+		// Meshed grids: the edge closing a short cycle is usually a few hops from the cut, so look around it first.
+		// Everything queued is on the small side (a non-tree edge leading out ends the search).
+		if (++VisitStamp == 0)
+		{
+			FMemory::Memzero(Visit.GetData(), Visit.Num() * sizeof(uint32));
+			VisitStamp = 1;
+		}
+		TArray<int32, TInlineAllocator<64>> Queue;
+		Queue.Add(Start);
+		Visit[Start] = VisitStamp;
+		int32 Head = 0;
+		for (; Head < Queue.Num() && Head < LocalSearchVertices; ++Head)
+		{
+			const int32 V = Queue[Head];
+			for (int32 E : Adjacency[V])
+			{
+				const FEdge& Edge = Edges[E];
+				const int32 U = Edge.A == V ? Edge.B : Edge.A;
+				if (Visit[U] == VisitStamp) continue;
+				if (Edge.Arcs[0] == INDEX_NONE && FindRoot(VertexNode[U]) != SmallRoot) return E;
+
+				Visit[U] = VisitStamp;
+				Queue.Add(U);
+			}
+		}
+		if (Head == Queue.Num()) return INDEX_NONE; // Whole small side seen
+
+		// Tour order, skipping subtrees without non-tree ends: cost follows the non-tree edges, not the vertices.
+		TArray<int32, TInlineAllocator<64>> Stack;
+		int32 Node = SmallRoot;
+		for (;;)
+		{
+			while (Node != INDEX_NONE && Nodes[Node].NonTree > 0)
+			{
+				Stack.Add(Node);
+				Node = Nodes[Node].Left;
+			}
+			if (Stack.Num() == 0) return INDEX_NONE;
+
+			Node = Stack.Pop();
+			const int32 V = Nodes[Node].Vertex;
+			if (V != INDEX_NONE && NonTreeCount[V] > 0)
+			{
+				for (int32 E : Adjacency[V])
+				{
+					const FEdge& Edge = Edges[E];
+					if (Edge.Arcs[0] != INDEX_NONE || Edge.A == Edge.B) continue;
+
+					const int32 Other = Edge.A == V ? Edge.B : Edge.A;
+					if (FindRoot(VertexNode[Other]) != SmallRoot) return E;
+				}
+			}
+			Node = Nodes[Node].Right;
+		}
+	}
+
+	void FConnectivityGraph::SetNonTree(int32 E, bool bNonTree)
+	{
+		const FEdge& Edge = Edges[E];
+		const int32 Delta = bNonTree ? 1 : -1;
+		NonTreeCount[Edge.A] += Delta;
+		NonTreeCount[Edge.B] += Delta;
+		UpdateToRoot(VertexNode[Edge.A]);
+		UpdateToRoot(VertexNode[Edge.B]);
+	}
+
+	int32 FConnectivityGraph::Reroot(int32 V)
+	{
+		const int32 Node = VertexNode[V];
+		int32 L, R;
+		SplitRoot(FindRoot(Node), GetPosition(Node), L, R);
+		return Join(R, L);
+	}
+
+	// Treap primitives
+
+	int32 FConnectivityGraph::AllocateNode(int32 Vertex)
+	{
+		const int32 Node = FreeNodes.Num() > 0 ? FreeNodes.Pop() : Nodes.AddDefaulted();
+
+		// xorshift32: random priorities keep the treaps O(log n) deep whatever the edit order.
+		PrioritySeed ^= PrioritySeed << 13;
+		PrioritySeed ^= PrioritySeed >> 17;
+		PrioritySeed ^= PrioritySeed << 5;
+
+		Nodes[Node] = FTourNode();
+		Nodes[Node].Priority = PrioritySeed;
+		Nodes[Node].Vertex = Vertex;
+		UpdateNode(Node);
+		return Node;
+	}
+
+	void FConnectivityGraph::FreeNode(int32 Node)
+	{
+		Nodes[Node] = FTourNode();
+		FreeNodes.Add(Node);
+	}
+
+	void FConnectivityGraph::UpdateNode(int32 Node)
+	{
+		FTourNode& N = Nodes[Node];
+		const bool bVertex = N.Vertex != INDEX_NONE;
+		N.Size = 1;
+		N.Vertices = bVertex ? 1 : 0;
+		N.NonTree = bVertex ? NonTreeCount[N.Vertex] : 0;
+		N.Sources = bVertex ? Source[N.Vertex] : 0;
+
+		for (const int32 Child : { N.Left, N.Right })
+		{
+			if (Child == INDEX_NONE) continue;
+			const FTourNode& C = Nodes[Child];
+			N.Size += C.Size;
+			N.Vertices += C.Vertices;
+			N.NonTree += C.NonTree;
+			N.Sources += C.Sources;
+		}
+	}
+
+	void FConnectivityGraph::UpdateToRoot(int32 Node)
+	{
+		for (; Node != INDEX_NONE; Node = Nodes[Node].Parent)
+		{
+			UpdateNode(Node);
+		}
+	}
+
+	int32 FConnectivityGraph::FindRoot(int32 Node) const
+	{
+		while (Nodes[Node].Parent != INDEX_NONE)
+		{
+			Node = Nodes[Node].Parent;
+		}
+		return Node;
+	}
+
+	int32 FConnectivityGraph::GetPosition(int32 Node) const
+	{
+		const int32 Left = Nodes[Node].Left;
+		int32 Pos = Left != INDEX_NONE ? Nodes[Left].Size : 0;
+		for (int32 Parent = Nodes[Node].Parent; Parent != INDEX_NONE; Node = Parent, Parent = Nodes[Node].Parent)
+		{
+			if (Nodes[Parent].Right == Node)
+			{
+				const int32 Sibling = Nodes[Parent].Left;
+				Pos += (Sibling != INDEX_NONE ? Nodes[Sibling].Size : 0) + 1;
+			}
+		}
+		return Pos;
+	}
+
+	int32 FConnectivityGraph::Merge(int32 L, int32 R)
+	{
+		if (L == INDEX_NONE) return R;
+		if (R == INDEX_NONE) return L;
+
+		if (Nodes[L].Priority > Nodes[R].Priority)
+		{
+			const int32 Child = Merge(Nodes[L].Right, R);
+			Nodes[L].Right = Child;
+			Nodes[Child].Parent = L;
+			UpdateNode(L);
+			return L;
+		}
+
+		const int32 Child = Merge(L, Nodes[R].Left);
+		Nodes[R].Left = Child;
+		Nodes[Child].Parent = R;
+		UpdateNode(R);
+		return R;
+	}
+
+	void FConnectivityGraph::Split(int32 Root, int32 Count, int32& OutL, int32& OutR)
+	{
+		if (Root == INDEX_NONE)
+		{
+			OutL = INDEX_NONE;
+			OutR = INDEX_NONE;
+			return;
+		}
+
+		const int32 Left = Nodes[Root].Left;
+		const int32 LeftSize = Left != INDEX_NONE ? Nodes[Left].Size : 0;
+		if (Count <= LeftSize)
+		{
+			int32 A, B;
+			Split(Left, Count, A, B);
+			Nodes[Root].Left = B;
+			if (B != INDEX_NONE) Nodes[B].Parent = Root;
+			UpdateNode(Root);
+			OutL = A;
+			OutR = Root;
+		}
+		else
+		{
+			int32 A, B;
+			Split(Nodes[Root].Right, Count - LeftSize - 1, A, B);
+			Nodes[Root].Right = A;
+			if (A != INDEX_NONE) Nodes[A].Parent = Root;
+			UpdateNode(Root);
+			OutL = Root;
+			OutR = B;
+		}
+	}
+
+	int32 FConnectivityGraph::Join(int32 L, int32 R)
+	{
+		const int32 Root = Merge(L, R);
+		if (Root != INDEX_NONE) Nodes[Root].Parent = INDEX_NONE;
+		return Root;
+	}
+
+	void FConnectivityGraph::SplitRoot(int32 Root, int32 Count, int32& OutL, int32& OutR)
+	{
+		Split(Root, Count, OutL, OutR);
+		if (OutL != INDEX_NONE) Nodes[OutL].Parent = INDEX_NONE;
+		if (OutR != INDEX_NONE) Nodes[OutR].Parent = INDEX_NONE;
+	}
+}
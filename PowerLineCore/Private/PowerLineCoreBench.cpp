@@ -0,0 +1,298 @@
+#include "PowerLineCoreBench.h"
+
+#include "PowerLineCore.h"
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogPowerLineCoreBench, Log, All);
+
+namespace PowerLineCore
+{
+	double GetDefaultMax(const TCHAR* Metric)
+	{
+		// Regression gates that hold on any dev machine (measured ~2-3 us per mid-chain cut at 200k spans).
+		static const TPair<const TCHAR*, double> Gates[] = {
+			{ TEXT("CoreGraphChainMidCutUs"), 50.0 },
+			{ TEXT("CoreGraphFeederCutUs"), 50.0 },
+		};
+		for (const TPair<const TCHAR*, double>& Gate : Gates)
+		{
+			if (FCString::Strcmp(Gate.Key, Metric) == 0) return Gate.Value;
+		}
+		return -1.0;
+	}
+
+	double BestOfMs(int32 Runs, TFunctionRef<void()> Fn)
+	{
+		double Best = TNumericLimits<double>::Max();
+		for (int32 r = 0; r < Runs; ++r)
+		{
+			const double T0 = FPlatformTime::Seconds();
+			Fn();
+			Best = FMath::Min(Best, (FPlatformTime::Seconds() - T0) * 1000.0);
+		}
+		return Best;
+	}
+
+	void RunBench(const FBenchParams& S, TFunctionRef<void(const TCHAR* Name, double Value)> AddMetric)
+	{
+		FRandomStream Rand(S.Seed);
+		const int32 NumSpans = FMath::Max(1, S.Poles * S.WiresPerPole);
+
+		TArray<FSpanInput> Spans;
+		Spans.SetNum(NumSpans);
+		for (int32 i = 0; i < NumSpans; ++i)
+		{
+			FSpanInput& Span = Spans[i];
+			Span.Start = FVector(Rand.FRandRange(0.f, 100000.f), Rand.FRandRange(0.f, 100000.f), Rand.FRandRange(500.f, 1500.f));
+			Span.End = Span.Start + Rand.GetUnitVector() * FVector(1.f, 1.f, 0.05f) * Rand.FRandRange(0.5f, 1.5f) * S.PoleSpacingCm;
+			Span.LineId = i % S.WiresPerPole;
+			Span.WireSag = 80.f;
+			Span.WireSegments = 8;
+		}
+
+		FDistrictParams District;
+		FHangingParams Hanging;
+		Hanging.PoolSize = 4;
+		Hanging.Chance = S.HangingRatio;
+
+		int64 Sink = 0;
+
+		const double ResolveMs = BestOfMs(3, [&]() {
+			for (const FSpanInput& Span : Spans)
+			{
+				float Sag = 0.f;
+				int32 Segments = 0;
+				ResolveSpan(Span, &District, Sag, Segments);
+				Sink += Segments;
+			}
+			});
+		AddMetric(TEXT("CoreResolveNsPerWire"), ResolveMs * 1e6 / (double)NumSpans);
+
+		const double HangingMs = BestOfMs(3, [&]() {
+			FHangingResult Result;
+			for (const FSpanInput& Span : Spans)
+			{
+				Sink += ComputeHanging(Hanging, Span.Start, Span.End, Span.LineId, Result) ? 1 : 0;
+			}
+			});
+		AddMetric(TEXT("CoreHangingNsPerWire"), HangingMs * 1e6 / (double)NumSpans);
+
+		int64 TotalSegments = 0;
+		const double CurveMs = BestOfMs(3, [&]() {
+			TotalSegments = 0;
+			TArray<FVector> Points;
+			for (const FSpanInput& Span : Spans)
+			{
+				if (BuildSpan(Span, &District, Points))
+				{
+					TotalSegments += Points.Num() - 1;
+				}
+			}
+			});
+		AddMetric(TEXT("CoreBuildNsPerWire"), CurveMs * 1e6 / (double)NumSpans);
+		AddMetric(TEXT("CoreBuildNsPerSegment"), TotalSegments > 0 ? CurveMs * 1e6 / (double)TotalSegments : 0.0);
+
+		// Thread scaling: same work split into N contiguous batches.
+		const int32 MaxThreads = FMath::Max(1, FTaskGraphInterface::IsRunning() ? FTaskGraphInterface::Get().GetNumWorkerThreads() + 1 : 1);
+		double SingleMs = 0.0;
+		for (int32 Threads = 1; Threads <= MaxThreads; Threads *= 2)
+		{
+			const double Ms = BestOfMs(3, [&]() {
+				ParallelFor(Threads, [&](int32 Batch) {
+					TArray<FVector> Points;
+					const int32 Begin = (int32)((int64)NumSpans * Batch / Threads);
+					const int32 End = (int32)((int64)NumSpans * (Batch + 1) / Threads);
+					for (int32 i = Begin; i < End; ++i)
+					{
+						BuildSpan(Spans[i], &District, Points);
+					}
+					});
+				});
+
+			if (Threads == 1)
+			{
+				SingleMs = Ms;
+			}
+
+			AddMetric(*FString::Printf(TEXT("CoreBuild%dThreadsMs"), Threads), Ms);
+			AddMetric(*FString::Printf(TEXT("CoreSpeedup%dThreads"), Threads), Ms > 0.0 ? SingleMs / Ms : 0.0);
+		}
+
+		// Conductor bundle: three phases + neutral per span, as four curves vs one bundle pass.
+		{
+			const FVector Offsets[] = { FVector(0, -150, 0), FVector(0, -50, 0), FVector(0, 50, 0), FVector(0, 150, -80) };
+			int64 BundleSegments = 0;
+
+			const double SeparateMs = BestOfMs(3, [&]() {
+				TArray<FVector> Points;
+				for (const FSpanInput& Span : Spans)
+				{
+					for (const FVector& Offset : Offsets)
+					{
+						Sink += BuildSaggedCurve(Span.Start + Offset, Span.End + Offset, Span.WireSag, Span.WireSegments, Points) ? 1 : 0;
+					}
+				}
+				});
+
+			const double BundleMs = BestOfMs(3, [&]() {
+				BundleSegments = 0;
+				TArray<FVector> Points;
+				for (const FSpanInput& Span : Spans)
+				{
+					if (BuildSaggedBundle(Span.Start, Span.End, Span.WireSag, Span.WireSegments, Offsets, Offsets, Points))
+					{
+						BundleSegments += Points.Num() - UE_ARRAY_COUNT(Offsets);
+					}
+				}
+				});
+
+			AddMetric(TEXT("CoreBundle4NsPerSpan"), BundleMs * 1e6 / (double)NumSpans);
+			AddMetric(TEXT("CoreBundle4NsPerSegment"), BundleSegments > 0 ? BundleMs * 1e6 / (double)BundleSegments : 0.0);
+			AddMetric(TEXT("CoreBundle4Speedup"), BundleMs > 0.0 ? SeparateMs / BundleMs : 0.0);
+		}
+
+		// Auto wiring: spanning tree and nearest-3 over the poles (poles spread like the generated scene).
+		{
+			const int32 NumPoles = FMath::Max(2, S.Poles);
+			const float Side = FMath::Sqrt((float)NumPoles) * S.PoleSpacingCm;
+			TArray<FVector> Poles;
+			Poles.SetNumUninitialized(NumPoles);
+			for (FVector& P : Poles)
+			{
+				P = FVector(Rand.FRandRange(0.f, Side), Rand.FRandRange(0.f, Side), 0.f);
+			}
+
+			FAutoWireParams Params;
+			Params.MaxSpanCm = S.PoleSpacingCm * 2.f;
+			TArray<FAutoWireLink> Links;
+
+			const double TreeMs = BestOfMs(3, [&]() { AutoWire(Poles, TArrayView<const uint32>(), Params, Links); });
+			AddMetric(TEXT("CoreAutoWireTreeMs"), TreeMs);
+			AddMetric(TEXT("CoreAutoWireTreeLinks"), Links.Num());
+
+			Params.Policy = EAutoWirePolicy::NearestK;
+			Params.K = 3;
+			const double NearestMs = BestOfMs(3, [&]() { AutoWire(Poles, TArrayView<const uint32>(), Params, Links); });
+			AddMetric(TEXT("CoreAutoWireNearest3Ms"), NearestMs);
+		}
+
+		// Connectivity: one vertex per pole, a chain through all poles plus random cross links (one edge per wire).
+		{
+			const int32 NumVertices = FMath::Max(2, S.Poles);
+			FConnectivityGraph Graph;
+			TArray<int32> EdgeIds;
+			EdgeIds.Reserve(NumSpans);
+
+			const double T0 = FPlatformTime::Seconds();
+			for (int32 v = 0; v < NumVertices; ++v)
+			{
+				Graph.AddVertex();
+			}
+			for (int32 i = 0; i < NumSpans; ++i)
+			{
+				const int32 A = i % NumVertices;
+				const int32 B = (i + 1 < NumVertices) ? A + 1 : Rand.RandRange(0, NumVertices - 1);
+				EdgeIds.Add(Graph.AddEdge(A, B));
+			}
+			Graph.SetSource(0, true);
+			AddMetric(TEXT("CoreGraphBuildNsPerEdge"), (FPlatformTime::Seconds() - T0) * 1e9 / (double)NumSpans);
+
+			// Break a wire, ask whether its far end is still powered, reconnect it.
+			const int32 Changes = FMath::Min(NumSpans, 10000);
+			const double T1 = FPlatformTime::Seconds();
+			for (int32 c = 0; c < Changes; ++c)
+			{
+				const int32 i = Rand.RandRange(0, NumSpans - 1);
+				int32 A, B;
+				Graph.GetEdgeVertices(EdgeIds[i], A, B);
+				Graph.RemoveEdge(EdgeIds[i]);
+				Sink += Graph.IsPowered(B) ? 1 : 0;
+				EdgeIds[i] = Graph.AddEdge(A, B);
+			}
+			AddMetric(TEXT("CoreGraphEdgeChangeUs"), (FPlatformTime::Seconds() - T1) * 1e6 / (double)Changes);
+			AddMetric(TEXT("CoreGraphMemoryKB"), (double)Graph.GetAllocatedSize() / 1024.0);
+		}
+
+		// Connectivity worst cases for a search-based split: no cross links, so every removal splits (remove + re-add).
+		// Fixed at 200k spans whatever the scene size: a cut costing O(smaller side) shows up as ~100k steps mid-chain.
+		{
+			const int32 NumVertices = 200001;
+			const int32 Changes = 1000;
+
+			// Long chain (one line through every pole): random cuts, then always the middle span.
+			FConnectivityGraph Chain;
+			TArray<int32> ChainEdges;
+			for (int32 v = 0; v < NumVertices; ++v)
+			{
+				Chain.AddVertex();
+			}
+			for (int32 v = 0; v + 1 < NumVertices; ++v)
+			{
+				ChainEdges.Add(Chain.AddEdge(v, v + 1));
+			}
+			Chain.SetSource(0, true);
+
+			auto CutAndRejoin = [&Sink](FConnectivityGraph& Graph, int32& Edge) {
+				int32 A, B;
+				Graph.GetEdgeVertices(Edge, A, B);
+				Graph.RemoveEdge(Edge);
+				Sink += Graph.IsPowered(B) ? 1 : 0;
+				Edge = Graph.AddEdge(A, B);
+				};
+
+			int64 SideSum = 0;
+			double T0 = FPlatformTime::Seconds();
+			for (int32 c = 0; c < Changes; ++c)
+			{
+				const int32 i = Rand.RandRange(0, ChainEdges.Num() - 1);
+				SideSum += FMath::Min(i + 1, NumVertices - 1 - i);
+				CutAndRejoin(Chain, ChainEdges[i]);
+			}
+			AddMetric(TEXT("CoreGraphChainCutUs"), (FPlatformTime::Seconds() - T0) * 1e6 / (double)Changes);
+			AddMetric(TEXT("CoreGraphChainAvgSmallerSide"), (double)SideSum / (double)Changes);
+
+			const int32 Mid = ChainEdges.Num() / 2;
+			T0 = FPlatformTime::Seconds();
+			for (int32 c = 0; c < Changes; ++c)
+			{
+				CutAndRejoin(Chain, ChainEdges[Mid]);
+			}
+			AddMetric(TEXT("CoreGraphChainMidCutUs"), (FPlatformTime::Seconds() - T0) * 1e6 / (double)Changes);
+
+			// Radial feeders: 8 chains out of one source, each cut at its first span (the whole feeder splits off).
+			const int32 NumFeeders = 8;
+			const int32 FeederLength = FMath::Max(1, (NumVertices - 1) / NumFeeders);
+			FConnectivityGraph Radial;
+			TArray<int32> RootSpans;
+			const int32 Root = Radial.AddVertex();
+			Radial.SetSource(Root, true);
+			for (int32 f = 0; f < NumFeeders; ++f)
+			{
+				int32 Prev = Root;
+				for (int32 v = 0; v < FeederLength; ++v)
+				{
+					const int32 Cur = Radial.AddVertex();
+					const int32 Edge = Radial.AddEdge(Prev, Cur);
+					if (v == 0)
+					{
+						RootSpans.Add(Edge);
+					}
+					Prev = Cur;
+				}
+			}
+
+			T0 = FPlatformTime::Seconds();
+			for (int32 c = 0; c < Changes; ++c)
+			{
+				CutAndRejoin(Radial, RootSpans[c % NumFeeders]);
+			}
+			AddMetric(TEXT("CoreGraphFeederCutUs"), (FPlatformTime::Seconds() - T0) * 1e6 / (double)Changes);
+			AddMetric(TEXT("CoreGraphFeederLength"), FeederLength);
+		}
+
+		UE_LOG(LogPowerLineCoreBench, Verbose, TEXT("Core bench sink: %lld"), Sink);
+	}
+}
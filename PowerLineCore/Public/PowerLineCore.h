@@ -0,0 +1,451 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// ============================
+// PowerLine core
+// Pure wire math on plain data (own module, depends on Core only: no UObjects, no world, no rendering).
+// The UObject layer converts its settings to these structs and calls in. The PowerLineCoreTests low-level test
+// target unit-tests and benchmarks it as a plain program; the stress commandlet runs the same benchmarks in the
+// editor (-run=PowerLineStress -CoreBench, see PowerLineCoreBench.h).
+// ============================
+
+namespace PowerLineCore
+{
+	struct FSagParams
+	{
+		float MinCm = 40.f;
+		float MaxCm = 120.f;
+		float Scale = 1.f;
+		bool bDeterministic = true;
+		int32 Seed = 1337;
+	};
+
+	struct FSegmentParams
+	{
+		bool bAuto = true;
+		float TargetLengthCm = 150.f;
+		int32 Min = 4;
+		int32 Max = 64;
+		int32 Fixed = 12;
+	};
+
+	struct FHangingParams
+	{
+		int32 PoolSize = 0;
+		float Chance = 0.03f;
+		FVector2f DistanceRange = FVector2f(0.2f, 0.8f);
+		float RandomYawDeg = 15.f;
+		bool bDeterministic = true;
+		int32 Seed = 24601;
+	};
+
+	struct FHangingResult
+	{
+		int32 MeshIndex = INDEX_NONE;
+		float NormalizedDistance = 0.5f;
+		float YawDeg = 0.f;
+	};
+
+	// District policy for one wire (null district = per-wire values only).
+	struct FDistrictParams
+	{
+		FSagParams Sag;
+		FSegmentParams Segments;
+	};
+
+	// One span to build: endpoints plus per-wire fallbacks.
+	struct FSpanInput
+	{
+		FVector Start = FVector::ZeroVector;
+		FVector End = FVector::ZeroVector;
+		int32 LineId = 0;
+		float WireSag = 0.f;
+		int32 WireSegments = 2;
+	};
+
+	// Stable per-line hash (endpoints quantized to 1 cm).
+	POWERLINECORE_API uint32 HashLine(const FVector& A, const FVector& B, int32 LineId);
+
+	// Sag in cm (positive = downward).
+	POWERLINECORE_API float ComputeSag(const FSagParams& Params, const FVector& A, const FVector& B, int32 LineId);
+
+	POWERLINECORE_API int32 ComputeSegments(const FSegmentParams& Params, float LengthCm);
+
+	// Returns false when disabled or the chance roll fails.
+	POWERLINECORE_API bool ComputeHanging(const FHangingParams& Params, const FVector& A, const FVector& B, int32 LineId, FHangingResult& Out);
+
+	// Effective sag/segments for a span: district sag wins, segments take the finer of wire/district.
+	POWERLINECORE_API void ResolveSpan(const FSpanInput& Span, const FDistrictParams* District, float& OutSag, int32& OutSegments);
+
+	// Equal-length points along the sagged curve (arc-length parameterization).
+	// Sag is applied downward with 4t(1-t) profile. Returns false for degenerate (zero-length) curves.
+	POWERLINECORE_API bool BuildSaggedCurve(const FVector& Start, const FVector& End, float Sag, int32 NumSegments, TArray<FVector>& OutPoints);
+
+	// Conductor bundle (e.g. three phases + neutral on one crossarm) built in one pass.
+	// Conductor c runs from Start + StartOffsets[c] to End + EndOffsets[c]. All conductors share the span sag and the
+	// arc-length parameters of the centre curve, so the curve is measured once instead of once per conductor.
+	// OutPoints holds NumSegments + 1 points per conductor, conductor after conductor.
+	POWERLINECORE_API bool BuildSaggedBundle(const FVector& Start, const FVector& End, float Sag, int32 NumSegments,
+		TArrayView<const FVector> StartOffsets, TArrayView<const FVector> EndOffsets, TArray<FVector>& OutPoints);
+
+	// Broken wire: the intact curve (equal-length points) is cut at BreakT (0..1 along its length) and both pieces hang
+	// from their attach points. The segment count is kept (A gets round(N * BreakT), each piece at least one), so a
+	// break can overwrite the intact wire's segments in place. OutA starts at Points[0], OutB at Points.Last().
+	// GroundZA/B: ground height under each anchor; a piece longer than its drop lays the rest along the ground towards
+	// the cut (-MAX_flt = no ground).
+	POWERLINECORE_API bool BuildBrokenPieces(TArrayView<const FVector> Points, float BreakT, float GroundZA, float GroundZB,
+		TArray<FVector>& OutA, TArray<FVector>& OutB);
+
+	// ResolveSpan + BuildSaggedCurve.
+	POWERLINECORE_API bool BuildSpan(const FSpanInput& Span, const FDistrictParams* District, TArray<FVector>& OutPoints);
+
+	// ============================
+	// Shape cache (translation-identical wires)
+	// Sag is a pure vertical offset, so a wire curve only depends on End - Start, sag and segment count.
+	// ============================
+
+	struct FShapeKey
+	{
+		FIntVector Delta;      // End - Start, 1 cm precision (same as HashLine)
+		int32 SagMm = 0;       // Effective sag, 1 mm precision
+		int32 Segments = 0;
+
+		bool operator==(const FShapeKey& O) const
+		{
+			return Delta == O.Delta && SagMm == O.SagMm && Segments == O.Segments;
+		}
+
+		friend uint32 GetTypeHash(const FShapeKey& K)
+		{
+			uint32 H = GetTypeHash(K.Delta);
+			H = HashCombine(H, GetTypeHash(K.SagMm));
+			H = HashCombine(H, GetTypeHash(K.Segments));
+			return H;
+		}
+	};
+
+	// Curve points relative to wire start (Segments + 1 points, empty for degenerate wires).
+	struct FShape
+	{
+		int32 ShapeId = INDEX_NONE; // Unique per built shape (groups instanced draws)
+		TArray<FVector> Points;
+	};
+
+	typedef TSharedPtr<const FShape, ESPMode::ThreadSafe> FShapePtr;
+
+	// Not thread safe: Find/Add from one thread, BuildShape from any.
+	class POWERLINECORE_API FShapeCache
+	{
+	public:
+		// Returns shared curve for this relative span (builds it on miss). Never null.
+		FShapePtr FindOrBuild(const FVector& Delta, float Sag, int32 Segments);
+
+		// Split form for parallel rebuilds: Find/Add on the owning thread, BuildShape on any thread.
+		static FShapeKey MakeKey(const FVector& Delta, float Sag, int32 Segments);
+		static TSharedRef<FShape, ESPMode::ThreadSafe> BuildShape(const FShapeKey& Key);
+		FShapePtr Find(const FShapeKey& Key);
+		FShapePtr Add(const FShapeKey& Key, const TSharedRef<FShape, ESPMode::ThreadSafe>& Shape);
+
+		void Reset();
+		int32 Num() const { return Entries.Num(); }
+		SIZE_T GetAllocatedSize() const;
+
+		// Past this, Add evicts a shape not found since the clock hand last passed it (second chance), so a working
+		// set slightly over the cap keeps most of its hits instead of starting over.
+		int32 MaxEntries = 4096;
+
+		uint64 Hits = 0;
+		uint64 Misses = 0;
+		uint64 Evictions = 0;
+		uint64 Bypassed = 0; // Wires built without the cache (counted by the caller)
+
+	private:
+		struct FEntry
+		{
+			FShapeKey Key;
+			FShapePtr Shape;
+			bool bReferenced = false; // Found since the clock hand last passed
+		};
+
+		TMap<FShapeKey, int32> Index; // -> Entries
+		TArray<FEntry> Entries;
+		int32 ClockHand = 0;
+		int32 NextShapeId = 0;
+	};
+
+	// ============================
+	// Wind: evaluated per vertex at draw time, only these attributes are baked into segments
+	// ============================
+
+	struct FWindParams
+	{
+		FVector3f Direction = FVector3f(1.f, 0.f, 0.f); // Horizontal, unit
+		float Strength = 0.f;                           // Mid-span sway per cm of wire amplitude (0 = off)
+		float Frequency = 0.4f;                         // Hz
+		float Gust = 0.35f;                             // Weight of the faster ripple on top of the sway
+
+		bool operator==(const FWindParams& O) const
+		{
+			return Direction == O.Direction && Strength == O.Strength && Frequency == O.Frequency && Gust == O.Gust;
+		}
+		bool operator!=(const FWindParams& O) const { return !(*this == O); }
+	};
+
+	// Per-segment wind attributes (8 bytes).
+	struct FWindAttributes
+	{
+		uint16 SpanT0 = 0;    // Along-span parameter of the segment start/end, unorm16
+		uint16 SpanT1 = 0;
+		uint16 Phase = 0;     // Per-wire phase, unorm16 of one period
+		uint16 Amplitude = 0; // Wire amplitude (|sag|, district wind scale applied at draw time), 0.1 cm units
+	};
+
+	// Phase comes from the line hash (HashLine), so neighbouring wires don't swing in lockstep.
+	POWERLINECORE_API FWindAttributes PackWindAttributes(float SpanT0, float SpanT1, uint32 LineHash, float AmplitudeCm);
+	POWERLINECORE_API void UnpackWindAttributes(const FWindAttributes& In, float& OutSpanT0, float& OutSpanT1, float& OutPhase, float& OutAmplitudeCm);
+
+	// Sway offset of one wire point: sag-shaped 4t(1-t) (zero at the attachments), Phase in radians.
+	POWERLINECORE_API FVector3f ComputeWindOffset(const FWindParams& Wind, float TimeSeconds, float SpanT, float Phase, float AmplitudeCm);
+
+	// Upper bound of |ComputeWindOffset| (render bounds).
+	POWERLINECORE_API float GetMaxWindOffset(const FWindParams& Wind, float AmplitudeCm);
+
+	// ============================
+	// Cable simulation (Verlet, structure of arrays)
+	// ============================
+
+	struct FCableSimParams
+	{
+		float GravityZ = -980.f;
+		float Damping = 0.02f;             // Velocity fraction lost per substep
+		int32 Iterations = 6;              // Length constraint passes per substep
+		float SubstepSeconds = 1.f / 60.f;
+		int32 MaxSubsteps = 3;             // Per Step call (long frames slow the cable down instead of exploding)
+	};
+
+	// One simulated cable. Particles are stored relative to Origin in separate float arrays so the
+	// integration loop vectorizes; particle 0 and N-1 are pinned to the attachments.
+	struct POWERLINECORE_API FCableState
+	{
+		FVector Origin = FVector::ZeroVector;
+		TArray<float> X, Y, Z;    // Current
+		TArray<float> PX, PY, PZ; // Previous
+		float RestLength = 0.f;   // Per link
+		float Accumulator = 0.f;
+		float LastMaxSpeed = 0.f; // cm/s
+
+		int32 Num() const { return X.Num(); }
+
+		// At rest on Points (link length = average spacing of Points).
+		void Init(const TArray<FVector>& Points);
+
+		// Adds Velocity (cm/s) to particles within Radius of Center, with linear falloff.
+		void AddImpulse(const FVector& Center, float Radius, const FVector& Velocity, float SubstepSeconds);
+
+		// Advances by DeltaSeconds in fixed substeps. Returns the max particle speed (cm/s).
+		float Step(const FCableSimParams& Params, const FVector& PinA, const FVector& PinB, float DeltaSeconds);
+
+		void GetPoints(TArray<FVector>& Out) const;
+
+		SIZE_T GetAllocatedSize() const
+		{
+			return X.GetAllocatedSize() * 6;
+		}
+	};
+
+	// ============================
+	// Wire queries: BVH over curve segments
+	// ============================
+
+	// Segment of one wire curve, relative to the BVH origin (float keeps nodes small).
+	struct FWireSegment
+	{
+		FVector3f A;
+		FVector3f B;
+		int32 Wire = 0;                // Caller's wire index
+		float DistanceAlongWire = 0.f; // At A
+	};
+
+	struct FSegmentHit
+	{
+		int32 Wire = INDEX_NONE;
+		int32 Segment = INDEX_NONE;
+		float Distance = 0.f;                   // Along the query from Start, or from the query point (cm)
+		float DistanceAlongWire = 0.f;
+		FVector Location = FVector::ZeroVector; // Closest point on the wire
+	};
+
+	class POWERLINECORE_API FSegmentBVH
+	{
+	public:
+		// Takes the segments (reordered in place). Leaves hold up to LeafSize segments.
+		void Build(TArray<FWireSegment>&& InSegments, const FVector& InOrigin, int32 LeafSize = 4);
+
+		// Capsule cast: first wire segment within Radius of Start->End. bAnyHit returns on the first overlap found.
+		bool CapsuleCast(const FVector& Start, const FVector& End, float Radius, bool bAnyHit, FSegmentHit& OutHit) const;
+
+		// Closest segment to Point closer than MaxDistance (branch and bound on box distance).
+		bool FindNearest(const FVector& Point, float MaxDistance, FSegmentHit& OutHit) const;
+
+		// Closest point of every wire within Radius of Point (one hit per wire, unordered). Returns the number added.
+		int32 FindInRadius(const FVector& Point, float Radius, TArray<FSegmentHit>& OutHits) const;
+
+		bool IsEmpty() const { return Nodes.Num() == 0; }
+		int32 NumSegments() const { return Segments.Num(); }
+		FBox GetBounds() const;
+		SIZE_T GetAllocatedSize() const { return Nodes.GetAllocatedSize() + Segments.GetAllocatedSize(); }
+
+	private:
+		struct FNode
+		{
+			FVector3f Min;
+			FVector3f Max;
+			int32 First = 0; // Leaf: first segment. Inner: left child (right child = First + 1).
+			int32 Count = 0; // > 0 for leaves
+		};
+
+		FVector Origin = FVector::ZeroVector;
+		TArray<FNode> Nodes;
+		TArray<FWireSegment> Segments;
+	};
+
+	// Closest points between P0-P1 and Q0-Q1 (OutS on P, OutT on Q, both in [0, 1]). Returns squared distance.
+	POWERLINECORE_API float ClosestSegmentSegment(const FVector3f& P0, const FVector3f& P1, const FVector3f& Q0, const FVector3f& Q1, float& OutS, float& OutT);
+
+	// Closest point on A-B to P (OutT in [0, 1]). Returns squared distance.
+	POWERLINECORE_API float ClosestPointSegment(const FVector3f& P, const FVector3f& A, const FVector3f& B, float& OutT);
+
+	// Appends one wire curve as segments relative to Origin (DistanceAlongWire accumulated).
+	POWERLINECORE_API void AppendWireSegments(TArrayView<const FVector> Points, const FVector& Origin, int32 Wire, TArray<FWireSegment>& Out);
+
+	// ============================
+	// Auto wiring: links between nearby points (spatial hash, candidate search in parallel)
+	// ============================
+
+	enum class EAutoWirePolicy : uint8
+	{
+		MinimumSpanningTree, // Shortest total length (Kruskal over the nearest candidates)
+		NearestK,            // Every point linked to its K nearest
+	};
+
+	struct FAutoWireParams
+	{
+		EAutoWirePolicy Policy = EAutoWirePolicy::MinimumSpanningTree;
+		float MaxSpanCm = 5000.f; // Also the hash cell size
+		int32 K = 2;
+		int32 TreeCandidates = 8; // Nearest neighbours per point the spanning tree is chosen from
+	};
+
+	struct FAutoWireLink
+	{
+		int32 A = INDEX_NONE; // A < B
+		int32 B = INDEX_NONE;
+		float Length = 0.f;
+	};
+
+	// Points only link within the same group (Groups empty = one group). Links are sorted by length; the tree
+	// is a forest where MaxSpanCm or the groups leave points unreachable.
+	POWERLINECORE_API void AutoWire(TArrayView<const FVector> Points, TArrayView<const uint32> Groups, const FAutoWireParams& Params, TArray<FAutoWireLink>& OutLinks);
+
+	// ============================
+	// Connectivity graph (undirected, incremental)
+	// A spanning forest is kept as Euler tours in treaps (Euler-tour trees): linking two trees, cutting a tree edge
+	// and the connectivity/power queries are O(log n). Edges inside one tree are non-tree edges; every tour also
+	// counts the non-tree edge ends it holds, so cutting a tree edge only looks for a replacement among the
+	// non-tree edges of the smaller piece (a few hops around the cut first, where meshed grids close their short
+	// cycles). Trees and radial feeders split in O(log n) wherever the cut is; otherwise the cost follows the
+	// non-tree edges of the smaller side, not its vertices.
+	// ============================
+
+	class POWERLINECORE_API FConnectivityGraph
+	{
+	public:
+		int32 AddVertex();
+		void RemoveVertex(int32 V); // Also removes its edges
+
+		int32 AddEdge(int32 A, int32 B);
+		void RemoveEdge(int32 Edge);
+
+		// Components with at least one source vertex are powered.
+		void SetSource(int32 V, bool bSource);
+
+		bool IsValidVertex(int32 V) const { return VertexNode.IsValidIndex(V) && VertexNode[V] != INDEX_NONE; }
+		bool IsValidEdge(int32 Edge) const { return Edges.IsValidIndex(Edge) && Edges[Edge].A != INDEX_NONE; }
+		void GetEdgeVertices(int32 Edge, int32& OutA, int32& OutB) const { OutA = Edges[Edge].A; OutB = Edges[Edge].B; }
+		const TArray<int32, TInlineAllocator<4>>& GetVertexEdges(int32 V) const { return Adjacency[V]; }
+
+		// Representative of V's component: equal for connected vertices, only stable until the next edit.
+		int32 FindComponent(int32 V) const { return IsValidVertex(V) ? FindRoot(VertexNode[V]) : INDEX_NONE; }
+		bool AreConnected(int32 A, int32 B) const { return IsValidVertex(A) && IsValidVertex(B) && FindRoot(VertexNode[A]) == FindRoot(VertexNode[B]); }
+		bool IsPowered(int32 V) const { return IsValidVertex(V) && Nodes[FindRoot(VertexNode[V])].Sources > 0; }
+		void GetComponent(int32 V, TArray<int32>& OutVertices) const;
+
+		int32 NumVertices() const { return NumAlive; }
+		int32 NumEdges() const { return Edges.Num() - FreeEdges.Num(); }
+		int32 NumComponents() const { return NumTrees; }
+		SIZE_T GetAllocatedSize() const;
+
+	private:
+		struct FEdge
+		{
+			int32 A = INDEX_NONE; // INDEX_NONE = free slot
+			int32 B = INDEX_NONE;
+			int32 Arcs[2] = { INDEX_NONE, INDEX_NONE }; // Tour nodes A->B and B->A (tree edges only)
+		};
+
+		// Treap node of an Euler tour: one per vertex and one per direction of each tree edge. Subtree sums
+		// answer "how big / powered / how many non-tree ends" for a whole tree at its root.
+		struct FTourNode
+		{
+			int32 Left = INDEX_NONE;
+			int32 Right = INDEX_NONE;
+			int32 Parent = INDEX_NONE;
+			uint32 Priority = 0;
+			int32 Vertex = INDEX_NONE; // INDEX_NONE for edge arcs
+			int32 Size = 1;            // Tour nodes in the subtree
+			int32 Vertices = 0;
+			int32 NonTree = 0;         // Non-tree edge ends
+			int32 Sources = 0;
+		};
+
+		// Treap primitives (index based; Merge/Split leave the parent of the returned roots to the caller).
+		int32 AllocateNode(int32 Vertex);
+		void FreeNode(int32 Node);
+		void UpdateNode(int32 Node);
+		void UpdateToRoot(int32 Node);
+		int32 FindRoot(int32 Node) const;
+		int32 GetPosition(int32 Node) const;
+		int32 Merge(int32 L, int32 R);
+		void Split(int32 Root, int32 Count, int32& OutL, int32& OutR);
+		int32 Join(int32 L, int32 R);
+		void SplitRoot(int32 Root, int32 Count, int32& OutL, int32& OutR);
+
+		// Tour rotated to start at V's node. Returns the new root.
+		int32 Reroot(int32 V);
+		void Link(int32 Edge);
+		// Cuts a tree edge; OutA/OutB are the roots of the two trees left.
+		void Cut(int32 Edge, int32& OutA, int32& OutB);
+		// Non-tree edge leading out of the tree at SmallRoot (Start: its end of the cut edge), INDEX_NONE if none.
+		int32 FindReplacement(int32 SmallRoot, int32 Start);
+		void SetNonTree(int32 Edge, bool bNonTree);
+
+		// Per vertex (VertexNode == INDEX_NONE: free slot).
+		TArray<int32> VertexNode;
+		TArray<int32> NonTreeCount;
+		TArray<uint8> Source;
+		TArray<uint32> Visit;      // Search stamps
+		TArray<TArray<int32, TInlineAllocator<4>>> Adjacency;
+		TArray<int32> FreeVertices;
+		int32 NumAlive = 0;
+		int32 NumTrees = 0;
+
+		TArray<FEdge> Edges;
+		TArray<int32> FreeEdges;
+
+		TArray<FTourNode> Nodes;
+		TArray<int32> FreeNodes;
+		uint32 PrioritySeed = 0x9E3779B9u;
+		uint32 VisitStamp = 0;
+	};
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// ============================
+// PowerLine core benchmarks
+// Core math only (no world): per-wire resolve, per-segment curve cost, thread scaling, auto wiring and
+// connectivity. Run as a plain program by the PowerLineCoreTests target ("[bench]" tag) and in the editor by
+// the stress commandlet (-run=PowerLineStress -CoreBench, with -Max<Metric>=/-Min<Metric>= gates).
+// ============================
+
+namespace PowerLineCore
+{
+	// Scene size, same meaning (and defaults) as the stress commandlet parameters.
+	struct FBenchParams
+	{
+		int32 Seed = 1;
+		int32 Poles = 2000;
+		int32 WiresPerPole = 4;
+		float HangingRatio = 0.05f;
+		float PoleSpacingCm = 3000.f;
+	};
+
+	// Built-in -Max gate of a metric (< 0: not gated). The commandlet's -Max<Metric>= overrides it.
+	POWERLINECORE_API double GetDefaultMax(const TCHAR* Metric);
+
+	// Fastest of Runs calls, in ms.
+	POWERLINECORE_API double BestOfMs(int32 Runs, TFunctionRef<void()> Fn);
+
+	// Every result goes through AddMetric (name encodes the unit: Ms, Us, Ns, KB, ratios without suffix).
+	POWERLINECORE_API void RunBench(const FBenchParams& S, TFunctionRef<void(const TCHAR* Name, double Value)> AddMetric);
+}
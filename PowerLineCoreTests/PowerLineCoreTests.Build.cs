@@ -0,0 +1,13 @@
+using UnrealBuildTool;
+
+// Catch2 low-level tests and microbenchmarks for PowerLineCore, built as a standalone program (no engine, no
+// editor) so they run on a plain Linux host and in CI.
+public class PowerLineCoreTests : TestModuleRules
+{
+	public PowerLineCoreTests(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PrivateDependencyModuleNames.AddRange(new string[] { "Core", "PowerLineCore" });
+
+		UpdateBuildGraphPropertiesFile(new Metadata() { TestName = "PowerLineCore", TestShortName = "PowerLineCore" });
+	}
+}
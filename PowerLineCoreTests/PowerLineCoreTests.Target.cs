@@ -0,0 +1,16 @@
+using UnrealBuildTool;
+
+// Build:  RunUBT.sh PowerLineCoreTests Linux Development
+// Run:    Binaries/Linux/PowerLineCoreTests/PowerLineCoreTests "[PowerLine]"
+// Bench:  Binaries/Linux/PowerLineCoreTests/PowerLineCoreTests "[bench]"
+public class PowerLineCoreTestsTarget : TestTargetRules
+{
+	public PowerLineCoreTestsTarget(TargetInfo Target) : base(Target)
+	{
+		bCompileAgainstEngine = false;
+		bCompileAgainstCoreUObject = false;
+		bCompileAgainstApplicationCore = false;
+		bUsesSlate = false;
+		bBuildWithEditorOnlyData = false;
+	}
+}
@@ -0,0 +1,645 @@
+#include "PowerLineCore.h"
+#include "PowerLineCoreBench.h"
+
+#include "TestHarness.h"
+#include "Math/RandomStream.h"
+
+// ============================
+// PowerLine core unit tests
+// Plain-data checks of the core math (no world needed), built by the PowerLineCoreTests low-level test target so
+// they run on a plain host without the editor:
+//   RunUBT.sh PowerLineCoreTests Linux Development
+//   PowerLineCoreTests "[PowerLine]"      (tests)
+//   PowerLineCoreTests "[bench]"          (core microbenchmarks, hidden from the default run)
+// ============================
+
+using namespace PowerLineCore;
+
+// ============================
+// Hash / sag
+// ============================
+
+TEST_CASE("PowerLine::Core::HashAndSag", "[PowerLine][Core]")
+{
+	const FVector A(100.f, 200.f, 1000.f);
+	const FVector B(4100.f, -300.f, 1200.f);
+
+	CHECK(HashLine(A, B, 3) == HashLine(A, B, 3));
+	CHECK(HashLine(A + FVector(0.2f, -0.3f, 0.1f), B, 3) == HashLine(A, B, 3));
+	CHECK(HashLine(A, B, 3) != HashLine(A, B, 4));
+
+	FSagParams Sag;
+	Sag.MinCm = 40.f;
+	Sag.MaxCm = 120.f;
+	Sag.Scale = 1.5f;
+
+	const float S0 = ComputeSag(Sag, A, B, 3);
+	CHECK(ComputeSag(Sag, A, B, 3) == S0);
+	CHECK((S0 >= Sag.MinCm * Sag.Scale && S0 <= Sag.MaxCm * Sag.Scale));
+
+	// Another seed is another random sequence.
+	FSagParams Reseeded = Sag;
+	Reseeded.Seed = Sag.Seed + 1;
+	CHECK(ComputeSag(Reseeded, A, B, 3) != S0);
+
+	Sag.Scale = 0.f;
+	CHECK(ComputeSag(Sag, A, B, 3) == 0.f);
+}
+
+// ============================
+// Curves
+// ============================
+
+TEST_CASE("PowerLine::Core::SaggedCurve", "[PowerLine][Core]")
+{
+	const FVector Start(0.f, 0.f, 1000.f);
+	const FVector End(4000.f, 0.f, 1000.f);
+	const float Sag = 150.f;
+	const int32 N = 16;
+
+	TArray<FVector> Points;
+	REQUIRE(BuildSaggedCurve(Start, End, Sag, N, Points));
+
+	CHECK(Points.Num() == N + 1);
+	CHECK(Points[0].Equals(Start, 0.01f));
+	CHECK(Points.Last().Equals(End, 0.5f));
+
+	// Arc-length parameterization: every segment has the same length (up to the sampling resolution).
+	float TotalLen = 0.f;
+	for (int32 i = 0; i + 1 < Points.Num(); ++i)
+	{
+		TotalLen += FVector::Dist(Points[i], Points[i + 1]);
+	}
+	const float Expected = TotalLen / N;
+	for (int32 i = 0; i + 1 < Points.Num(); ++i)
+	{
+		CHECK(FMath::IsNearlyEqual(FVector::Dist(Points[i], Points[i + 1]), Expected, Expected * 0.01f));
+	}
+
+	// Symmetric span: the middle point is the lowest one, Sag below the chord.
+	CHECK(FMath::IsNearlyEqual(Points[N / 2].Z, Start.Z - Sag, 0.5f));
+	CHECK(FMath::IsNearlyEqual(Points[N / 2].X, 2000.f, 0.5f));
+
+	CHECK_FALSE(BuildSaggedCurve(Start, Start, 0.f, N, Points));
+}
+
+TEST_CASE("PowerLine::Core::SaggedBundle", "[PowerLine][Core]")
+{
+	const FVector Start(0.f, 0.f, 1000.f);
+	const FVector End(3500.f, 900.f, 1150.f);
+	const float Sag = 120.f;
+	const int32 N = 12;
+
+	TArray<FVector> Centre;
+	REQUIRE(BuildSaggedCurve(Start, End, Sag, N, Centre));
+
+	// Same offset at both ends: every conductor is the centre curve, translated.
+	const FVector Shift(0.f, 80.f, -25.f);
+	const FVector Same[] = { Shift, -Shift };
+	TArray<FVector> Points;
+	REQUIRE(BuildSaggedBundle(Start, End, Sag, N, Same, Same, Points));
+	REQUIRE(Points.Num() == 2 * (N + 1));
+	for (int32 c = 0; c < 2; ++c)
+	{
+		for (int32 i = 0; i <= N; ++i)
+		{
+			CHECK(Points[c * (N + 1) + i].Equals(Centre[i] + Same[c], 0.5f));
+		}
+	}
+
+	// Different crossarms: each conductor runs exactly from its own start to its own end.
+	const FVector StartOffsets[] = { FVector(0.f, -150.f, 0.f), FVector(0.f, 0.f, 40.f), FVector(0.f, 150.f, 0.f) };
+	const FVector EndOffsets[] = { FVector(0.f, -100.f, 20.f), FVector(0.f, 0.f, 60.f), FVector(0.f, 100.f, 20.f) };
+	REQUIRE(BuildSaggedBundle(Start, End, Sag, N, StartOffsets, EndOffsets, Points));
+	REQUIRE(Points.Num() == 3 * (N + 1));
+	for (int32 c = 0; c < 3; ++c)
+	{
+		CHECK(Points[c * (N + 1)].Equals(Start + StartOffsets[c], 0.01f));
+		CHECK(Points[c * (N + 1) + N].Equals(End + EndOffsets[c], 0.5f));
+	}
+
+	CHECK_FALSE(BuildSaggedBundle(Start, End, Sag, N, TArrayView<const FVector>(), TArrayView<const FVector>(), Points));
+}
+
+TEST_CASE("PowerLine::Core::ResolveSpan", "[PowerLine][Core]")
+{
+	FSpanInput Span;
+	Span.Start = FVector(0.f, 0.f, 800.f);
+	Span.End = FVector(3000.f, 0.f, 800.f);
+	Span.LineId = 7;
+	Span.WireSag = 55.f;
+	Span.WireSegments = 1;
+
+	float Sag = 0.f;
+	int32 Segments = 0;
+	ResolveSpan(Span, nullptr, Sag, Segments);
+	CHECK(Sag == 55.f);
+	CHECK(Segments == 2);
+
+	FDistrictParams District;
+	District.Segments.TargetLengthCm = 100.f; // 30 segments for 3000 cm
+	ResolveSpan(Span, &District, Sag, Segments);
+	CHECK(Sag == ComputeSag(District.Sag, Span.Start, Span.End, Span.LineId));
+	CHECK(Segments == 30);
+
+	// Per-wire segments can only add detail.
+	Span.WireSegments = 48;
+	ResolveSpan(Span, &District, Sag, Segments);
+	CHECK(Segments == 48);
+}
+
+TEST_CASE("PowerLine::Core::BrokenPieces", "[PowerLine][Core]")
+{
+	const FVector Start(0.f, 0.f, 1000.f);
+	const FVector End(4000.f, 0.f, 1000.f);
+	const int32 N = 12;
+
+	TArray<FVector> Points;
+	BuildSaggedCurve(Start, End, 100.f, N, Points);
+
+	TArray<FVector> PieceA;
+	TArray<FVector> PieceB;
+	for (const float BreakT : { 0.f, 0.3f, 0.5f, 1.f })
+	{
+		REQUIRE(BuildBrokenPieces(Points, BreakT, -MAX_flt, -MAX_flt, PieceA, PieceB));
+
+		// Same segment count as the intact wire (in-place rewrite), each piece at least one segment.
+		CHECK((PieceA.Num() - 1) + (PieceB.Num() - 1) == N);
+		CHECK((PieceA.Num() >= 2 && PieceB.Num() >= 2));
+		CHECK(PieceA[0].Equals(Points[0]));
+		CHECK(PieceB[0].Equals(Points.Last()));
+	}
+
+	// 10 m above the ground, ~20 m pieces: they end up on the ground, not below it.
+	const float GroundZ = 0.f;
+	BuildBrokenPieces(Points, 0.5f, GroundZ, GroundZ, PieceA, PieceB);
+	float MinZ = MAX_flt;
+	for (const FVector& P : PieceA) MinZ = FMath::Min(MinZ, P.Z);
+	for (const FVector& P : PieceB) MinZ = FMath::Min(MinZ, P.Z);
+	CHECK(FMath::IsNearlyEqual(MinZ, GroundZ, 0.01f));
+
+	TArray<FVector> OneSegment = { Start, End };
+	CHECK_FALSE(BuildBrokenPieces(OneSegment, 0.5f, -MAX_flt, -MAX_flt, PieceA, PieceB));
+}
+
+// ============================
+// Shape cache
+// ============================
+
+TEST_CASE("PowerLine::Core::ShapeCache", "[PowerLine][Core]")
+{
+	FShapeCache Cache;
+	const FVector Delta(3000.f, 400.f, 120.f);
+
+	const FShapePtr A = Cache.FindOrBuild(Delta, 80.f, 10);
+	REQUIRE(A.IsValid());
+	CHECK(A->Points.Num() == 11);
+	CHECK(A->Points[0].Equals(FVector::ZeroVector));
+	CHECK(A->Points.Last().Equals(Delta, 0.5f));
+	CHECK(Cache.Misses == 1);
+
+	// Translation-identical wires (and sub-cm / sub-mm jitter) share one shape.
+	CHECK(Cache.FindOrBuild(Delta + FVector(0.3f, -0.2f, 0.1f), 80.04f, 10) == A);
+	CHECK(Cache.Hits == 1);
+	CHECK(Cache.MakeKey(Delta, 80.f, 10) == Cache.MakeKey(Delta + FVector(0.4f), 80.04f, 10));
+	CHECK_FALSE(Cache.MakeKey(Delta, 80.f, 10) == Cache.MakeKey(Delta, 80.2f, 10));
+	CHECK_FALSE(Cache.MakeKey(Delta, 80.f, 10) == Cache.MakeKey(Delta, 80.f, 11));
+
+	// Over the cap the clock evicts the shape not found since it last passed: B goes, A (found again) stays.
+	Cache.Reset();
+	Cache.MaxEntries = 2;
+	const FShapePtr SA = Cache.FindOrBuild(Delta, 80.f, 10);
+	const FShapePtr SB = Cache.FindOrBuild(Delta, 90.f, 10);
+	CHECK(Cache.FindOrBuild(Delta, 80.f, 10) == SA);
+	const FShapePtr SC = Cache.FindOrBuild(Delta, 100.f, 10);
+	CHECK(Cache.Num() == 2);
+	CHECK(Cache.Evictions == 1);
+	CHECK(Cache.Find(Cache.MakeKey(Delta, 80.f, 10)) == SA);
+	CHECK_FALSE(Cache.Find(Cache.MakeKey(Delta, 90.f, 10)).IsValid());
+
+	// Evicted shapes stay alive for their holders; every built shape gets its own id.
+	CHECK(SB->Points.Num() == 11);
+	CHECK(SA->ShapeId != SB->ShapeId);
+	CHECK(SB->ShapeId != SC->ShapeId);
+	CHECK(SA->ShapeId != SC->ShapeId);
+}
+
+// ============================
+// Wind
+// ============================
+
+TEST_CASE("PowerLine::Core::WindPack", "[PowerLine][Core]")
+{
+	const uint32 Hash = HashLine(FVector(1.f, 2.f, 3.f), FVector(400.f, 5.f, 6.f), 9);
+	const FWindAttributes Packed = PackWindAttributes(0.25f, 0.3125f, Hash, 87.3f);
+
+	float T0 = 0.f;
+	float T1 = 0.f;
+	float Phase = 0.f;
+	float Amplitude = 0.f;
+	UnpackWindAttributes(Packed, T0, T1, Phase, Amplitude);
+	CHECK(FMath::IsNearlyEqual(T0, 0.25f, 1.f / 65535.f));
+	CHECK(FMath::IsNearlyEqual(T1, 0.3125f, 1.f / 65535.f));
+	CHECK(FMath::IsNearlyEqual(Amplitude, 87.3f, 0.05f));
+	CHECK(FMath::IsNearlyEqual(Phase, (float)(Hash & 0xFFFF) / 65536.f * UE_TWO_PI, 1e-4f));
+
+	// Out of range input is clamped, not wrapped.
+	UnpackWindAttributes(PackWindAttributes(-0.5f, 1.5f, Hash, -10.f), T0, T1, Phase, Amplitude);
+	CHECK(T0 == 0.f);
+	CHECK(T1 == 1.f);
+	CHECK(Amplitude == 0.f);
+}
+
+// ============================
+// Cable simulation
+// ============================
+
+TEST_CASE("PowerLine::Core::CableState", "[PowerLine][Core]")
+{
+	const FVector PinA(0.f, 0.f, 1000.f);
+	const FVector PinB(2000.f, 0.f, 1000.f);
+	TArray<FVector> Points;
+	REQUIRE(BuildSaggedCurve(PinA, PinB, 80.f, 16, Points));
+
+	FCableState Cable;
+	Cable.Init(Points);
+	REQUIRE(Cable.Num() == 17);
+
+	FCableSimParams Params;
+	Params.Iterations = 20;
+
+	// Settle, then the pins are exact and the links keep their rest length.
+	for (int32 Frame = 0; Frame < 120; ++Frame)
+	{
+		Cable.Step(Params, PinA, PinB, Params.SubstepSeconds);
+	}
+	TArray<FVector> Out;
+	Cable.GetPoints(Out);
+	REQUIRE(Out.Num() == Points.Num());
+	CHECK(Out[0].Equals(PinA, 0.01f));
+	CHECK(Out.Last().Equals(PinB, 0.01f));
+	for (int32 i = 0; i + 1 < Out.Num(); ++i)
+	{
+		CHECK(FMath::IsNearlyEqual((float)FVector::Dist(Out[i], Out[i + 1]), Cable.RestLength, Cable.RestLength * 0.05f));
+	}
+	const float RestSpeed = Cable.LastMaxSpeed;
+
+	// A hit makes it move, damping brings it back down.
+	Cable.AddImpulse(FMath::Lerp(PinA, PinB, 0.5f), 600.f, FVector(0.f, 500.f, 0.f), Params.SubstepSeconds);
+	const float HitSpeed = Cable.Step(Params, PinA, PinB, Params.SubstepSeconds);
+	CHECK(HitSpeed > RestSpeed + 100.f);
+
+	Params.Damping = 0.2f;
+	for (int32 Frame = 0; Frame < 120; ++Frame)
+	{
+		Cable.Step(Params, PinA, PinB, Params.SubstepSeconds);
+	}
+	CHECK(Cable.LastMaxSpeed < HitSpeed * 0.1f);
+
+	// Frames shorter than a substep accumulate instead of stepping.
+	const FVector Before(Cable.X[8], Cable.Y[8], Cable.Z[8]);
+	Cable.Step(Params, PinA, PinB, Params.SubstepSeconds * 0.25f);
+	CHECK(FVector(Cable.X[8], Cable.Y[8], Cable.Z[8]).Equals(Before));
+}
+
+// ============================
+// Wire queries
+// ============================
+
+TEST_CASE("PowerLine::Core::SegmentBVH", "[PowerLine][Core]")
+{
+	// A few hundred sagged wires in a 100 m box, queried against brute force over the same segments.
+	FRandomStream Rand(42);
+	const FVector Origin(50000.f, -20000.f, 0.f);
+	auto RandomPoint = [&Rand, &Origin]() {
+		return Origin + FVector(Rand.FRandRange(0.f, 10000.f), Rand.FRandRange(0.f, 10000.f), Rand.FRandRange(0.f, 2000.f));
+		};
+
+	TArray<FWireSegment> Segments;
+	TArray<FVector> Points;
+	for (int32 Wire = 0; Wire < 300; ++Wire)
+	{
+		const FVector A = RandomPoint();
+		const FVector B = A + FVector(Rand.FRandRange(-3000.f, 3000.f), Rand.FRandRange(-3000.f, 3000.f), Rand.FRandRange(-200.f, 200.f));
+		if (BuildSaggedCurve(A, B, Rand.FRandRange(0.f, 150.f), 8, Points))
+		{
+			AppendWireSegments(Points, Origin, Wire, Segments);
+		}
+	}
+	const TArray<FWireSegment> Reference = Segments;
+
+	FSegmentBVH BVH;
+	BVH.Build(MoveTemp(Segments), Origin);
+	CHECK(BVH.NumSegments() == Reference.Num());
+
+	for (int32 Query = 0; Query < 200; ++Query)
+	{
+		const FVector P = RandomPoint();
+		const FVector3f PL = FVector3f(P - Origin);
+
+		// Nearest
+		float BestSq = MAX_flt;
+		for (const FWireSegment& Seg : Reference)
+		{
+			float T = 0.f;
+			BestSq = FMath::Min(BestSq, ClosestPointSegment(PL, Seg.A, Seg.B, T));
+		}
+		FSegmentHit Hit;
+		const bool bNearest = BVH.FindNearest(P, 1e6f, Hit);
+		CHECK(bNearest);
+		if (bNearest)
+		{
+			CHECK(FMath::IsNearlyEqual(Hit.Distance, FMath::Sqrt(BestSq), 0.05f));
+		}
+
+		// Radius: one hit per wire within reach
+		const float Radius = 500.f;
+		TSet<int32> Near;
+		for (const FWireSegment& Seg : Reference)
+		{
+			float T = 0.f;
+			if (ClosestPointSegment(PL, Seg.A, Seg.B, T) <= Radius * Radius) Near.Add(Seg.Wire);
+		}
+		TArray<FSegmentHit> Hits;
+		CHECK(BVH.FindInRadius(P, Radius, Hits) == Near.Num());
+
+		// Capsule cast: the earliest point along the query where a wire is within Radius
+		const FVector End = RandomPoint();
+		const FVector3f EL = FVector3f(End - Origin);
+		const float Len = FVector3f::Dist(PL, EL);
+		const float CastRadius = 20.f;
+		float BestT = MAX_flt;
+		for (const FWireSegment& Seg : Reference)
+		{
+			float T = 0.f;
+			float S = 0.f;
+			const float D2 = ClosestSegmentSegment(PL, EL, Seg.A, Seg.B, T, S);
+			if (D2 > CastRadius * CastRadius) continue;
+			const float Back = Len > KINDA_SMALL_NUMBER ? FMath::Sqrt(CastRadius * CastRadius - D2) / Len : 0.f;
+			BestT = FMath::Min(BestT, FMath::Max(0.f, T - Back));
+		}
+		const bool bHit = BVH.CapsuleCast(P, End, CastRadius, false, Hit);
+		CHECK(bHit == (BestT != MAX_flt));
+		if (bHit && BestT != MAX_flt)
+		{
+			CHECK(FMath::IsNearlyEqual(Hit.Distance, BestT * Len, 0.05f));
+		}
+	}
+}
+
+// ============================
+// Auto wiring
+// ============================
+
+TEST_CASE("PowerLine::Core::AutoWire", "[PowerLine][Core]")
+{
+	// Jittered 20 x 20 grid, 30 m apart, in two groups (left and right half).
+	FRandomStream Rand(7);
+	TArray<FVector> Points;
+	TArray<uint32> Groups;
+	for (int32 Y = 0; Y < 20; ++Y)
+	{
+		for (int32 X = 0; X < 20; ++X)
+		{
+			Points.Add(FVector(X * 3000.f + Rand.FRandRange(-300.f, 300.f), Y * 3000.f + Rand.FRandRange(-300.f, 300.f), 0.f));
+			Groups.Add(X < 10 ? 0 : 1);
+		}
+	}
+
+	FAutoWireParams Params;
+	Params.MaxSpanCm = 4500.f;
+
+	auto CheckLinks = [&Points](const TArray<FAutoWireLink>& Links, float MaxSpan) {
+		for (int32 i = 0; i < Links.Num(); ++i)
+		{
+			const FAutoWireLink& L = Links[i];
+			CHECK(L.A < L.B);
+			CHECK(L.Length <= MaxSpan);
+			CHECK(FMath::IsNearlyEqual(L.Length, (float)FVector::Dist(Points[L.A], Points[L.B]), 0.1f));
+			if (i > 0)
+			{
+				CHECK(Links[i - 1].Length <= L.Length);
+			}
+		}
+		};
+
+	SECTION("Spanning tree")
+	{
+		TArray<FAutoWireLink> Links;
+		AutoWire(Points, TArrayView<const uint32>(), Params, Links);
+		CHECK(Links.Num() == Points.Num() - 1);
+		CheckLinks(Links, Params.MaxSpanCm);
+
+		// A tree over every point: no link closes a cycle.
+		FConnectivityGraph Graph;
+		for (int32 i = 0; i < Points.Num(); ++i) Graph.AddVertex();
+		for (const FAutoWireLink& L : Links)
+		{
+			CHECK_FALSE(Graph.AreConnected(L.A, L.B));
+			Graph.AddEdge(L.A, L.B);
+		}
+		CHECK(Graph.NumComponents() == 1);
+
+		// Groups: one tree per group, nothing crosses.
+		AutoWire(Points, Groups, Params, Links);
+		CHECK(Links.Num() == Points.Num() - 2);
+		for (const FAutoWireLink& L : Links)
+		{
+			CHECK(Groups[L.A] == Groups[L.B]);
+		}
+	}
+
+	SECTION("Nearest K")
+	{
+		Params.Policy = EAutoWirePolicy::NearestK;
+		Params.K = 3;
+		TArray<FAutoWireLink> Links;
+		AutoWire(Points, TArrayView<const uint32>(), Params, Links);
+		CheckLinks(Links, Params.MaxSpanCm);
+
+		TSet<TPair<int32, int32>> Linked;
+		for (const FAutoWireLink& L : Links)
+		{
+			bool bDuplicate = false;
+			Linked.Add(TPair<int32, int32>(L.A, L.B), &bDuplicate);
+			CHECK_FALSE(bDuplicate);
+		}
+
+		// Brute force: each point's K nearest within reach are linked to it.
+		for (int32 i = 0; i < Points.Num(); ++i)
+		{
+			TArray<TPair<double, int32>> Near;
+			for (int32 j = 0; j < Points.Num(); ++j)
+			{
+				const double Dist = FVector::Dist(Points[i], Points[j]);
+				if (j != i && Dist <= Params.MaxSpanCm) Near.Add(TPair<double, int32>(Dist, j));
+			}
+			Near.Sort([](const TPair<double, int32>& L, const TPair<double, int32>& R) { return L.Key < R.Key; });
+			for (int32 n = 0; n < FMath::Min(Params.K, Near.Num()); ++n)
+			{
+				const int32 j = Near[n].Value;
+				CHECK(Linked.Contains(TPair<int32, int32>(FMath::Min(i, j), FMath::Max(i, j))));
+			}
+		}
+	}
+}
+
+// ============================
+// Connectivity
+// ============================
+
+TEST_CASE("PowerLine::Core::Connectivity", "[PowerLine][Core]")
+{
+	FConnectivityGraph Graph;
+	int32 V[5];
+	for (int32& Vertex : V) Vertex = Graph.AddVertex();
+
+	// Chain 0-1-2-3, 4 alone
+	const int32 E01 = Graph.AddEdge(V[0], V[1]);
+	const int32 E12 = Graph.AddEdge(V[1], V[2]);
+	Graph.AddEdge(V[2], V[3]);
+	Graph.SetSource(V[0], true);
+
+	CHECK(Graph.AreConnected(V[0], V[3]));
+	CHECK(Graph.NumComponents() == 2);
+	CHECK(Graph.IsPowered(V[3]));
+	CHECK_FALSE(Graph.IsPowered(V[4]));
+
+	// Cutting the middle splits the far side off (and it loses power).
+	Graph.RemoveEdge(E12);
+	CHECK(Graph.AreConnected(V[0], V[1]));
+	CHECK(Graph.AreConnected(V[2], V[3]));
+	CHECK_FALSE(Graph.AreConnected(V[1], V[2]));
+	CHECK(Graph.NumComponents() == 3);
+	CHECK_FALSE(Graph.IsPowered(V[3]));
+
+	// Ring: removing one edge of a cycle does not split.
+	Graph.AddEdge(V[1], V[2]);
+	Graph.AddEdge(V[3], V[0]);
+	Graph.RemoveEdge(E01);
+	CHECK(Graph.AreConnected(V[0], V[1]));
+	CHECK(Graph.NumComponents() == 2);
+
+	// Removing a vertex removes its edges and may split the rest.
+	Graph.RemoveVertex(V[0]);
+	CHECK_FALSE(Graph.IsValidVertex(V[0]));
+	CHECK(Graph.AreConnected(V[1], V[3]));
+	CHECK_FALSE(Graph.IsPowered(V[1]));
+
+	TArray<int32> Members;
+	Graph.GetComponent(V[1], Members);
+	CHECK(Members.Num() == 3);
+}
+
+TEST_CASE("PowerLine::Core::ConnectivityRandomEdits", "[PowerLine][Core]")
+{
+	// Random edits (parallel wires, cycles, self loops, removed poles) against a flood fill over the same edges.
+	FRandomStream Rand(11);
+	for (int32 Round = 0; Round < 20; ++Round)
+	{
+		FConnectivityGraph Graph;
+		TArray<int32> Vertices;
+		TMap<int32, TPair<int32, int32>> EdgeEnds;
+		TSet<int32> Sources;
+		for (int32 i = 0; i < 12; ++i) Vertices.Add(Graph.AddVertex());
+
+		for (int32 Step = 0; Step < 300; ++Step)
+		{
+			const int32 Op = Rand.RandRange(0, 9);
+			if (Op < 4)
+			{
+				const int32 A = Vertices[Rand.RandRange(0, Vertices.Num() - 1)];
+				const int32 B = Vertices[Rand.RandRange(0, Vertices.Num() - 1)];
+				EdgeEnds.Add(Graph.AddEdge(A, B), TPair<int32, int32>(A, B));
+			}
+			else if (Op < 7 && EdgeEnds.Num() > 0)
+			{
+				TArray<int32> Ids;
+				EdgeEnds.GetKeys(Ids);
+				const int32 Edge = Ids[Rand.RandRange(0, Ids.Num() - 1)];
+				Graph.RemoveEdge(Edge);
+				EdgeEnds.Remove(Edge);
+			}
+			else if (Op == 7 && Vertices.Num() > 2)
+			{
+				const int32 V = Vertices[Rand.RandRange(0, Vertices.Num() - 1)];
+				Graph.RemoveVertex(V);
+				Vertices.Remove(V);
+				Sources.Remove(V);
+				for (auto It = EdgeEnds.CreateIterator(); It; ++It)
+				{
+					if (It.Value().Key == V || It.Value().Value == V) It.RemoveCurrent();
+				}
+			}
+			else if (Op == 8)
+			{
+				Vertices.Add(Graph.AddVertex());
+			}
+			else
+			{
+				const int32 V = Vertices[Rand.RandRange(0, Vertices.Num() - 1)];
+				const bool bSource = Rand.RandRange(0, 1) == 1;
+				Graph.SetSource(V, bSource);
+				if (bSource) Sources.Add(V); else Sources.Remove(V);
+			}
+
+			// Reference components.
+			TMap<int32, int32> Label;
+			int32 NumLabels = 0;
+			for (int32 Seed : Vertices)
+			{
+				if (Label.Contains(Seed)) continue;
+				TArray<int32> Open = { Seed };
+				Label.Add(Seed, NumLabels);
+				while (Open.Num() > 0)
+				{
+					const int32 V = Open.Pop();
+					for (const TPair<int32, TPair<int32, int32>>& E : EdgeEnds)
+					{
+						const int32 U = E.Value.Key == V ? E.Value.Value : (E.Value.Value == V ? E.Value.Key : INDEX_NONE);
+						if (U != INDEX_NONE && !Label.Contains(U))
+						{
+							Label.Add(U, NumLabels);
+							Open.Add(U);
+						}
+					}
+				}
+				++NumLabels;
+			}
+
+			REQUIRE(Graph.NumComponents() == NumLabels);
+			REQUIRE(Graph.NumEdges() == EdgeEnds.Num());
+			for (int32 A : Vertices)
+			{
+				bool bPowered = false;
+				int32 Members = 0;
+				for (int32 B : Vertices)
+				{
+					const bool bSame = Label[A] == Label[B];
+					REQUIRE(Graph.AreConnected(A, B) == bSame);
+					Members += bSame ? 1 : 0;
+					bPowered |= bSame && Sources.Contains(B);
+				}
+				REQUIRE(Graph.IsPowered(A) == bPowered);
+
+				TArray<int32> Component;
+				Graph.GetComponent(A, Component);
+				REQUIRE(Component.Num() == Members);
+			}
+		}
+	}
+}
+
+// ============================
+// Microbenchmarks (hidden: run with "[bench]")
+// ============================
+
+TEST_CASE("PowerLine::Core::Bench", "[.][bench]")
+{
+	PowerLineCore::FBenchParams Params;
+	PowerLineCore::RunBench(Params, [](const TCHAR* Name, double Value) {
+		FPlatformMisc::LocalPrint(*FString::Printf(TEXT("  %-32s %12.3f\n"), Name, Value));
+		const double Max = PowerLineCore::GetDefaultMax(Name);
+		CHECK((Max < 0.0 || Value <= Max));
+		});
+}
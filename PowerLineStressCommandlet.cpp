@@ -0,0 +1,627 @@
+#include "PowerLineStressCommandlet.h"
+
+#include "PowerLineSystem.h"
+#include "PowerLineCore.h"
+#include "PowerLineCoreBench.h"
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Engine/StaticMesh.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "RenderingThread.h"
+#include "UObject/StrongObjectPtr.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogPowerLineStress, Log, All);
+
+// ============================
+// Helpers (local)
+// ============================
+
+namespace PowerLineStress
+{
+	struct FSettings
+	{
+		int32 Seed = 1;
+		int32 Poles = 2000;
+		int32 WiresPerPole = 4;
+		int32 Districts = 4;
+		float HangingRatio = 0.05f;
+		int32 Moving = 20;          // Poles moving every frame (cranes/trams)
+		int32 Frames = 30;          // Incremental frames
+		int32 TouchPerFrame = 20;   // Static poles nudged per incremental frame
+		int32 Migrating = 100;      // Poles moved across a chunk border
+		int32 Churning = 100;       // Poles swapping mesh (HISM churn)
+		int32 Rays = 1000000;       // Wire query phase
+		float PoleSpacingCm = 3000.f;
+		bool bShapeCache = true;
+		bool bAdaptive = false;
+		bool bHeadless = false;     // Measure the dedicated-server path
+		FString OutDir;
+
+		void Parse(const TCHAR* Params)
+		{
+			FParse::Value(Params, TEXT("Seed="), Seed);
+			FParse::Value(Params, TEXT("Poles="), Poles);
+			FParse::Value(Params, TEXT("WiresPerPole="), WiresPerPole);
+			FParse::Value(Params, TEXT("Districts="), Districts);
+			FParse::Value(Params, TEXT("HangingRatio="), HangingRatio);
+			FParse::Value(Params, TEXT("Moving="), Moving);
+			FParse::Value(Params, TEXT("Frames="), Frames);
+			FParse::Value(Params, TEXT("TouchPerFrame="), TouchPerFrame);
+			FParse::Value(Params, TEXT("Migrating="), Migrating);
+			FParse::Value(Params, TEXT("Churning="), Churning);
+			FParse::Value(Params, TEXT("Rays="), Rays);
+			FParse::Value(Params, TEXT("PoleSpacing="), PoleSpacingCm);
+			FParse::Bool(Params, TEXT("ShapeCache="), bShapeCache);
+			FParse::Bool(Params, TEXT("Adaptive="), bAdaptive);
+			bHeadless = FParse::Param(Params, TEXT("Headless"));
+
+			if (!FParse::Value(Params, TEXT("Out="), OutDir))
+			{
+				OutDir = FPaths::ProjectSavedDir() / TEXT("PowerLineStress");
+			}
+
+			Poles = FMath::Max(2, Poles);
+			WiresPerPole = FMath::Max(1, WiresPerPole);
+			Districts = FMath::Max(0, Districts);
+			Moving = FMath::Clamp(Moving, 0, Poles);
+			Frames = FMath::Max(1, Frames);
+			Rays = FMath::Max(0, Rays);
+		}
+	};
+
+	struct FMetric
+	{
+		FString Name;
+		double Value = 0.0;
+		double Threshold = -1.0;    // -Max<Metric>=, < 0: not gated (costs: higher is a regression)
+		double MinThreshold = -1.0; // -Min<Metric>=, < 0: not gated (speedups, ratios: lower is a regression)
+
+		bool Passes() const
+		{
+			return (Threshold < 0.0 || Value <= Threshold) && (MinThreshold < 0.0 || Value >= MinThreshold);
+		}
+	};
+
+	struct FScene
+	{
+		TArray<APowerLine_Pole*> Poles;
+		TArray<int32> MovingIdx;
+		TArray<int32> StaticIdx;
+		TArray<FVector> BaseLocations;
+		TArray<APowerLineDistrictDataManager*> Districts;
+		FVector Extent = FVector::ZeroVector;
+	};
+
+	static double TickMs(UPowerLineSubsystem* Sub)
+	{
+		// Frame counter drives per-frame motion bookkeeping (no engine loop in a commandlet).
+		++GFrameCounter;
+
+		const double T0 = FPlatformTime::Seconds();
+		Sub->Tick(1.f / 60.f);
+		FlushRenderingCommands();
+		return (FPlatformTime::Seconds() - T0) * 1000.0;
+	}
+
+	static void GenerateScene(UWorld* World, const FSettings& S, UStaticMesh* PoleMesh, UStaticMesh* HangingMesh, FScene& Out)
+	{
+		FRandomStream Rand(S.Seed);
+
+		const int32 Side = FMath::CeilToInt(FMath::Sqrt((float)S.Poles));
+		const float Jitter = S.PoleSpacingCm * 0.1f;
+		const FVector Extent(Side * S.PoleSpacingCm, Side * S.PoleSpacingCm, 0.f);
+		Out.Extent = Extent;
+
+		// Districts: vertical strips with their own sag/segments/hanging settings.
+		for (int32 d = 0; d < S.Districts; ++d)
+		{
+			const float StripWidth = Extent.X / (float)S.Districts;
+			const FVector Center((d + 0.5f) * StripWidth, Extent.Y * 0.5f, 0.f);
+
+			FActorSpawnParameters P;
+			P.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+			APowerLineDistrictDataManager* DM = World->SpawnActor<APowerLineDistrictDataManager>(
+				APowerLineDistrictDataManager::StaticClass(), Center, FRotator::ZeroRotator, P);
+			if (!DM) continue;
+
+			Out.Districts.Add(DM);
+			DM->DistrictId = FName(*FString::Printf(TEXT("Stress%d"), d));
+			DM->bUseArea = true;
+			DM->AreaShape = EPowerLineDistrictAreaShape::Box;
+			DM->BoxExtentCm = FVector(StripWidth * 0.5f, Extent.Y * 0.5f + S.PoleSpacingCm, 100000.f);
+			DM->Sag.SagRangeCm = FVector2D(Rand.FRandRange(20.f, 60.f), Rand.FRandRange(80.f, 160.f));
+			DM->Sag.Seed = Rand.RandHelper(MAX_int32);
+			DM->Segments.TargetSegmentLengthCm = Rand.FRandRange(100.f, 300.f);
+			DM->Hanging.ChancePerWire = S.HangingRatio;
+			DM->Hanging.Seed = Rand.RandHelper(MAX_int32);
+			if (HangingMesh)
+			{
+				DM->Hanging.MeshPool.Add(HangingMesh);
+			}
+		}
+
+		// Poles on a jittered grid, each row chained through DefaultTargetActor.
+		Out.Poles.Reserve(S.Poles);
+		for (int32 i = 0; i < S.Poles; ++i)
+		{
+			const FVector Loc(
+				(i % Side) * S.PoleSpacingCm + Rand.FRandRange(-Jitter, Jitter),
+				(i / Side) * S.PoleSpacingCm + Rand.FRandRange(-Jitter, Jitter),
+				Rand.FRandRange(0.f, 200.f));
+
+			FActorSpawnParameters P;
+			P.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+			APowerLine_Pole* Pole = World->SpawnActor<APowerLine_Pole>(APowerLine_Pole::StaticClass(), Loc, FRotator::ZeroRotator, P);
+			check(Pole);
+			Out.Poles.Add(Pole);
+			Out.BaseLocations.Add(Loc);
+		}
+
+		for (int32 i = 0; i < Out.Poles.Num(); ++i)
+		{
+			const bool bRowEnd = ((i + 1) % Side) == 0 || (i + 1) >= Out.Poles.Num();
+			Out.Poles[i]->DefaultTargetActor = bRowEnd ? nullptr : Out.Poles[i + 1];
+		}
+
+		// Components after targets exist (wires bind to target transforms on register).
+		for (APowerLine_Pole* Pole : Out.Poles)
+		{
+			USceneComponent* Root = Pole->GetRootComponent();
+
+			UPowerLinePoleComponent* PoleComp = NewObject<UPowerLinePoleComponent>(Pole, TEXT("StressPole"));
+			PoleComp->PoleMesh = PoleMesh;
+			PoleComp->SetupAttachment(Root);
+			PoleComp->RegisterComponent();
+			Pole->AddInstanceComponent(PoleComp);
+
+			for (int32 k = 0; k < S.WiresPerPole; ++k)
+			{
+				UPowerLineComponent* Wire = NewObject<UPowerLineComponent>(Pole, FName(*FString::Printf(TEXT("StressWire%d"), k)));
+				Wire->AttachId = FName(*FString::Printf(TEXT("W%d"), k));
+				Wire->LineId = k;
+				Wire->SetupAttachment(Root);
+				Wire->SetRelativeLocation(FVector(0.f, (k - (S.WiresPerPole - 1) * 0.5f) * 60.f, 900.f));
+				Wire->RegisterComponent();
+				Pole->AddInstanceComponent(Wire);
+			}
+		}
+
+		// Moving subset (deterministic from seed).
+		TArray<int32> Order;
+		Order.Reserve(Out.Poles.Num());
+		for (int32 i = 0; i < Out.Poles.Num(); ++i)
+		{
+			Order.Add(i);
+		}
+		for (int32 i = Order.Num() - 1; i > 0; --i)
+		{
+			Order.Swap(i, Rand.RandRange(0, i));
+		}
+
+		for (int32 i = 0; i < Order.Num(); ++i)
+		{
+			(i < S.Moving ? Out.MovingIdx : Out.StaticIdx).Add(Order[i]);
+		}
+	}
+
+	static FString ToCsv(const TArray<FMetric>& Metrics)
+	{
+		// MinThreshold appended last so existing column consumers keep working.
+		FString Csv = TEXT("Metric,Value,Threshold,Result,MinThreshold\n");
+		for (const FMetric& M : Metrics)
+		{
+			Csv += FString::Printf(TEXT("%s,%.4f,%s,%s,%s\n"),
+				*M.Name, M.Value,
+				M.Threshold < 0.0 ? TEXT("") : *FString::Printf(TEXT("%.4f"), M.Threshold),
+				M.Passes() ? TEXT("pass") : TEXT("FAIL"),
+				M.MinThreshold < 0.0 ? TEXT("") : *FString::Printf(TEXT("%.4f"), M.MinThreshold));
+		}
+		return Csv;
+	}
+
+	static FString ToJson(const FSettings& S, const TArray<FMetric>& Metrics, bool bPassed)
+	{
+		FString Json = TEXT("{\n");
+		Json += FString::Printf(TEXT("  \"seed\": %d,\n"), S.Seed);
+		Json += FString::Printf(TEXT("  \"params\": { \"poles\": %d, \"wires_per_pole\": %d, \"districts\": %d, \"hanging_ratio\": %.4f, \"moving\": %d, \"frames\": %d, \"shape_cache\": %s, \"adaptive\": %s, \"headless\": %s },\n"),
+			S.Poles, S.WiresPerPole, S.Districts, S.HangingRatio, S.Moving, S.Frames,
+			S.bShapeCache ? TEXT("true") : TEXT("false"), S.bAdaptive ? TEXT("true") : TEXT("false"),
+			S.bHeadless ? TEXT("true") : TEXT("false"));
+		Json += TEXT("  \"metrics\": {\n");
+		for (int32 i = 0; i < Metrics.Num(); ++i)
+		{
+			const FMetric& M = Metrics[i];
+			Json += FString::Printf(TEXT("    \"%s\": { \"value\": %.4f, \"threshold\": %s, \"min_threshold\": %s, \"pass\": %s }%s\n"),
+				*M.Name, M.Value,
+				M.Threshold < 0.0 ? TEXT("null") : *FString::Printf(TEXT("%.4f"), M.Threshold),
+				M.MinThreshold < 0.0 ? TEXT("null") : *FString::Printf(TEXT("%.4f"), M.MinThreshold),
+				M.Passes() ? TEXT("true") : TEXT("false"),
+				(i + 1 < Metrics.Num()) ? TEXT(",") : TEXT(""));
+		}
+		Json += TEXT("  },\n");
+		Json += FString::Printf(TEXT("  \"passed\": %s\n}\n"), bPassed ? TEXT("true") : TEXT("false"));
+		return Json;
+	}
+}
+
+// ============================
+// Commandlet
+// ============================
+
+UPowerLineStressCommandlet::UPowerLineStressCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+	ShowErrorCount = true;
+}
+
+int32 UPowerLineStressCommandlet::Main(const FString& Params)
+{
+	using namespace PowerLineStress;
+
+	FSettings S;
+	S.Parse(*Params);
+
+	UE_LOG(LogPowerLineStress, Display, TEXT("PowerLine stress: seed=%d poles=%d wires/pole=%d districts=%d hanging=%.3f moving=%d"),
+		S.Seed, S.Poles, S.WiresPerPole, S.Districts, S.HangingRatio, S.Moving);
+
+	TArray<FMetric> Metrics;
+	auto AddMetric = [&](const TCHAR* Name, double Value) {
+		FMetric& M = Metrics.AddDefaulted_GetRef();
+		M.Name = Name;
+		M.Value = Value;
+		M.Threshold = PowerLineCore::GetDefaultMax(Name);
+		FParse::Value(*Params, *FString::Printf(TEXT("Max%s="), Name), M.Threshold);
+		FParse::Value(*Params, *FString::Printf(TEXT("Min%s="), Name), M.MinThreshold);
+		};
+
+	auto Report = [&](const TCHAR* Prefix) {
+		bool bPassed = true;
+		for (const FMetric& M : Metrics)
+		{
+			if (!M.Passes())
+			{
+				bPassed = false;
+				if (M.Threshold >= 0.0 && M.Value > M.Threshold)
+				{
+					UE_LOG(LogPowerLineStress, Error, TEXT("Regression: %s = %.3f exceeds %.3f"), *M.Name, M.Value, M.Threshold);
+				}
+				else
+				{
+					UE_LOG(LogPowerLineStress, Error, TEXT("Regression: %s = %.3f below %.3f"), *M.Name, M.Value, M.MinThreshold);
+				}
+			}
+			else
+			{
+				UE_LOG(LogPowerLineStress, Display, TEXT("  %-24s %12.3f"), *M.Name, M.Value);
+			}
+		}
+
+		const FString BaseName = S.OutDir / FString::Printf(TEXT("%s_Seed%d"), Prefix, S.Seed);
+		FFileHelper::SaveStringToFile(ToCsv(Metrics), *(BaseName + TEXT(".csv")));
+		FFileHelper::SaveStringToFile(ToJson(S, Metrics, bPassed), *(BaseName + TEXT(".json")));
+		UE_LOG(LogPowerLineStress, Display, TEXT("Results written to %s.{csv,json}"), *BaseName);
+		return bPassed;
+		};
+
+	if (FParse::Param(*Params, TEXT("CoreBench")))
+	{
+		PowerLineCore::FBenchParams Bench;
+		Bench.Seed = S.Seed;
+		Bench.Poles = S.Poles;
+		Bench.WiresPerPole = S.WiresPerPole;
+		Bench.HangingRatio = S.HangingRatio;
+		Bench.PoleSpacingCm = S.PoleSpacingCm;
+		PowerLineCore::RunBench(Bench, AddMetric);
+		return Report(TEXT("PowerLineCoreBench")) ? 0 : 1;
+	}
+
+	// Engine meshes, loaded up front so streaming is not part of the measurements.
+	TStrongObjectPtr<UStaticMesh> MeshA(LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cylinder.Cylinder")));
+	TStrongObjectPtr<UStaticMesh> MeshB(LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube")));
+
+	const uint64 UsedBefore = FPlatformMemory::GetStats().UsedPhysical;
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, FName(TEXT("PowerLineStressWorld")));
+	FWorldContext& Context = GEngine->CreateNewWorldContext(EWorldType::Game);
+	Context.SetCurrentWorld(World);
+	World->InitializeActorsForPlay(FURL());
+	World->BeginPlay();
+
+	UPowerLineSubsystem* Sub = World->GetSubsystem<UPowerLineSubsystem>();
+	if (!Sub)
+	{
+		UE_LOG(LogPowerLineStress, Error, TEXT("PowerLine subsystem was not created for the stress world."));
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+		return 1;
+	}
+
+	// Commandlets can never render, so Auto would measure the headless server path.
+	Sub->HeadlessMode = S.bHeadless ? EPowerLineHeadlessMode::Always : EPowerLineHeadlessMode::Never;
+	Sub->bUseShapeCache = S.bShapeCache;
+	Sub->bAdaptiveChunking = S.bAdaptive;
+
+	FRandomStream Rand(S.Seed ^ 0x5EED);
+	FScene Scene;
+
+	// 1) Generation + cold build
+	{
+		const double T0 = FPlatformTime::Seconds();
+		GenerateScene(World, S, MeshA.Get(), MeshB.Get(), Scene);
+		AddMetric(TEXT("GenerateMs"), (FPlatformTime::Seconds() - T0) * 1000.0);
+		AddMetric(TEXT("ColdBuildMs"), TickMs(Sub));
+	}
+
+	// 2) Incremental: a few static poles nudged + moving actors every frame
+	{
+		double Sum = 0.0;
+		double Max = 0.0;
+		for (int32 f = 0; f < S.Frames; ++f)
+		{
+			for (int32 i = 0; i < S.TouchPerFrame && Scene.StaticIdx.Num() > 0; ++i)
+			{
+				const int32 Idx = Scene.StaticIdx[Rand.RandRange(0, Scene.StaticIdx.Num() - 1)];
+				const FVector Offset(0.f, 0.f, (f & 1) ? 5.f : 0.f);
+				Scene.Poles[Idx]->SetActorLocation(Scene.BaseLocations[Idx] + Offset);
+			}
+
+			for (int32 Idx : Scene.MovingIdx)
+			{
+				const float Phase = (float)f * 0.2f + (float)Idx;
+				Scene.Poles[Idx]->SetActorLocation(Scene.BaseLocations[Idx] + FVector(FMath::Sin(Phase) * 50.f, 0.f, 0.f));
+			}
+
+			const double Ms = TickMs(Sub);
+			Sum += Ms;
+			Max = FMath::Max(Max, Ms);
+		}
+
+		AddMetric(TEXT("IncrementalAvgMs"), Sum / (double)S.Frames);
+		AddMetric(TEXT("IncrementalMaxMs"), Max);
+		AddMetric(TEXT("DynamicWires"), Sub->GetNumDynamicLines());
+	}
+
+	// 3) Chunk migration: move poles across a chunk border and back
+	{
+		TArray<int32> Picked;
+		for (int32 i = 0; i < S.Migrating && Scene.StaticIdx.Num() > 0; ++i)
+		{
+			Picked.Add(Scene.StaticIdx[Rand.RandRange(0, Scene.StaticIdx.Num() - 1)]);
+		}
+
+		for (int32 Idx : Picked)
+		{
+			Scene.Poles[Idx]->SetActorLocation(Scene.BaseLocations[Idx] + FVector(Sub->ChunkSize, 0.f, 0.f));
+		}
+		const double Out = TickMs(Sub);
+
+		for (int32 Idx : Picked)
+		{
+			Scene.Poles[Idx]->SetActorLocation(Scene.BaseLocations[Idx]);
+		}
+		const double Back = TickMs(Sub);
+
+		AddMetric(TEXT("MigrationMs"), (Out + Back) * 0.5);
+	}
+
+	// 4) Pole HISM churn: swap meshes on a subset
+	{
+		TArray<UPowerLinePoleComponent*> Picked;
+		for (int32 i = 0; i < S.Churning && Scene.Poles.Num() > 0; ++i)
+		{
+			APowerLine_Pole* Pole = Scene.Poles[Rand.RandRange(0, Scene.Poles.Num() - 1)];
+			if (UPowerLinePoleComponent* PoleComp = Pole->FindComponentByClass<UPowerLinePoleComponent>())
+			{
+				Picked.Add(PoleComp);
+			}
+		}
+
+		for (UPowerLinePoleComponent* PoleComp : Picked)
+		{
+			PoleComp->PoleMesh = (PoleComp->PoleMesh.Get() == MeshA.Get()) ? MeshB.Get() : MeshA.Get();
+			PoleComp->MarkDirty();
+		}
+		AddMetric(TEXT("PoleChurnMs"), TickMs(Sub));
+	}
+
+	// 4b) District sag animation: in-place rescale vs. the full district refresh it replaces
+	if (Scene.Districts.Num() > 0)
+	{
+		APowerLineDistrictDataManager* DM = Scene.Districts[0];
+
+		double T0 = FPlatformTime::Seconds();
+		DM->SetSagScale(DM->Sag.SagScale * 1.25f);
+		AddMetric(TEXT("SagRescaleMs"), (FPlatformTime::Seconds() - T0) * 1000.0 + TickMs(Sub));
+
+		T0 = FPlatformTime::Seconds();
+		DM->Sag.SagScale /= 1.25f;
+		DM->MarkAllDistrictWiresDirty();
+		AddMetric(TEXT("SagRebuildMs"), (FPlatformTime::Seconds() - T0) * 1000.0 + TickMs(Sub));
+	}
+
+	// 4c) Grid state styling: point a circuit at a runtime style, then change the style (palette update only)
+	{
+		TArray<UPowerLineComponent*> Circuit;
+		TArray<UPowerLineComponent*> PoleWires;
+		for (int32 i = 0; i < S.Churning && Scene.Poles.Num() > 0; ++i)
+		{
+			Scene.Poles[Rand.RandRange(0, Scene.Poles.Num() - 1)]->GetComponents(PoleWires);
+			Circuit.Append(PoleWires);
+		}
+
+		const int32 Powered = Sub->CreateLineStyle(FColor::Yellow, 3.f);
+
+		double T0 = FPlatformTime::Seconds();
+		for (UPowerLineComponent* Line : Circuit)
+		{
+			Sub->SetWireStyle(Line, Powered);
+		}
+		AddMetric(TEXT("WireStyleMs"), (FPlatformTime::Seconds() - T0) * 1000.0 + TickMs(Sub));
+
+		T0 = FPlatformTime::Seconds();
+		Sub->SetLineStyle(Powered, FColor::Red, 3.f);
+		AddMetric(TEXT("PaletteStyleUs"), (FPlatformTime::Seconds() - T0) * 1000000.0);
+
+		for (UPowerLineComponent* Line : Circuit)
+		{
+			Sub->SetWireStyle(Line, INDEX_NONE);
+		}
+		Sub->ReleaseLineStyle(Powered);
+		TickMs(Sub);
+	}
+
+	// 5) Memory
+	{
+		const FPowerLineMemoryStats Mem = Sub->GetMemoryStats();
+		AddMetric(TEXT("MemoryKB"), (double)Mem.GetTotal() / 1024.0);
+		AddMetric(TEXT("RenderMemoryKB"), (double)Mem.Render / 1024.0);
+
+		const uint64 UsedAfter = FPlatformMemory::GetStats().UsedPhysical;
+		AddMetric(TEXT("ProcessDeltaMB"), (double)((int64)UsedAfter - (int64)UsedBefore) / (1024.0 * 1024.0));
+
+		// Over every static wire built, not just the cache lookups: district wires with randomized sag (all of
+		// them in this scene with -Districts > 0), bundles and broken wires bypass the cache and count as misses.
+		int64 Hits = 0;
+		int64 Misses = 0;
+		int64 Bypassed = 0;
+		int32 Entries = 0;
+		Sub->GetShapeCacheStats(Hits, Misses, Bypassed, Entries);
+		const int64 Built = Hits + Misses + Bypassed;
+		AddMetric(TEXT("ShapeCacheHitRatio"), Built > 0 ? (double)Hits / (double)Built : 0.0);
+		AddMetric(TEXT("ShapeCacheBypassRatio"), Built > 0 ? (double)Bypassed / (double)Built : 0.0);
+
+		int32 Live = 0;
+		int32 Pooled = 0;
+		int32 Empty = 0;
+		Sub->GetChunkStats(Live, Pooled, Empty);
+		AddMetric(TEXT("LiveChunks"), Live);
+	}
+
+	// 6) Wire queries: horizontal rays at wire height, single thread and across workers
+	if (S.Rays > 0)
+	{
+		FRandomStream Rand(S.Seed + 3);
+		TArray<FVector> Starts;
+		TArray<FVector> Ends;
+		Starts.SetNum(S.Rays);
+		Ends.SetNum(S.Rays);
+		for (int32 i = 0; i < S.Rays; ++i)
+		{
+			Starts[i] = FVector(Rand.FRandRange(0.f, Scene.Extent.X), Rand.FRandRange(0.f, Scene.Extent.Y), Rand.FRandRange(600.f, 1000.f));
+			const FVector Dir = FVector(Rand.GetUnitVector() * FVector(1.f, 1.f, 0.1f)).GetSafeNormal();
+			Ends[i] = Starts[i] + Dir * 5000.f;
+		}
+
+		int32 Hits = 0;
+		const double SingleMs = PowerLineCore::BestOfMs(1, [&]() {
+			Hits = 0;
+			FPowerLineWireHit Hit;
+			for (int32 i = 0; i < S.Rays; ++i)
+			{
+				Hits += Sub->RaycastWires(Starts[i], Ends[i], Hit) ? 1 : 0;
+			}
+			});
+
+		const int32 Batches = FMath::Max(1, FTaskGraphInterface::Get().GetNumWorkerThreads() + 1);
+		const double ParallelMs = PowerLineCore::BestOfMs(1, [&]() {
+			ParallelFor(Batches, [&](int32 Batch) {
+				FPowerLineWireHit Hit;
+				const int32 Begin = (int32)((int64)S.Rays * Batch / Batches);
+				const int32 End = (int32)((int64)S.Rays * (Batch + 1) / Batches);
+				for (int32 i = Begin; i < End; ++i)
+				{
+					Sub->RaycastWires(Starts[i], Ends[i], Hit);
+				}
+				});
+			});
+
+		AddMetric(TEXT("QueryNsPerRay"), SingleMs * 1e6 / (double)S.Rays);
+		AddMetric(TEXT("QueryMRaysPerSec"), SingleMs > 0.0 ? (double)S.Rays / (SingleMs * 1000.0) : 0.0);
+		AddMetric(*FString::Printf(TEXT("QueryMRaysPerSec%dThreads"), Batches), ParallelMs > 0.0 ? (double)S.Rays / (ParallelMs * 1000.0) : 0.0);
+		AddMetric(TEXT("QueryHitRatio"), (double)Hits / (double)S.Rays);
+
+		// Nearest / radius on one snapshot (how AI and tool tasks use it), a tenth of the ray count.
+		const FPowerLineQuerySnapshotPtr Snapshot = Sub->GetQuerySnapshot();
+		const int32 NumPoints = FMath::Max(1, S.Rays / 10);
+		if (Snapshot)
+		{
+			FPowerLineWireHit Hit;
+			const double NearestMs = PowerLineCore::BestOfMs(1, [&]() {
+				for (int32 i = 0; i < NumPoints; ++i)
+				{
+					Snapshot->FindNearest(Starts[i], 0.f, Hit);
+				}
+				});
+
+			TArray<FPowerLineWireHit> InRadius;
+			int64 Found = 0;
+			const double RadiusMs = PowerLineCore::BestOfMs(1, [&]() {
+				Found = 0;
+				for (int32 i = 0; i < NumPoints; ++i)
+				{
+					InRadius.Reset();
+					Found += Snapshot->FindInRadius(Starts[i], 1000.f, InRadius);
+				}
+				});
+
+			AddMetric(TEXT("QueryNearestNs"), NearestMs * 1e6 / (double)NumPoints);
+			AddMetric(TEXT("QueryRadiusNs"), RadiusMs * 1e6 / (double)NumPoints);
+			AddMetric(TEXT("QueryRadiusAvgWires"), (double)Found / (double)NumPoints);
+			AddMetric(TEXT("QuerySnapshotBuildMs"), Snapshot->BuildMs);
+		}
+
+		AddMetric(TEXT("QueryMemoryKB"), (double)Sub->GetMemoryStats().Queries / 1024.0);
+	}
+
+	// 7) Cable simulation: impulses in the middle of the scene, solver cost at the full particle budget
+	if (!S.bHeadless && S.Rays > 0)
+	{
+		Sub->bEnableCableSimulation = true;
+		Sub->SimulationCameraRadius = 0.f; // No views in a commandlet
+
+		const FVector Center(Scene.Extent.X * 0.5f, Scene.Extent.Y * 0.5f, 900.f);
+		Sub->AddCableImpulse(Center, S.PoleSpacingCm * 4.f, FVector(0.f, 800.f, 300.f));
+		TickMs(Sub);
+
+		double SolveSum = 0.0;
+		double SolveMax = 0.0;
+		for (int32 f = 0; f < S.Frames; ++f)
+		{
+			TickMs(Sub);
+
+			int32 Wires = 0;
+			int32 Particles = 0;
+			float SolveMs = 0.f;
+			Sub->GetCableSimStats(Wires, Particles, SolveMs);
+			SolveSum += SolveMs;
+			SolveMax = FMath::Max(SolveMax, (double)SolveMs);
+		}
+
+		int32 Wires = 0;
+		int32 Particles = 0;
+		float SolveMs = 0.f;
+		Sub->GetCableSimStats(Wires, Particles, SolveMs);
+		AddMetric(TEXT("SimWires"), Wires);
+		AddMetric(TEXT("SimParticles"), Particles);
+		AddMetric(TEXT("SimSolveAvgMs"), SolveSum / (double)S.Frames);
+		AddMetric(TEXT("SimSolveMaxMs"), SolveMax);
+
+		Sub->bEnableCableSimulation = false;
+		TickMs(Sub);
+	}
+
+	const bool bPassed = Report(S.bHeadless ? TEXT("PowerLineStressHeadless") : TEXT("PowerLineStress"));
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+	return bPassed ? 0 : 1;
+}
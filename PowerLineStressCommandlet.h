@@ -0,0 +1,35 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "PowerLineStressCommandlet.generated.h"
+
+// ============================
+// Stress / regression commandlet
+// Generates a reproducible power-line world from a seed, measures build phases and memory,
+// writes CSV + JSON and returns non-zero when a threshold is exceeded (CI gate, works with -nullrhi).
+//
+// UnrealEditor-Cmd <Project> -run=PowerLineStress -nullrhi -unattended
+//     -Seed=7 -Poles=5000 -WiresPerPole=4 -Districts=4 -HangingRatio=0.05 -Moving=50 -Frames=30
+//     -Out=<dir> -MaxColdBuildMs=500 -MaxIncrementalAvgMs=4 -MaxMemoryKB=65536
+//     [-Headless]   (dedicated-server path: no render data; default measures the render path)
+//     -Rays=1000000 -MaxQueryNsPerRay=2000   (wire query phase; -Rays=0 skips it)
+//
+// Core microbenchmarks only (no world, seconds on a plain host):
+// UnrealEditor-Cmd <Project> -run=PowerLineStress -nullrhi -CoreBench -Poles=5000 -MaxCoreBuildNsPerSegment=200
+//
+// Every metric can be gated with -Max<Metric>= (costs) and/or -Min<Metric>= (speedups and ratios, e.g.
+// -MinCoreSpeedup8Threads=4 -MinCoreBundle4Speedup=1.5). The 200k-span graph cuts are gated by default
+// (-MaxCoreGraphChainMidCutUs=50); passing the flag overrides it.
+// ============================
+
+UCLASS()
+class PROGRAMM_API UPowerLineStressCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UPowerLineStressCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -1,10 +1,75 @@
 #include "PowerLineSystem.h"
 
 #include "Engine/World.h"
+#include "Misc/App.h"
+#include "Engine/StaticMesh.h"
+#include "Components/SplineComponent.h"
+#include "WorldCollision.h"
+#include "Engine/NetDriver.h"
+#include "Net/UnrealNetwork.h"
 #include "GameFramework/Actor.h"
 #include "SceneManagement.h"
 #include "EngineUtils.h"            // TActorIterator
 #include "UObject/UObjectIterator.h" // TObjectIterator
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Trace/Trace.inl"
+#include "HAL/LowLevelMemTracker.h"
+#include "HAL/IConsoleManager.h"
+#include "DrawDebugHelpers.h"
+#include "Async/ParallelFor.h"
+#include "Algo/Sort.h"
+#include "Engine/Engine.h"
+
+// ============================
+// Stats / Insights
+// ============================
+
+DECLARE_CYCLE_STAT(TEXT("Tick"), STAT_PowerLine_Tick, STATGROUP_PowerLine);
+DECLARE_CYCLE_STAT(TEXT("Rebuild Chunks"), STAT_PowerLine_RebuildChunks, STATGROUP_PowerLine);
+DECLARE_CYCLE_STAT(TEXT("Update Dynamic Wires"), STAT_PowerLine_UpdateDynamic, STATGROUP_PowerLine);
+DECLARE_CYCLE_STAT(TEXT("ResolveEndPoint"), STAT_PowerLine_ResolveEndPoint, STATGROUP_PowerLine);
+DECLARE_CYCLE_STAT(TEXT("ResolveDistrictManager"), STAT_PowerLine_ResolveDistrictManager, STATGROUP_PowerLine);
+DECLARE_CYCLE_STAT(TEXT("UpdateHangingForLine"), STAT_PowerLine_UpdateHanging, STATGROUP_PowerLine);
+DECLARE_CYCLE_STAT(TEXT("Pole HISM Update"), STAT_PowerLine_PoleUpdate, STATGROUP_PowerLine);
+DECLARE_CYCLE_STAT(TEXT("Proxy Update (GT)"), STAT_PowerLine_ProxyUpdate, STATGROUP_PowerLine);
+DECLARE_CYCLE_STAT(TEXT("Proxy Update (RT)"), STAT_PowerLine_ProxyUpdateRT, STATGROUP_PowerLine);
+DECLARE_CYCLE_STAT(TEXT("Update Wire Queries"), STAT_PowerLine_UpdateQueries, STATGROUP_PowerLine);
+DECLARE_CYCLE_STAT(TEXT("Cable Simulation"), STAT_PowerLine_CableSim, STATGROUP_PowerLine);
+DECLARE_CYCLE_STAT(TEXT("Rescale Sag"), STAT_PowerLine_RescaleSag, STATGROUP_PowerLine);
+DECLARE_CYCLE_STAT(TEXT("Auto Wire"), STAT_PowerLine_AutoWire, STATGROUP_PowerLine);
+DECLARE_CYCLE_STAT(TEXT("Spline Layout"), STAT_PowerLine_SplineLayout, STATGROUP_PowerLine);
+DECLARE_CYCLE_STAT(TEXT("Break Wire"), STAT_PowerLine_BreakWire, STATGROUP_PowerLine);
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Dirty Chunks"), STAT_PowerLine_DirtyChunks, STATGROUP_PowerLine);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Wires Rebuilt"), STAT_PowerLine_WiresRebuilt, STATGROUP_PowerLine);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Segments Submitted"), STAT_PowerLine_SegmentsSubmitted, STATGROUP_PowerLine);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Bytes Uploaded"), STAT_PowerLine_BytesUploaded, STATGROUP_PowerLine);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Simulated Wires"), STAT_PowerLine_SimWires, STATGROUP_PowerLine);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Simulated Particles"), STAT_PowerLine_SimParticles, STATGROUP_PowerLine);
+
+UE_TRACE_CHANNEL_DEFINE(PowerLineChannel);
+
+DEFINE_LOG_CATEGORY_STATIC(LogPowerLine, Log, All);
+
+// LLM: PowerLine/Segments, PowerLine/Proxy, PowerLine/Poles, PowerLine/Hanging, PowerLine/Chunks, PowerLine/Queries
+LLM_DEFINE_TAG(PowerLine);
+LLM_DEFINE_TAG(PowerLine_Segments, TEXT("Segments"), TEXT("PowerLine"));
+LLM_DEFINE_TAG(PowerLine_Proxy, TEXT("Proxy"), TEXT("PowerLine"));
+LLM_DEFINE_TAG(PowerLine_Poles, TEXT("Poles"), TEXT("PowerLine"));
+LLM_DEFINE_TAG(PowerLine_Hanging, TEXT("Hanging"), TEXT("PowerLine"));
+LLM_DEFINE_TAG(PowerLine_Chunks, TEXT("Chunks"), TEXT("PowerLine"));
+LLM_DEFINE_TAG(PowerLine_Queries, TEXT("Queries"), TEXT("PowerLine"));
+
+// Cycle stat + Insights scope on the PowerLine channel (STAT_<Name> must be declared above).
+#define POWERLINE_SCOPE(Name) \
+	SCOPE_CYCLE_COUNTER(STAT_##Name); \
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(Name, PowerLineChannel)
+
+static UPowerLineSubsystem* GetPowerLineSubsystem(const UObject* WorldContext)
+{
+	UWorld* World = WorldContext ? WorldContext->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UPowerLineSubsystem>() : nullptr;
+}
 
 // ============================
 // District Data Manager
@@ -41,55 +106,34 @@ APowerLineDistrictDataManager::APowerLineDistrictDataManager()
 
 uint32 APowerLineDistrictDataManager::HashLine(const FVector& A, const FVector& B, int32 LineId)
 {
-	// Quantize to reduce jitter when actors move by tiny amounts (also keeps hash stable in editor).
-	auto Q = [](const FVector& V) {
-		// 1 cm precision
-		return FIntVector(
-			FMath::RoundToInt(V.X),
-			FMath::RoundToInt(V.Y),
-			FMath::RoundToInt(V.Z));
-		};
-
-	const FIntVector QA = Q(A);
-	const FIntVector QB = Q(B);
+	return PowerLineCore::HashLine(A, B, LineId);
+}
 
-	uint32 H = 0;
-	H = HashCombine(H, GetTypeHash(QA));
-	H = HashCombine(H, GetTypeHash(QB));
-	H = HashCombine(H, GetTypeHash(LineId));
-	return H;
+PowerLineCore::FDistrictParams APowerLineDistrictDataManager::GetCoreParams() const
+{
+	PowerLineCore::FDistrictParams P;
+	P.Sag.MinCm = Sag.SagRangeCm.X;
+	P.Sag.MaxCm = Sag.SagRangeCm.Y;
+	P.Sag.Scale = Sag.SagScale;
+	P.Sag.bDeterministic = Sag.bDeterministic;
+	P.Sag.Seed = Sag.Seed;
+
+	P.Segments.bAuto = Segments.bAutoSegments;
+	P.Segments.TargetLengthCm = Segments.TargetSegmentLengthCm;
+	P.Segments.Min = Segments.MinSegments;
+	P.Segments.Max = Segments.MaxSegments;
+	P.Segments.Fixed = Segments.FixedSegments;
+	return P;
 }
 
 float APowerLineDistrictDataManager::GetSagForLine(const FVector& StartWS, const FVector& EndWS, int32 LineId) const
 {
-	const float MinS = FMath::Min(Sag.SagRangeCm.X, Sag.SagRangeCm.Y);
-	const float MaxS = FMath::Max(Sag.SagRangeCm.X, Sag.SagRangeCm.Y);
-
-	float Value = 0.f;
-	if (Sag.bDeterministic)
-	{
-		const uint32 H = HashLine(StartWS, EndWS, LineId);
-		FRandomStream R(Sag.Seed ^ (int32)H);
-		Value = R.FRandRange(MinS, MaxS);
-	}
-	else
-	{
-		Value = FMath::FRandRange(MinS, MaxS);
-	}
-
-	return FMath::Max(0.f, Value * Sag.SagScale);
+	return PowerLineCore::ComputeSag(GetCoreParams().Sag, StartWS, EndWS, LineId);
 }
 
 int32 APowerLineDistrictDataManager::GetSegmentsForLength(float LengthCm) const
 {
-	if (!Segments.bAutoSegments)
-	{
-		return FMath::Max(1, Segments.FixedSegments);
-	}
-
-	const float Step = FMath::Max(10.f, Segments.TargetSegmentLengthCm);
-	const int32 Raw = FMath::CeilToInt(LengthCm / Step);
-	return FMath::Clamp(Raw, FMath::Max(1, Segments.MinSegments), FMath::Max(1, Segments.MaxSegments));
+	return PowerLineCore::ComputeSegments(GetCoreParams().Segments, LengthCm);
 }
 
 bool APowerLineDistrictDataManager::GetHangingForLine(
@@ -100,36 +144,45 @@ bool APowerLineDistrictDataManager::GetHangingForLine(
 	float& OutNormalizedDistance,
 	float& OutYawDeg) const
 {
+	TSoftObjectPtr<UStaticMesh> SoftMesh;
 	OutMesh = nullptr;
-	OutNormalizedDistance = 0.5f;
-	OutYawDeg = 0.f;
+	if (!GetHangingAssetForLine(StartWS, EndWS, LineId, SoftMesh, OutNormalizedDistance, OutYawDeg))
+	{
+		return false;
+	}
 
-	if (Hanging.MeshPool.Num() == 0) return false;
-	if (Hanging.ChancePerWire <= 0.f) return false;
+	OutMesh = SoftMesh.LoadSynchronous();
+	return OutMesh != nullptr;
+}
 
-	const float MinN = FMath::Clamp(FMath::Min(Hanging.NormalizedDistanceRange.X, Hanging.NormalizedDistanceRange.Y), 0.f, 1.f);
-	const float MaxN = FMath::Clamp(FMath::Max(Hanging.NormalizedDistanceRange.X, Hanging.NormalizedDistanceRange.Y), 0.f, 1.f);
-	if (MaxN <= MinN) return false;
+bool APowerLineDistrictDataManager::GetHangingAssetForLine(
+	const FVector& StartWS,
+	const FVector& EndWS,
+	int32 LineId,
+	TSoftObjectPtr<UStaticMesh>& OutMesh,
+	float& OutNormalizedDistance,
+	float& OutYawDeg) const
+{
+	OutMesh.Reset();
+	OutNormalizedDistance = 0.5f;
+	OutYawDeg = 0.f;
 
-	FRandomStream R;
-	if (Hanging.bDeterministic)
-	{
-		const uint32 H = HashLine(StartWS, EndWS, LineId);
-		R.Initialize(Hanging.Seed ^ (int32)H);
-	}
-	else
-	{
-		R.GenerateNewSeed();
-	}
+	PowerLineCore::FHangingParams P;
+	P.PoolSize = Hanging.MeshPool.Num();
+	P.Chance = Hanging.ChancePerWire;
+	P.DistanceRange = FVector2f(Hanging.NormalizedDistanceRange);
+	P.RandomYawDeg = Hanging.RandomYawDeg;
+	P.bDeterministic = Hanging.bDeterministic;
+	P.Seed = Hanging.Seed;
 
-	if (R.FRand() > Hanging.ChancePerWire) return false;
+	PowerLineCore::FHangingResult Result;
+	if (!PowerLineCore::ComputeHanging(P, StartWS, EndWS, LineId, Result)) return false;
 
-	const int32 MeshIdx = R.RandRange(0, Hanging.MeshPool.Num() - 1);
-	OutMesh = Hanging.MeshPool[MeshIdx].Get();
-	if (!OutMesh) return false;
+	OutMesh = Hanging.MeshPool[Result.MeshIndex];
+	if (OutMesh.IsNull()) return false;
 
-	OutNormalizedDistance = R.FRandRange(MinN, MaxN);
-	OutYawDeg = (Hanging.RandomYawDeg > 0.f) ? R.FRandRange(-Hanging.RandomYawDeg, Hanging.RandomYawDeg) : 0.f;
+	OutNormalizedDistance = Result.NormalizedDistance;
+	OutYawDeg = Result.YawDeg;
 	return true;
 }
 
@@ -179,6 +232,12 @@ void APowerLineDistrictDataManager::MarkAllDistrictWiresDirty()
 	UWorld* W = GetWorld();
 	if (!W) return;
 
+	// Bulk edits: one refresh per district when the batch ends.
+	if (UPowerLineSubsystem* Sub = W->GetSubsystem<UPowerLineSubsystem>())
+	{
+		if (Sub->DeferDistrictRefresh(this)) return;
+	}
+
 	for (TObjectIterator<UPowerLineComponent> It; It; ++It)
 	{
 		UPowerLineComponent* Line = *It;
@@ -197,17 +256,55 @@ void APowerLineDistrictDataManager::MarkAllDistrictWiresDirty()
 		{
 			if (bDirect || !bUseArea || AffectsWorldLocation(Line->GetComponentLocation()))
 			{
-				Line->MarkDirty();
+				Line->MarkDirtyWithCause(EPowerLineDirtyCause::District);
 			}
 		}
 	}
 }
 
+void APowerLineDistrictDataManager::SetSagScale(float NewScale)
+{
+	NewScale = FMath::Max(0.f, NewScale);
+	const float OldScale = Sag.SagScale;
+	if (OldScale == NewScale) return;
+
+	Sag.SagScale = NewScale;
+
+	UPowerLineSubsystem* Sub = GetPowerLineSubsystem(this);
+	if (!Sub || !Sub->RescaleDistrictSag(this, OldScale, NewScale))
+	{
+		MarkAllDistrictWiresDirty();
+	}
+}
+
 #if WITH_EDITOR
 void APowerLineDistrictDataManager::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
 {
+	// Multi-select edits fire once per object; collapse them into one refresh next tick.
+	if (UPowerLineSubsystem* Sub = GetPowerLineSubsystem(this))
+	{
+		Sub->BeginFrameBatchEdit();
+	}
+
 	Super::PostEditChangeProperty(PropertyChangedEvent);
 	RefreshAreaVisualization();
+
+	// Wind scale is picked up by the subsystem tick at draw time.
+	const FName PropName = PropertyChangedEvent.Property ? PropertyChangedEvent.Property->GetFName() : NAME_None;
+	if (PropName == GET_MEMBER_NAME_CHECKED(APowerLineDistrictDataManager, WindScale)) return;
+
+	MarkAllDistrictWiresDirty();
+}
+
+void APowerLineDistrictDataManager::PostEditUndo()
+{
+	if (UPowerLineSubsystem* Sub = GetPowerLineSubsystem(this))
+	{
+		Sub->BeginFrameBatchEdit();
+	}
+
+	Super::PostEditUndo();
+	RefreshAreaVisualization();
 	MarkAllDistrictWiresDirty();
 }
 #endif
@@ -242,6 +339,11 @@ void APowerLine_Pole::MarkChildWiresDirty()
 #if WITH_EDITOR
 void APowerLine_Pole::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
 {
+	if (UPowerLineSubsystem* Sub = GetPowerLineSubsystem(this))
+	{
+		Sub->BeginFrameBatchEdit();
+	}
+
 	Super::PostEditChangeProperty(PropertyChangedEvent);
 
 	const FName PropName = PropertyChangedEvent.Property ? PropertyChangedEvent.Property->GetFName() : NAME_None;
@@ -250,6 +352,17 @@ void APowerLine_Pole::PostEditChangeProperty(FPropertyChangedEvent& PropertyChan
 		MarkChildWiresDirty();
 	}
 }
+
+void APowerLine_Pole::PostEditUndo()
+{
+	if (UPowerLineSubsystem* Sub = GetPowerLineSubsystem(this))
+	{
+		Sub->BeginFrameBatchEdit();
+	}
+
+	Super::PostEditUndo();
+	MarkChildWiresDirty();
+}
 #endif
 
 // ============================
@@ -261,6 +374,8 @@ class FPowerLineSceneProxy final : public FPrimitiveSceneProxy
 public:
 	TArray<FPowerLineSegment> Segments;
 	FBoxSphereBounds Bounds;
+	PowerLineCore::FWindParams Wind;
+	FPowerLineStylePalettePtr Palette;
 
 	explicit FPowerLineSceneProxy(const UPrimitiveComponent* InComponent)
 		: FPrimitiveSceneProxy(InComponent)
@@ -270,6 +385,8 @@ public:
 		{
 			Segments = Comp->FrontBuffer;
 			Bounds = Comp->CachedBounds;
+			Wind = Comp->Wind;
+			Palette = Comp->Palette;
 		}
 	}
 
@@ -285,6 +402,14 @@ public:
 		uint32 VisibilityMap,
 		FMeshElementCollector& Collector) const override
 	{
+		// Wind sway is evaluated here per vertex, so animated wires cost no rebuild or upload.
+		const bool bWind = Wind.Strength > 0.f;
+		const float Time = (float)ViewFamily.Time.GetWorldTimeSeconds();
+
+		// Same for color/thickness: palette lookup per segment (render-thread palette copy).
+		static const FPowerLineStylePalette NoPalette;
+		const FPowerLineStylePalette& Styles = Palette ? *Palette : NoPalette;
+
 		for (int32 ViewIndex = 0; ViewIndex < Views.Num(); ++ViewIndex)
 		{
 			if ((VisibilityMap & (1u << ViewIndex)) == 0) continue;
@@ -292,12 +417,25 @@ public:
 			FPrimitiveDrawInterface* PDI = Collector.GetPDI(ViewIndex);
 			for (const FPowerLineSegment& S : Segments)
 			{
+				FVector Start = S.Start;
+				FVector End = S.End;
+				if (bWind && S.Wind.Amplitude > 0)
+				{
+					// District scale per wind group, so a district's WindScale changes without a rebuild.
+					float T0, T1, Phase, Amplitude;
+					PowerLineCore::UnpackWindAttributes(S.Wind, T0, T1, Phase, Amplitude);
+					Amplitude *= Styles.GetWindScale(S.WindGroup);
+					Start += FVector(PowerLineCore::ComputeWindOffset(Wind, Time, T0, Phase, Amplitude));
+					End += FVector(PowerLineCore::ComputeWindOffset(Wind, Time, T1, Phase, Amplitude));
+				}
+
+				const FPowerLineStyle& Style = Styles.Get(S.Style);
 				PDI->DrawLine(
-					S.Start,
-					S.End,
-					S.Color,
+					Start,
+					End,
+					Style.Color,
 					SDPG_World,
-					S.Thickness,
+					Style.Thickness,
 					S.DepthBias,
 					S.bScreenSpace);
 			}
@@ -322,9 +460,17 @@ public:
 	// Render-thread update
 	void Update_RenderThread(TArray<FPowerLineSegment>&& NewSegs, const FBoxSphereBounds& NewBounds)
 	{
+		POWERLINE_SCOPE(PowerLine_ProxyUpdateRT);
+		LLM_SCOPE_BYTAG(PowerLine_Proxy);
 		Segments = MoveTemp(NewSegs);
 		Bounds = NewBounds;
 	}
+
+	void UpdateWind_RenderThread(const PowerLineCore::FWindParams& NewWind, const FBoxSphereBounds& NewBounds)
+	{
+		Wind = NewWind;
+		Bounds = NewBounds;
+	}
 };
 
 // ============================
@@ -346,11 +492,19 @@ UPowerLineRenderComponent::UPowerLineRenderComponent()
 void UPowerLineRenderComponent::RebuildCachedBounds_GT()
 {
 	FBox Box(EForceInit::ForceInit);
+	uint16 MaxWindAmplitude = 0;
 
 	for (const auto& S : FrontBuffer)
 	{
 		Box += S.Start;
 		Box += S.End;
+		MaxWindAmplitude = FMath::Max(MaxWindAmplitude, S.Wind.Amplitude);
+	}
+
+	// Room for the draw-time wind sway.
+	if (Box.IsValid && MaxWindAmplitude > 0 && Wind.Strength > 0.f)
+	{
+		Box = Box.ExpandBy(PowerLineCore::GetMaxWindOffset(Wind, (float)MaxWindAmplitude * 0.1f * MaxWindScale));
 	}
 
 	// Avoid invalid bounds (engine can cull everything if invalid)
@@ -364,6 +518,8 @@ void UPowerLineRenderComponent::RebuildCachedBounds_GT()
 
 void UPowerLineRenderComponent::UpdateSegments_GameThread(const TArray<FPowerLineSegment>& Segs)
 {
+	LLM_SCOPE_BYTAG(PowerLine_Segments);
+
 	{
 		FScopeLock Lock(&Mutex);
 		BackBuffer = Segs;
@@ -379,8 +535,45 @@ void UPowerLineRenderComponent::UpdateSegments_GameThread(const TArray<FPowerLin
 	MarkRenderTransformDirty();
 }
 
+void UPowerLineRenderComponent::OnRegister()
+{
+	// Before the proxy is created.
+	if (const UPowerLineSubsystem* Sub = GetPowerLineSubsystem(this))
+	{
+		Wind = Sub->GetWindParams();
+		MaxWindScale = Sub->GetMaxWindScale();
+		Palette = Sub->GetStylePalette();
+	}
+
+	Super::OnRegister();
+}
+
+void UPowerLineRenderComponent::SetWind_GameThread(const PowerLineCore::FWindParams& InWind, float InMaxWindScale)
+{
+	FBoxSphereBounds NewBounds;
+	{
+		FScopeLock Lock(&Mutex);
+		Wind = InWind;
+		MaxWindScale = InMaxWindScale;
+		RebuildCachedBounds_GT();
+		NewBounds = CachedBounds;
+	}
+
+	UpdateBounds();
+	MarkRenderTransformDirty();
+
+	FPrimitiveSceneProxy* Proxy = SceneProxy;
+	if (!Proxy) return;
+
+	ENQUEUE_RENDER_COMMAND(PowerLine_UpdateWind)(
+		[Proxy, InWind, NewBounds](FRHICommandListImmediate& RHICmdList) {
+			static_cast<FPowerLineSceneProxy*>(Proxy)->UpdateWind_RenderThread(InWind, NewBounds);
+		});
+}
+
 FPrimitiveSceneProxy* UPowerLineRenderComponent::CreateSceneProxy()
 {
+	LLM_SCOPE_BYTAG(PowerLine_Proxy);
 	return new FPowerLineSceneProxy(this);
 }
 
@@ -397,6 +590,9 @@ void UPowerLineRenderComponent::SendRenderDynamicData_Concurrent()
 	FPrimitiveSceneProxy* Proxy = SceneProxy;
 	if (!Proxy) return;
 
+	POWERLINE_SCOPE(PowerLine_ProxyUpdate);
+	LLM_SCOPE_BYTAG(PowerLine_Proxy);
+
 	// Copy segments safely
 	TArray<FPowerLineSegment> Copy;
 	FBoxSphereBounds CopyBounds;
@@ -407,6 +603,8 @@ void UPowerLineRenderComponent::SendRenderDynamicData_Concurrent()
 		CopyBounds = CachedBounds;
 	}
 
+	INC_DWORD_STAT_BY(STAT_PowerLine_BytesUploaded, Copy.Num() * sizeof(FPowerLineSegment));
+
 	ENQUEUE_RENDER_COMMAND(PowerLine_UpdateProxy)(
 		[Proxy, Segs = MoveTemp(Copy), B = CopyBounds](FRHICommandListImmediate& RHICmdList) mutable {
 			auto* PLProxy = static_cast<FPowerLineSceneProxy*>(Proxy);
@@ -573,6 +771,11 @@ void UPowerLineComponent::OnUnregister()
 #if WITH_EDITOR
 void UPowerLineComponent::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
 {
+	if (UPowerLineSubsystem* Sub = GetPowerLineSubsystem(this))
+	{
+		Sub->BeginFrameBatchEdit();
+	}
+
 	Super::PostEditChangeProperty(PropertyChangedEvent);
 
 	const FName PropName = PropertyChangedEvent.Property ? PropertyChangedEvent.Property->GetFName() : NAME_None;
@@ -584,13 +787,24 @@ void UPowerLineComponent::PostEditChangeProperty(FPropertyChangedEvent& Property
 		PropName == GET_MEMBER_NAME_CHECKED(UPowerLineComponent, TargetAttachIdOverride) ||
 		PropName == GET_MEMBER_NAME_CHECKED(UPowerLineComponent, ManualEndPointWS))
 	{
-		BindToTarget();
+		RefreshTargetBinding();
 	}
 
 	// Any editable property can affect rendering (segments/sag/color/thickness/district),
 	// so always request rebuild in editor.
 	MarkDirty();
 }
+
+void UPowerLineComponent::PostEditUndo()
+{
+	if (UPowerLineSubsystem* Sub = GetPowerLineSubsystem(this))
+	{
+		Sub->BeginFrameBatchEdit();
+	}
+
+	Super::PostEditUndo();
+	RefreshTargetBinding();
+}
 #endif
 
 void UPowerLineComponent::BindToTarget()
@@ -631,7 +845,12 @@ void UPowerLineComponent::HandleTransformChanged(
 	EUpdateTransformFlags UpdateTransformFlags,
 	ETeleportType Teleport)
 {
-	MarkDirty();
+	if (!GetWorld()) return;
+
+	if (auto* Sub = GetWorld()->GetSubsystem<UPowerLineSubsystem>())
+	{
+		Sub->MarkPowerLineMoved(this, EPowerLineDirtyCause::OwnTransform);
+	}
 }
 
 void UPowerLineComponent::HandleTargetTransformChanged(
@@ -639,22 +858,55 @@ void UPowerLineComponent::HandleTargetTransformChanged(
 	EUpdateTransformFlags UpdateTransformFlags,
 	ETeleportType Teleport)
 {
-	MarkDirty();
+	if (!GetWorld()) return;
+
+	if (auto* Sub = GetWorld()->GetSubsystem<UPowerLineSubsystem>())
+	{
+		Sub->MarkPowerLineMoved(this, EPowerLineDirtyCause::TargetTransform);
+	}
+}
+
+bool UPowerLineComponent::CanEverMove() const
+{
+	auto IsMovable = [](const AActor* Actor) {
+		const USceneComponent* Root = Actor ? Actor->GetRootComponent() : nullptr;
+		return Root && Root->Mobility == EComponentMobility::Movable;
+		};
+
+	return Mobility == EComponentMobility::Movable
+		|| IsMovable(GetOwner())
+		|| IsMovable(ResolveEffectiveTargetActor());
 }
 
 void UPowerLineComponent::MarkDirty()
+{
+	MarkDirtyWithCause(EPowerLineDirtyCause::Property);
+}
+
+void UPowerLineComponent::MarkDirtyWithCause(EPowerLineDirtyCause Cause)
 {
 	if (!GetWorld()) return;
 
 	if (auto* Sub = GetWorld()->GetSubsystem<UPowerLineSubsystem>())
 	{
-		Sub->MarkPowerLineDirty(this);
+		Sub->MarkPowerLineDirty(this, Cause);
 	}
 }
 
 void UPowerLineComponent::RefreshTargetBinding()
 {
+	if (UPowerLineSubsystem* Sub = GetPowerLineSubsystem(this))
+	{
+		if (Sub->DeferTargetRebind(this)) return;
+	}
+
 	BindToTarget();
+
+	if (UPowerLineSubsystem* Sub = GetPowerLineSubsystem(this))
+	{
+		Sub->UpdateWireConnection(this);
+	}
+
 	MarkDirty();
 }
 
@@ -688,8 +940,16 @@ AActor* UPowerLineComponent::ResolveEffectiveTargetActor() const
 	return nullptr;
 }
 
-bool UPowerLineComponent::ResolveEndPoint(FVector& OutEnd) const
+bool UPowerLineComponent::ResolveEndPoint(FVector& OutEnd, FQuat* OutEndRotation) const
 {
+	POWERLINE_SCOPE(PowerLine_ResolveEndPoint);
+
+	// Manual end points use our own frame.
+	if (OutEndRotation)
+	{
+		*OutEndRotation = GetComponentQuat();
+	}
+
 	// 1) If we have a target actor, draw only when a matching attach exists.
 	if (AActor* EffectiveTarget = ResolveEffectiveTargetActor())
 	{
@@ -699,6 +959,10 @@ bool UPowerLineComponent::ResolveEndPoint(FVector& OutEnd) const
 		if (USceneComponent* TargetComp = FindAttachOnActor(EffectiveTarget, WantedKey, TargetLookup))
 		{
 			OutEnd = TargetComp->GetComponentLocation();
+			if (OutEndRotation)
+			{
+				*OutEndRotation = TargetComp->GetComponentQuat();
+			}
 			return true;
 		}
 
@@ -722,8 +986,20 @@ bool UPowerLineComponent::GetResolvedEndPointWS(FVector& OutEnd) const
 	return ResolveEndPoint(OutEnd);
 }
 
+bool UPowerLineComponent::GetResolvedSpan(FVector& OutStart, FVector& OutEnd, float& OutSag) const
+{
+	if (!bHasResolvedSpan) return false;
+
+	OutStart = ResolvedSpan.Start;
+	OutEnd = ResolvedSpan.End;
+	OutSag = ResolvedSpan.Sag;
+	return true;
+}
+
 APowerLineDistrictDataManager* UPowerLineComponent::ResolveDistrictManager() const
 {
+	POWERLINE_SCOPE(PowerLine_ResolveDistrictManager);
+
 	const FVector MyLocation = GetComponentLocation();
 
 	if (DistrictManager)
@@ -736,6 +1012,14 @@ APowerLineDistrictDataManager* UPowerLineComponent::ResolveDistrictManager() con
 		return nullptr;
 	}
 
+	if (bDynamic)
+	{
+		if (APowerLineDistrictDataManager* Cached = DynamicDistrictCache.Get())
+		{
+			return Cached;
+		}
+	}
+
 	UWorld* W = GetWorld();
 	if (!W) return nullptr;
 
@@ -765,101 +1049,135 @@ APowerLineDistrictDataManager* UPowerLineComponent::ResolveDistrictManager() con
 		}
 	}
 
+	if (bDynamic)
+	{
+		DynamicDistrictCache = Best;
+	}
+
 	return Best;
 }
 
-void UPowerLineComponent::BuildSegments(TArray<FPowerLineSegment>& Out) const
+bool UPowerLineComponent::ResolveBuildInputs(FPowerLineWireBuild& Out) const
 {
 	FVector EndWS;
-	const bool bConnected = ResolveEndPoint(EndWS);
+	FQuat EndRotation = FQuat::Identity;
+	const bool bConnected = ResolveEndPoint(EndWS, Conductors.Num() > 0 ? &EndRotation : nullptr);
 	if (!bConnected)
 	{
-		return;
+		return false;
 	}
 
-	const FVector StartWS = GetComponentLocation();
-	const FVector Delta = EndWS - StartWS;
-	const float Length = Delta.Size();
+	PowerLineCore::FSpanInput Span;
+	Span.Start = GetComponentLocation();
+	Span.End = EndWS;
+	Span.LineId = LineId;
+	Span.WireSag = SagAmount;
+	Span.WireSegments = NumSegments;
 
 	APowerLineDistrictDataManager* DM = ResolveDistrictManager();
-
-	float EffectiveSag = SagAmount;
-	int32 EffectiveSegments = FMath::Max(2, NumSegments);
-
-	if (DM)
+	const PowerLineCore::FDistrictParams District = DM ? DM->GetCoreParams() : PowerLineCore::FDistrictParams();
+
+	Out.Start = Span.Start;
+	Out.End = Span.End;
+	Out.Shape.Reset();
+	Out.LineHash = PowerLineCore::HashLine(Span.Start, Span.End, LineId);
+	Out.District = DM;
+	Out.bUniqueSag = DM && District.Sag.MinCm != District.Sag.MaxCm;
+	PowerLineCore::ResolveSpan(Span, DM ? &District : nullptr, Out.Sag, Out.Segments);
+	Out.BreakT = BreakT;
+	Out.BreakGroundZ[0] = BreakGroundZ[0];
+	Out.BreakGroundZ[1] = BreakGroundZ[1];
+
+	// Bundle: the span above is the centre line; conductors only add their offsets and wind phase.
+	Out.Bundle.Reset();
+	if (Conductors.Num() > 0)
 	{
-		EffectiveSag = DM->GetSagForLine(StartWS, EndWS, LineId);
-		// Use both sources so per-wire NumSegments can always increase detail,
-		// while district auto/fixed policy still affects baseline segmentation.
-		const int32 DistrictSegments = DM->GetSegmentsForLength(Length);
-		EffectiveSegments = FMath::Max(2, FMath::Max(NumSegments, DistrictSegments));
-	}
-
-	auto PointAt = [&](float T) {
-		const FVector P = FMath::Lerp(StartWS, EndWS, T);
-		const float SagFactor = FMath::Clamp(4.f * T * (1.f - T), 0.f, 1.f);
-		return P - FVector(0, 0, EffectiveSag * SagFactor);
-		};
-
-	// Build equal-length segments along the sagged curve (arc-length parameterization).
-	const int32 SampleCount = FMath::Clamp(EffectiveSegments * 8, 32, 512);
-	TArray<FVector> Samples;
-	Samples.Reserve(SampleCount + 1);
+		TSharedRef<FPowerLineBundle, ESPMode::ThreadSafe> Bundle = MakeShared<FPowerLineBundle, ESPMode::ThreadSafe>();
+		const FQuat StartRotation = GetComponentQuat();
+		const FVector Scale = GetComponentScale();
 
-	TArray<float> CumLen;
-	CumLen.Reserve(SampleCount + 1);
+		for (const FPowerLineConductor& Conductor : Conductors)
+		{
+			const FVector Local = Conductor.Offset * Scale;
+			Bundle->StartOffsets.Add(StartRotation.RotateVector(Local));
+			Bundle->EndOffsets.Add(EndRotation.RotateVector(Local));
+			Bundle->LineHashes.Add(PowerLineCore::HashLine(Span.Start, Span.End, Conductor.LineId));
+		}
+		Out.Bundle = Bundle;
+	}
+	return true;
+}
 
-	float TotalLen = 0.f;
-	FVector Prev = PointAt(0.f);
-	Samples.Add(Prev);
-	CumLen.Add(0.f);
+void FPowerLineWireBuild::Emit(TArray<FVector>& Scratch, TArray<FPowerLineSegment>& Out) const
+{
+	const float WindAmplitude = FMath::Abs(Sag);
 
-	for (int32 i = 1; i <= SampleCount; ++i)
-	{
-		const float T = (float)i / (float)SampleCount;
-		const FVector Cur = PointAt(T);
-		TotalLen += FVector::Dist(Prev, Cur);
-		Samples.Add(Cur);
-		CumLen.Add(TotalLen);
-		Prev = Cur;
-	}
+	// Equal arc-length points: point i sits at i / NumSegs of the polyline's span range. Point i is moved by
+	// Offset + Skew * i.
+	auto EmitPolyline = [&](TArrayView<const FVector> Points, const FVector& Offset, const FVector& Skew, uint32 Hash, float SpanT0, float SpanT1) {
+		const float StepT = (SpanT1 - SpanT0) / (float)FMath::Max(1, Points.Num() - 1);
+		for (int32 i = 0; i + 1 < Points.Num(); ++i)
+		{
+			FPowerLineSegment S;
+			S.Start = Points[i] + Offset + Skew * (double)i;
+			S.End = Points[i + 1] + Offset + Skew * (double)(i + 1);
+			S.Style = Style;
+			S.DepthBias = 0.f;
+			S.bScreenSpace = true;
+			S.Wind = PowerLineCore::PackWindAttributes(SpanT0 + i * StepT, SpanT0 + (i + 1) * StepT, Hash, WindAmplitude);
+			S.WindGroup = WindGroup;
+			Out.Add(S);
+		}
+		};
 
-	if (TotalLen <= KINDA_SMALL_NUMBER)
+	// Shared shapes are relative to the wire start and end at the quantized delta (up to 0.5 cm off per axis):
+	// the difference is spread along the wire so it ends exactly on End.
+	if (Shape)
 	{
+		EmitPolyline(Shape->Points, Start, GetShapeSkew(), LineHash, 0.f, 1.f);
 		return;
 	}
 
-	auto EvalAtDistance = [&](float TargetLen) {
-		const float ClampedTarget = FMath::Clamp(TargetLen, 0.f, TotalLen);
-		for (int32 Idx = 1; Idx < CumLen.Num(); ++Idx)
-		{
-			if (CumLen[Idx] < ClampedTarget)
-			{
-				continue;
-			}
-
-			const float L0 = CumLen[Idx - 1];
-			const float L1 = CumLen[Idx];
-			const float A = (L1 > L0) ? ((ClampedTarget - L0) / (L1 - L0)) : 0.f;
-			return FMath::Lerp(Samples[Idx - 1], Samples[Idx], A);
-		}
+	ForEachPolyline(Scratch, [&](TArrayView<const FVector> Points, uint32 Hash, float SpanT0, float SpanT1) {
+		EmitPolyline(Points, FVector::ZeroVector, FVector::ZeroVector, Hash, SpanT0, SpanT1);
+		});
+}
 
-		return Samples.Last();
-		};
+FVector FPowerLineWireBuild::GetShapeSkew() const
+{
+	const int32 NumPoints = Shape ? Shape->Points.Num() : 0;
+	return NumPoints > 1 ? (End - Start - Shape->Points.Last()) / (double)(NumPoints - 1) : FVector::ZeroVector;
+}
 
-	for (int32 i = 0; i < EffectiveSegments; ++i)
+void FPowerLineWireBuild::ForEachPolyline(TArray<FVector>& Scratch,
+	TFunctionRef<void(TArrayView<const FVector> Points, uint32 Hash, float SpanT0, float SpanT1)> Fn) const
+{
+	// Bundles: all conductors in one pass, the curve is measured once and offset per conductor.
+	const bool bBuilt = Bundle
+		? PowerLineCore::BuildSaggedBundle(Start, End, Sag, Segments, Bundle->StartOffsets, Bundle->EndOffsets, Scratch)
+		: PowerLineCore::BuildSaggedCurve(Start, End, Sag, Segments, Scratch);
+	if (!bBuilt) return;
+
+	const int32 NumConductors = Bundle ? Bundle->StartOffsets.Num() : 1;
+	const int32 PointsPerConductor = Scratch.Num() / NumConductors;
+
+	TArray<FVector> PieceA;
+	TArray<FVector> PieceB;
+	for (int32 c = 0; c < NumConductors; ++c)
 	{
-		const float L0 = (TotalLen * (float)i) / (float)EffectiveSegments;
-		const float L1 = (TotalLen * (float)(i + 1)) / (float)EffectiveSegments;
+		const TArrayView<const FVector> Points(Scratch.GetData() + c * PointsPerConductor, PointsPerConductor);
+		const uint32 Hash = Bundle ? Bundle->LineHashes[c] : LineHash;
 
-		FPowerLineSegment S;
-		S.Start = EvalAtDistance(L0);
-		S.End = EvalAtDistance(L1);
-		S.Color = LineColor;
-		S.Thickness = LineThickness;
-		S.DepthBias = 0.f;
-		S.bScreenSpace = true;
-		Out.Add(S);
+		// Broken: both pieces hang from their attach points and sway most at the cut end.
+		if (BreakT >= 0.f && PowerLineCore::BuildBrokenPieces(Points, BreakT, BreakGroundZ[0], BreakGroundZ[1], PieceA, PieceB))
+		{
+			Fn(PieceA, Hash, 0.f, 0.5f);
+			Fn(PieceB, Hash, 1.f, 0.5f);
+		}
+		else
+		{
+			Fn(Points, Hash, 0.f, 1.f);
+		}
 	}
 }
 
@@ -901,7 +1219,7 @@ AActor* UPowerLineSubsystem::EnsureRenderHost()
 	return Host;
 }
 
-FPowerLineChunkKey UPowerLineSubsystem::CalcKey(const FVector& Pos) const
+FPowerLineChunkKey UPowerLineSubsystem::CalcRootKey(const FVector& Pos) const
 {
 	const float CS = FMath::Max(1.f, ChunkSize);
 	const int32 X = FMath::FloorToInt(Pos.X / CS);
@@ -909,204 +1227,3861 @@ FPowerLineChunkKey UPowerLineSubsystem::CalcKey(const FVector& Pos) const
 	return FPowerLineChunkKey{ FIntPoint(X, Y) };
 }
 
-void UPowerLineSubsystem::EnsureRenderComponent(const FPowerLineChunkKey& Key)
+FPowerLineChunkKey UPowerLineSubsystem::CalcKeyAtLevel(const FVector& Pos, int32 Level) const
 {
-	if (RenderComponents.Contains(Key))
+	if (Level <= 0)
 	{
-		if (RenderComponents[Key].IsValid())
-		{
-			return;
-		}
+		return CalcRootKey(Pos);
 	}
 
-	AActor* Host = EnsureRenderHost();
-	if (!Host) return;
-
-	UPowerLineRenderComponent* RC = NewObject<UPowerLineRenderComponent>(Host);
-	RC->SetupAttachment(Host->GetRootComponent());
-	RC->RegisterComponent();
+	const float CS = FMath::Max(1.f, ChunkSize) / (float)(1 << Level);
 
-	RenderComponents.Add(Key, RC);
+	FPowerLineChunkKey Key;
+	Key.Coord = FIntPoint(FMath::FloorToInt(Pos.X / CS), FMath::FloorToInt(Pos.Y / CS));
+	Key.Z = bAdaptiveVertical ? FMath::FloorToInt(Pos.Z / CS) : 0;
+	Key.Level = (uint8)Level;
+	return Key;
 }
 
-void UPowerLineSubsystem::UpdateLineChunk(UPowerLineComponent* Line, const FPowerLineChunkKey& NewKey)
+FPowerLineChunkKey UPowerLineSubsystem::GetParentKey(const FPowerLineChunkKey& Key)
 {
-	if (!Line) return;
-
-	// remove from old
-	if (Line->bHasKey)
+	if (Key.Level == 0)
 	{
-		if (FPowerLineChunk* Old = Chunks.Find(Line->CurrentKey))
-		{
-			Old->Lines.Remove(Line);
-			DirtyChunks.Add(Line->CurrentKey);
-		}
+		return Key;
 	}
 
-	// add to new
-	{
-		FPowerLineChunk& Chunk = Chunks.FindOrAdd(NewKey);
-		Chunk.Lines.Add(Line);
-		DirtyChunks.Add(NewKey);
-	}
+	auto FloorDiv2 = [](int32 V) { return (V < 0) ? ((V - 1) / 2) : (V / 2); };
 
-	Line->CurrentKey = NewKey;
-	Line->bHasKey = true;
-	Line->bRegistered = true;
+	FPowerLineChunkKey Parent;
+	Parent.Coord = FIntPoint(FloorDiv2(Key.Coord.X), FloorDiv2(Key.Coord.Y));
+	Parent.Level = Key.Level - 1;
+	// Root cells span all heights.
+	Parent.Z = (Parent.Level == 0) ? 0 : FloorDiv2(Key.Z);
+	return Parent;
 }
 
-void UPowerLineSubsystem::RegisterPowerLine(UPowerLineComponent* Line)
+FPowerLineChunkKey UPowerLineSubsystem::CalcKey(const FVector& Pos) const
 {
-	if (!Line) return;
+	FPowerLineChunkKey Key = CalcRootKey(Pos);
+	if (!bAdaptiveChunking)
+	{
+		return Key;
+	}
 
-	const FPowerLineChunkKey Key = CalcKey(Line->GetComponentLocation());
-	UpdateLineChunk(Line, Key);
-	MarkPowerLineDirty(Line);
+	// Descend while the cell is subdivided.
+	while (Key.Level < MaxSplitDepth && SplitChunks.Contains(Key))
+	{
+		Key = CalcKeyAtLevel(Pos, Key.Level + 1);
+	}
+	return Key;
 }
 
-void UPowerLineSubsystem::UnregisterPowerLine(UPowerLineComponent* Line)
+void UPowerLineSubsystem::RehomeChunkLines(const FPowerLineChunkKey& Key)
 {
-	if (!Line) return;
-
-	RemoveHangingForLine(Line);
+	FPowerLineChunk* Chunk = Chunks.Find(Key);
+	if (!Chunk) return;
 
-	if (Line->bHasKey)
+	// Copy: UpdateLineChunk swap-removes from this chunk and may grow the map.
+	TArray<TWeakObjectPtr<UPowerLineComponent>> Lines = Chunk->Lines;
+	for (const TWeakObjectPtr<UPowerLineComponent>& WLine : Lines)
 	{
-		if (FPowerLineChunk* Chunk = Chunks.Find(Line->CurrentKey))
+		if (UPowerLineComponent* Line = WLine.Get())
 		{
-			Chunk->Lines.Remove(Line);
-			DirtyChunks.Add(Line->CurrentKey);
+			const FPowerLineChunkKey NewKey = CalcKey(Line->GetComponentLocation());
+			if (!(NewKey == Key))
+			{
+				UpdateLineChunk(Line, NewKey);
+			}
 		}
 	}
 
-	Line->bRegistered = false;
-	Line->bHasKey = false;
+	DirtyChunks.Add(Key);
 }
 
-void UPowerLineSubsystem::MarkPowerLineDirty(UPowerLineComponent* Line)
+void UPowerLineSubsystem::SplitChunk(const FPowerLineChunkKey& Key)
 {
-	if (!Line) return;
+	if (Key.Level >= MaxSplitDepth || SplitChunks.Contains(Key)) return;
 
-	const FPowerLineChunkKey NewKey = CalcKey(Line->GetComponentLocation());
+	SplitChunks.Add(Key);
+	RehomeChunkLines(Key);
+}
+
+void UPowerLineSubsystem::MergeSparseChunks()
+{
+	if (SplitChunks.Num() == 0) return;
+
+	// Parent -> (segment total, has split child) over current leaf chunks.
+	struct FChildrenInfo
+	{
+		int32 Segments = 0;
+		bool bHasSplitChild = false;
+	};
+
+	TMap<FPowerLineChunkKey, FChildrenInfo> ByParent;
+	for (const TPair<FPowerLineChunkKey, FPowerLineChunk>& Pair : Chunks)
+	{
+		if (Pair.Key.Level == 0) continue;
+
+		FChildrenInfo& Info = ByParent.FindOrAdd(GetParentKey(Pair.Key));
+		Info.Segments += Pair.Value.BatchedSegments.Num();
+	}
+	for (const FPowerLineChunkKey& SplitKey : SplitChunks)
+	{
+		if (SplitKey.Level > 0)
+		{
+			ByParent.FindOrAdd(GetParentKey(SplitKey)).bHasSplitChild = true;
+		}
+	}
+
+	// Merge only nodes whose children are all leaves (deeper levels collapse over later checks).
+	TSet<FPowerLineChunkKey> ToMerge;
+	for (const FPowerLineChunkKey& SplitKey : SplitChunks)
+	{
+		const FChildrenInfo* Info = ByParent.Find(SplitKey);
+		if (!Info)
+		{
+			ToMerge.Add(SplitKey);
+			continue;
+		}
+
+		if (!Info->bHasSplitChild && Info->Segments < MergeSegmentThreshold)
+		{
+			ToMerge.Add(SplitKey);
+		}
+	}
+
+	for (const FPowerLineChunkKey& Key : ToMerge)
+	{
+		SplitChunks.Remove(Key);
+	}
+
+	if (ToMerge.Num() == 0) return;
+
+	// Re-home lines of merged children into their parents.
+	TArray<FPowerLineChunkKey> ChildKeys;
+	for (const TPair<FPowerLineChunkKey, FPowerLineChunk>& Pair : Chunks)
+	{
+		if (Pair.Key.Level > 0 && ToMerge.Contains(GetParentKey(Pair.Key)))
+		{
+			ChildKeys.Add(Pair.Key);
+		}
+	}
+
+	for (const FPowerLineChunkKey& ChildKey : ChildKeys)
+	{
+		RehomeChunkLines(ChildKey);
+	}
+}
+
+void UPowerLineSubsystem::EnsureRenderComponent(const FPowerLineChunkKey& Key)
+{
+	if (RenderComponents.Contains(Key))
+	{
+		if (RenderComponents[Key].IsValid())
+		{
+			return;
+		}
+	}
+
+	// Reuse an idle component before creating a new one.
+	while (RenderComponentPool.Num() > 0)
+	{
+		if (UPowerLineRenderComponent* Pooled = RenderComponentPool.Pop().Get())
+		{
+			Pooled->SetVisibility(true, true);
+			RenderComponents.Add(Key, Pooled);
+			return;
+		}
+	}
+
+	AActor* Host = EnsureRenderHost();
+	if (!Host) return;
+
+	UPowerLineRenderComponent* RC = NewObject<UPowerLineRenderComponent>(Host);
+	RC->SetupAttachment(Host->GetRootComponent());
+	RC->RegisterComponent();
+
+	RenderComponents.Add(Key, RC);
+}
+
+void UPowerLineSubsystem::ReleaseRenderComponent(const FPowerLineChunkKey& Key)
+{
+	TWeakObjectPtr<UPowerLineRenderComponent> RCW;
+	if (!RenderComponents.RemoveAndCopyValue(Key, RCW)) return;
+
+	UPowerLineRenderComponent* RC = RCW.Get();
+	if (!RC) return;
+
+	if (RenderComponentPool.Num() < MaxPooledRenderComponents)
+	{
+		RC->UpdateSegments_GameThread(TArray<FPowerLineSegment>());
+		RC->SetVisibility(false, true);
+		RenderComponentPool.Add(RC);
+	}
+	else
+	{
+		RC->DestroyComponent();
+	}
+}
+
+void UPowerLineSubsystem::ReclaimEmptyChunks()
+{
+	const double Now = FPlatformTime::Seconds();
+
+	for (auto It = EmptyChunks.CreateIterator(); It; ++It)
+	{
+		const FPowerLineChunkKey Key = *It;
+		FPowerLineChunk* Chunk = Chunks.Find(Key);
+		if (!Chunk)
+		{
+			It.RemoveCurrent();
+			continue;
+		}
+
+		// Refilled since (or waiting for a rebuild): keep it.
+		if (Chunk->Lines.Num() > 0 || Chunk->EmptySince <= 0.0 || DirtyChunks.Contains(Key))
+		{
+			if (Chunk->Lines.Num() > 0)
+			{
+				It.RemoveCurrent();
+			}
+			continue;
+		}
+
+		if (Now - Chunk->EmptySince < EmptyChunkGraceSeconds)
+		{
+			continue;
+		}
+
+		ReleaseRenderComponent(Key);
+		Chunks.Remove(Key);
+		QueryDirtyChunks.Add(Key);
+		It.RemoveCurrent();
+	}
+}
+
+void UPowerLineSubsystem::GetChunkStats(int32& OutLive, int32& OutPooled, int32& OutEmpty) const
+{
+	OutEmpty = EmptyChunks.Num();
+	OutLive = FMath::Max(0, Chunks.Num() - OutEmpty);
+	OutPooled = RenderComponentPool.Num();
+}
+
+// ============================
+// Subsystem - Memory report
+// ============================
+
+// Front + back buffer on the component, plus the proxy copy on the render thread.
+static SIZE_T GetRenderComponentBytes(const UPowerLineRenderComponent* RC)
+{
+	if (!RC) return 0;
+	return RC->FrontBuffer.GetAllocatedSize() * 2 + RC->BackBuffer.GetAllocatedSize();
+}
+
+static SIZE_T GetChunkBytes(const FPowerLineChunk& C)
+{
+	return sizeof(FPowerLineChunk)
+		+ C.Lines.GetAllocatedSize()
+		+ C.BatchedSegments.GetAllocatedSize();
+}
+
+FPowerLineMemoryStats UPowerLineSubsystem::GetMemoryStats() const
+{
+	FPowerLineMemoryStats Stats;
+
+	Stats.Chunks = Chunks.GetAllocatedSize();
+	for (const TPair<FPowerLineChunkKey, FPowerLineChunk>& Pair : Chunks)
+	{
+		Stats.Chunks += GetChunkBytes(Pair.Value);
+	}
+
+	for (const TPair<FPowerLineChunkKey, TWeakObjectPtr<UPowerLineRenderComponent>>& Pair : RenderComponents)
+	{
+		Stats.Render += GetRenderComponentBytes(Pair.Value.Get());
+	}
+	for (const TWeakObjectPtr<UPowerLineRenderComponent>& Pooled : RenderComponentPool)
+	{
+		Stats.Render += GetRenderComponentBytes(Pooled.Get());
+	}
+
+	Stats.Dynamic = DynamicLines.GetAllocatedSize() + DynamicSegments.GetAllocatedSize() + GetRenderComponentBytes(DynamicRender.Get());
+
+	// Simulated cables count as dynamic (rebuilt every frame).
+	Stats.Dynamic += SimWires.GetAllocatedSize() + SimSegments.GetAllocatedSize() + GetRenderComponentBytes(SimRender.Get());
+	for (const FSimWire& Sim : SimWires)
+	{
+		Stats.Dynamic += Sim.State.GetAllocatedSize();
+	}
+
+	Stats.Poles = PoleRefs.GetAllocatedSize() + PoleHISMs.GetAllocatedSize() + DirtyPoles.GetAllocatedSize();
+	for (const TPair<uint64, FPoleHISMData>& Pair : PoleHISMs)
+	{
+		Stats.Poles += Pair.Value.Owners.GetAllocatedSize();
+	}
+
+	Stats.Hanging = HangingByLine.GetAllocatedSize();
+	Stats.Shapes = ShapeCache.GetAllocatedSize();
+
+	// Published snapshot holds the same chunk data as ChunkQueries (older snapshots still held by readers are not counted).
+	Stats.Queries = ChunkQueries.GetAllocatedSize() + QueryDirtyChunks.GetAllocatedSize();
+	if (QuerySnapshot)
+	{
+		Stats.Queries += QuerySnapshot->GetAllocatedSize();
+	}
+
+	Stats.Bookkeeping = RenderComponents.GetAllocatedSize() + DirtyChunks.GetAllocatedSize()
+		+ EmptyChunks.GetAllocatedSize() + SplitChunks.GetAllocatedSize() + StreamedMeshes.GetAllocatedSize()
+		+ StyleSlots.GetAllocatedSize() + FreeStyles.GetAllocatedSize() + SharedStyles.GetAllocatedSize()
+		+ Grid.GetAllocatedSize() + GridVertexByActor.GetAllocatedSize() + GridActors.GetAllocatedSize()
+		+ GridVertexRefs.GetAllocatedSize() + GridEdgeWires.GetAllocatedSize() + PowerSources.GetAllocatedSize();
+
+	return Stats;
+}
+
+void UPowerLineSubsystem::DumpMemoryReport(FOutputDevice& Ar, int32 MaxChunks) const
+{
+	struct FChunkBytes
+	{
+		FPowerLineChunkKey Key;
+		int32 Lines = 0;
+		int32 Segments = 0;
+		SIZE_T ChunkBytes = 0;
+		SIZE_T RenderBytes = 0;
+	};
+
+	struct FDistrictBytes
+	{
+		int32 Wires = 0;
+		int32 Segments = 0;
+	};
+
+	TArray<FChunkBytes> PerChunk;
+	PerChunk.Reserve(Chunks.Num());
+	TMap<const APowerLineDistrictDataManager*, FDistrictBytes> PerDistrict;
+
+	auto AddToDistrict = [&](const UPowerLineComponent* Line) {
+		FDistrictBytes& D = PerDistrict.FindOrAdd(Line->ResolveDistrictManager());
+		D.Wires++;
+		D.Segments += Line->LastSegmentCount;
+		};
+
+	for (const TPair<FPowerLineChunkKey, FPowerLineChunk>& Pair : Chunks)
+	{
+		const FPowerLineChunk& C = Pair.Value;
+
+		FChunkBytes& Info = PerChunk.AddDefaulted_GetRef();
+		Info.Key = Pair.Key;
+		Info.Lines = C.Lines.Num();
+		Info.Segments = C.BatchedSegments.Num();
+		Info.ChunkBytes = GetChunkBytes(C);
+
+		if (const TWeakObjectPtr<UPowerLineRenderComponent>* RCW = RenderComponents.Find(Pair.Key))
+		{
+			Info.RenderBytes = GetRenderComponentBytes(RCW->Get());
+		}
+
+		for (const TWeakObjectPtr<UPowerLineComponent>& WLine : C.Lines)
+		{
+			if (const UPowerLineComponent* Line = WLine.Get())
+			{
+				AddToDistrict(Line);
+			}
+		}
+	}
+
+	for (const TWeakObjectPtr<UPowerLineComponent>& WLine : DynamicLines)
+	{
+		if (const UPowerLineComponent* Line = WLine.Get())
+		{
+			AddToDistrict(Line);
+		}
+	}
+
+	const FPowerLineMemoryStats Stats = GetMemoryStats();
+	auto KB = [](SIZE_T Bytes) { return (double)Bytes / 1024.0; };
+
+	Ar.Logf(TEXT("==== PowerLine memory (%s) ===="), *GetWorld()->GetName());
+	Ar.Logf(TEXT("  Chunks:        %10.1f KB (%d chunks)"), KB(Stats.Chunks), Chunks.Num());
+	Ar.Logf(TEXT("  Render/Proxy:  %10.1f KB (%d components, %d pooled)"), KB(Stats.Render), RenderComponents.Num(), RenderComponentPool.Num());
+	Ar.Logf(TEXT("  Dynamic:       %10.1f KB (%d wires)"), KB(Stats.Dynamic), DynamicLines.Num());
+	Ar.Logf(TEXT("  Poles:         %10.1f KB (%d instances, %d HISMs)"), KB(Stats.Poles), PoleRefs.Num(), PoleHISMs.Num());
+	Ar.Logf(TEXT("  Hanging:       %10.1f KB (%d components)"), KB(Stats.Hanging), HangingByLine.Num());
+	Ar.Logf(TEXT("  Shape cache:   %10.1f KB (%d shapes, %llu evicted)"), KB(Stats.Shapes), ShapeCache.Num(), ShapeCache.Evictions);
+	Ar.Logf(TEXT("  Wire queries:  %10.1f KB"), KB(Stats.Queries));
+	Ar.Logf(TEXT("  Bookkeeping:   %10.1f KB"), KB(Stats.Bookkeeping));
+	Ar.Logf(TEXT("  Total:         %10.1f KB"), KB(Stats.GetTotal()));
+
+	PerChunk.Sort([](const FChunkBytes& A, const FChunkBytes& B) {
+		return (A.ChunkBytes + A.RenderBytes) > (B.ChunkBytes + B.RenderBytes);
+		});
+
+	const int32 NumToList = (MaxChunks < 0) ? PerChunk.Num() : FMath::Min(MaxChunks, PerChunk.Num());
+	Ar.Logf(TEXT("---- Chunks (top %d of %d) ----"), NumToList, PerChunk.Num());
+	for (int32 i = 0; i < NumToList; ++i)
+	{
+		const FChunkBytes& Info = PerChunk[i];
+		Ar.Logf(TEXT("  (%d, %d, %d) L%d: %6d wires %8d segs  chunk %8.1f KB  render %8.1f KB"),
+			Info.Key.Coord.X, Info.Key.Coord.Y, Info.Key.Z, (int32)Info.Key.Level,
+			Info.Lines, Info.Segments, KB(Info.ChunkBytes), KB(Info.RenderBytes));
+	}
+
+	Ar.Logf(TEXT("---- Districts (one segment copy, %d bytes/segment) ----"), (int32)sizeof(FPowerLineSegment));
+	for (const TPair<const APowerLineDistrictDataManager*, FDistrictBytes>& Pair : PerDistrict)
+	{
+		const FString Name = Pair.Key
+			? FString::Printf(TEXT("%s [%s]"), *Pair.Key->GetName(), *Pair.Key->DistrictId.ToString())
+			: FString(TEXT("<no district>"));
+		Ar.Logf(TEXT("  %s: %6d wires %8d segs %8.1f KB"),
+			*Name, Pair.Value.Wires, Pair.Value.Segments, KB((SIZE_T)Pair.Value.Segments * sizeof(FPowerLineSegment)));
+	}
+}
+
+static void PowerLineMemReportCommand(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+{
+	const UPowerLineSubsystem* Sub = World ? World->GetSubsystem<UPowerLineSubsystem>() : nullptr;
+	if (!Sub)
+	{
+		Ar.Log(TEXT("powerline.MemReport: no PowerLine subsystem in this world."));
+		return;
+	}
+
+	int32 MaxChunks = 20;
+	if (Args.Num() > 0)
+	{
+		MaxChunks = Args[0].Equals(TEXT("all"), ESearchCase::IgnoreCase) ? -1 : FCString::Atoi(*Args[0]);
+	}
+
+	Sub->DumpMemoryReport(Ar, MaxChunks);
+}
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GPowerLineMemReportCommand(
+	TEXT("powerline.MemReport"),
+	TEXT("Power line memory per chunk and per district. Usage: powerline.MemReport [MaxChunks|all]"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&PowerLineMemReportCommand));
+
+// ============================
+// Rebuild watchdog
+// ============================
+
+static TAutoConsoleVariable<int32> CVarPowerLineWatchdog(
+	TEXT("powerline.Watchdog"),
+	0,
+	TEXT("Per-wire rebuild timing and dirty-cause tracking (see powerline.DumpWatchdog).\n0: off, 1: on"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarPowerLineWatchdogBudgetMs(
+	TEXT("powerline.Watchdog.BudgetMs"),
+	2.f,
+	TEXT("Warn (at most once per second) when a PowerLine tick exceeds this many ms. Watchdog only."),
+	ECVF_Default);
+
+// Decayed sums are halved this often (rolling window for the top-N lists).
+static constexpr double PowerLineWatchdogWindowSeconds = 10.0;
+
+static FString DescribeWireForWatchdog(const UPowerLineComponent* Line)
+{
+	const AActor* Owner = Line->GetOwner();
+	const AActor* Target = Line->ResolveEffectiveTargetActor();
+	return FString::Printf(TEXT("%s.%s -> %s"),
+		Owner ? *Owner->GetName() : TEXT("<none>"),
+		*Line->GetName(),
+		Target ? *Target->GetName() : TEXT("<manual>"));
+}
+
+static const TCHAR* GetDirtyCauseName(EPowerLineDirtyCause Cause)
+{
+	switch (Cause)
+	{
+	case EPowerLineDirtyCause::Register:        return TEXT("Register");
+	case EPowerLineDirtyCause::OwnTransform:    return TEXT("OwnTransform");
+	case EPowerLineDirtyCause::TargetTransform: return TEXT("TargetTransform");
+	case EPowerLineDirtyCause::District:        return TEXT("District");
+	case EPowerLineDirtyCause::Property:        return TEXT("Property");
+	case EPowerLineDirtyCause::ChunkNeighbour:  return TEXT("ChunkNeighbour");
+	default:                                    return TEXT("Unknown");
+	}
+}
+
+void UPowerLineSubsystem::RecordWireRebuild(UPowerLineComponent* Line, double Ms)
+{
+	FWatchdogEntry& Entry = WatchdogEntries.FindOrAdd(Line);
+	Entry.Ms += Ms;
+	Entry.Rebuilds += 1.f;
+	Entry.MaxMs = FMath::Max(Entry.MaxMs, Ms);
+	Entry.LastCause = Line->LastDirtyCause;
+
+	// Consumed: until the wire is dirtied itself again, its rebuilds come from chunk neighbours.
+	Line->LastDirtyCause = EPowerLineDirtyCause::ChunkNeighbour;
+
+	++WatchdogFrameRebuilds;
+
+	// Keep the 3 slowest wires of this frame for the budget warning.
+	constexpr int32 MaxWorst = 3;
+	if (WatchdogFrameWorst.Num() < MaxWorst || Ms > WatchdogFrameWorst.Last().Value)
+	{
+		WatchdogFrameWorst.Emplace(Line, Ms);
+		WatchdogFrameWorst.Sort([](const auto& A, const auto& B) { return A.Value > B.Value; });
+		if (WatchdogFrameWorst.Num() > MaxWorst)
+		{
+			WatchdogFrameWorst.SetNum(MaxWorst);
+		}
+	}
+}
+
+void UPowerLineSubsystem::UpdateWatchdog(double TickMs)
+{
+	const double Now = FPlatformTime::Seconds();
+	const float BudgetMs = CVarPowerLineWatchdogBudgetMs.GetValueOnGameThread();
+
+	if (BudgetMs > 0.f && TickMs > BudgetMs && (Now - LastBudgetWarningTime) >= 1.0)
+	{
+		LastBudgetWarningTime = Now;
+
+		FString Worst;
+		for (const TPair<TWeakObjectPtr<UPowerLineComponent>, double>& Pair : WatchdogFrameWorst)
+		{
+			if (const UPowerLineComponent* Line = Pair.Key.Get())
+			{
+				const FWatchdogEntry* Entry = WatchdogEntries.Find(Pair.Key);
+				Worst += FString::Printf(TEXT("\n    %.3f ms  %s  [chunk (%d, %d, %d) L%d, %s]"),
+					Pair.Value, *DescribeWireForWatchdog(Line),
+					Line->CurrentKey.Coord.X, Line->CurrentKey.Coord.Y, Line->CurrentKey.Z, (int32)Line->CurrentKey.Level,
+					GetDirtyCauseName(Entry ? Entry->LastCause : EPowerLineDirtyCause::Unknown));
+			}
+		}
+
+		UE_LOG(LogPowerLine, Warning, TEXT("PowerLine tick %.2f ms exceeds budget %.2f ms (%d wires rebuilt, %d dirty chunks left). Slowest wires:%s"),
+			TickMs, BudgetMs, WatchdogFrameRebuilds, DirtyChunks.Num(), *Worst);
+	}
+
+	WatchdogFrameWorst.Reset();
+	WatchdogFrameRebuilds = 0;
+
+	if (Now - WatchdogWindowStart >= PowerLineWatchdogWindowSeconds)
+	{
+		WatchdogWindowStart = Now;
+		for (auto It = WatchdogEntries.CreateIterator(); It; ++It)
+		{
+			FWatchdogEntry& Entry = It->Value;
+			Entry.Ms *= 0.5;
+			Entry.Rebuilds *= 0.5f;
+			Entry.Dirties *= 0.5f;
+			Entry.MaxMs *= 0.5;
+
+			if (!It->Key.IsValid() || (Entry.Rebuilds < 0.05f && Entry.Dirties < 0.05f))
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+}
+
+void UPowerLineSubsystem::DumpWatchdog(FOutputDevice& Ar, int32 TopN) const
+{
+	Ar.Logf(TEXT("==== PowerLine watchdog (%s) ===="), *GetWorld()->GetName());
+	if (CVarPowerLineWatchdog.GetValueOnGameThread() == 0)
+	{
+		Ar.Log(TEXT("  Watchdog is off. Enable with: powerline.Watchdog 1"));
+	}
+
+	Ar.Logf(TEXT("  %d wires tracked, budget %.2f ms, sums halve every %.0f s"),
+		WatchdogEntries.Num(), CVarPowerLineWatchdogBudgetMs.GetValueOnGameThread(), PowerLineWatchdogWindowSeconds);
+
+	TArray<TPair<const UPowerLineComponent*, const FWatchdogEntry*>> Rows;
+	Rows.Reserve(WatchdogEntries.Num());
+	for (const TPair<TWeakObjectPtr<UPowerLineComponent>, FWatchdogEntry>& Pair : WatchdogEntries)
+	{
+		if (const UPowerLineComponent* Line = Pair.Key.Get())
+		{
+			Rows.Emplace(Line, &Pair.Value);
+		}
+	}
+
+	auto PrintRows = [&](const TCHAR* Title) {
+		const int32 Num = (TopN < 0) ? Rows.Num() : FMath::Min(TopN, Rows.Num());
+		Ar.Logf(TEXT("---- %s (top %d of %d) ----"), Title, Num, Rows.Num());
+		Ar.Log(TEXT("      cost ms    avg ms    max ms  rebuilds   dirties   segs  cause            chunk               wire"));
+		for (int32 i = 0; i < Num; ++i)
+		{
+			const UPowerLineComponent* Line = Rows[i].Key;
+			const FWatchdogEntry& E = *Rows[i].Value;
+			const FString Chunk = Line->bDynamic
+				? FString(TEXT("dynamic"))
+				: FString::Printf(TEXT("(%d, %d, %d) L%d"), Line->CurrentKey.Coord.X, Line->CurrentKey.Coord.Y, Line->CurrentKey.Z, (int32)Line->CurrentKey.Level);
+			Ar.Logf(TEXT("  %10.3f %9.3f %9.3f %9.1f %9.1f %6d  %-16s %-19s %s"),
+				E.Ms, E.Rebuilds > 0.f ? E.Ms / E.Rebuilds : 0.0, E.MaxMs, E.Rebuilds, E.Dirties,
+				Line->LastSegmentCount, GetDirtyCauseName(E.LastCause), *Chunk, *DescribeWireForWatchdog(Line));
+		}
+		};
+
+	Rows.Sort([](const auto& A, const auto& B) { return A.Value->Ms > B.Value->Ms; });
+	PrintRows(TEXT("Most expensive wires"));
+
+	Rows.Sort([](const auto& A, const auto& B) { return A.Value->Dirties > B.Value->Dirties; });
+	PrintRows(TEXT("Most frequently dirtied wires"));
+}
+
+static void PowerLineDumpWatchdogCommand(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+{
+	const UPowerLineSubsystem* Sub = World ? World->GetSubsystem<UPowerLineSubsystem>() : nullptr;
+	if (!Sub)
+	{
+		Ar.Log(TEXT("powerline.DumpWatchdog: no PowerLine subsystem in this world."));
+		return;
+	}
+
+	int32 TopN = 10;
+	if (Args.Num() > 0)
+	{
+		TopN = Args[0].Equals(TEXT("all"), ESearchCase::IgnoreCase) ? -1 : FCString::Atoi(*Args[0]);
+	}
+
+	Sub->DumpWatchdog(Ar, TopN);
+}
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GPowerLineDumpWatchdogCommand(
+	TEXT("powerline.DumpWatchdog"),
+	TEXT("Most expensive and most often dirtied wires (needs powerline.Watchdog 1). Usage: powerline.DumpWatchdog [TopN|all]"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&PowerLineDumpWatchdogCommand));
+
+// ============================
+// Debug heatmap
+// ============================
+
+static TAutoConsoleVariable<int32> CVarPowerLineDebugHeatmap(
+	TEXT("powerline.Debug.Heatmap"),
+	0,
+	TEXT("Draw chunk bounds colored by:\n0: off, 1: rebuild frequency, 2: segment count, 3: proxy memory.\nDirty-backlog chunks and oversized wires are labeled."),
+	ECVF_Cheat);
+
+static TAutoConsoleVariable<int32> CVarPowerLineDebugMaxWireSegments(
+	TEXT("powerline.Debug.MaxWireSegments"),
+	64,
+	TEXT("Heatmap: label wires with more segments than this (check FPowerLineSegmentsSettings)."),
+	ECVF_Cheat);
+
+static TAutoConsoleVariable<float> CVarPowerLineDebugHeatmapDistance(
+	TEXT("powerline.Debug.HeatmapDistance"),
+	50000.f,
+	TEXT("Heatmap: only chunks within this distance (cm) of a view are drawn. 0 = all."),
+	ECVF_Cheat);
+
+// Rebuild heat halves every 2 s.
+static constexpr double PowerLineHeatHalfLifeSeconds = 2.0;
+
+static float GetDecayedHeat(const FPowerLineChunk& Chunk, double Now)
+{
+	const double Age = FMath::Max(0.0, Now - Chunk.HeatTime);
+	return Chunk.RebuildHeat * (float)FMath::Pow(0.5, Age / PowerLineHeatHalfLifeSeconds);
+}
+
+FBox UPowerLineSubsystem::GetChunkCellBox(const FPowerLineChunkKey& Key) const
+{
+	const float CS = FMath::Max(1.f, ChunkSize) / (float)(1 << Key.Level);
+	const FVector Min(Key.Coord.X * CS, Key.Coord.Y * CS, Key.Z * CS);
+
+	FBox Box(Min, Min + FVector(CS, CS, 0.f));
+
+	// Vertically split cells span their own Z slab.
+	if (Key.Level > 0 && bAdaptiveVertical)
+	{
+		Box.Max.Z = Min.Z + CS;
+		return Box;
+	}
+
+	// Height from the batched segments (grid cells are 2D unless split vertically).
+	if (const TWeakObjectPtr<UPowerLineRenderComponent>* RCW = RenderComponents.Find(Key))
+	{
+		if (const UPowerLineRenderComponent* RC = RCW->Get())
+		{
+			const FBox SegBox = RC->CachedBounds.GetBox();
+			Box.Min.Z = SegBox.Min.Z;
+			Box.Max.Z = SegBox.Max.Z;
+		}
+	}
+
+	return Box;
+}
+
+void UPowerLineSubsystem::DrawDebugHeatmap(int32 Mode) const
+{
+#if ENABLE_DRAW_DEBUG
+	UWorld* World = GetWorld();
+	if (!World) return;
+
+	const double Now = FPlatformTime::Seconds();
+	const float MaxDist = CVarPowerLineDebugHeatmapDistance.GetValueOnGameThread();
+	const int32 MaxWireSegments = CVarPowerLineDebugMaxWireSegments.GetValueOnGameThread();
+
+	auto IsNearView = [&](const FBox& Box) {
+		if (MaxDist <= 0.f || World->ViewLocationsRenderedLastFrame.Num() == 0) return true;
+		for (const FVector& View : World->ViewLocationsRenderedLastFrame)
+		{
+			if (Box.ComputeSquaredDistanceToPoint(View) <= FMath::Square(MaxDist)) return true;
+		}
+		return false;
+		};
+
+	auto GetValue = [&](const FPowerLineChunkKey& Key, const FPowerLineChunk& Chunk) -> double {
+		switch (Mode)
+		{
+		case 1: return GetDecayedHeat(Chunk, Now);
+		case 2: return (double)Chunk.BatchedSegments.Num();
+		default:
+		{
+			const TWeakObjectPtr<UPowerLineRenderComponent>* RCW = RenderComponents.Find(Key);
+			return (double)GetRenderComponentBytes(RCW ? RCW->Get() : nullptr) / 1024.0;
+		}
+		}
+		};
+
+	// Normalize against the hottest visible chunk.
+	struct FVisibleChunk
+	{
+		const FPowerLineChunkKey* Key;
+		const FPowerLineChunk* Chunk;
+		FBox Box;
+		double Value;
+	};
+
+	TArray<FVisibleChunk> Visible;
+	double MaxValue = 0.0;
+	for (const TPair<FPowerLineChunkKey, FPowerLineChunk>& Pair : Chunks)
+	{
+		const FBox Box = GetChunkCellBox(Pair.Key);
+		if (!IsNearView(Box)) continue;
+
+		const double Value = GetValue(Pair.Key, Pair.Value);
+		MaxValue = FMath::Max(MaxValue, Value);
+		Visible.Add({ &Pair.Key, &Pair.Value, Box, Value });
+	}
+
+	static const TCHAR* ModeUnits[] = { TEXT(""), TEXT("rebuilds"), TEXT("segs"), TEXT("KB") };
+	const TCHAR* Unit = ModeUnits[FMath::Clamp(Mode, 1, 3)];
+
+	for (const FVisibleChunk& V : Visible)
+	{
+		const float Alpha = MaxValue > 0.0 ? (float)(V.Value / MaxValue) : 0.f;
+		const FColor Color = FLinearColor::LerpUsingHSV(FLinearColor::Green, FLinearColor::Red, Alpha).ToFColor(true);
+		const bool bBacklog = DirtyChunks.Contains(*V.Key);
+
+		DrawDebugBox(World, V.Box.GetCenter(), V.Box.GetExtent(), Color, false, -1.f, SDPG_World, bBacklog ? 40.f : 15.f);
+
+		const FString Label = FString::Printf(TEXT("(%d, %d, %d) L%d\n%.1f %s  %d wires%s"),
+			V.Key->Coord.X, V.Key->Coord.Y, V.Key->Z, (int32)V.Key->Level,
+			V.Value, Unit, V.Chunk->Lines.Num(), bBacklog ? TEXT("\nDIRTY BACKLOG") : TEXT(""));
+		DrawDebugString(World, FVector(V.Box.GetCenter().X, V.Box.GetCenter().Y, V.Box.Max.Z), Label, nullptr, bBacklog ? FColor::Yellow : Color, 0.f, true);
+
+		// Wires whose segmentation looks misconfigured.
+		for (const TWeakObjectPtr<UPowerLineComponent>& WLine : V.Chunk->Lines)
+		{
+			const UPowerLineComponent* Line = WLine.Get();
+			if (!Line || Line->LastSegmentCount <= MaxWireSegments) continue;
+
+			FVector EndWS;
+			const FVector StartWS = Line->GetComponentLocation();
+			const FVector Mid = Line->ResolveEndPoint(EndWS) ? (StartWS + EndWS) * 0.5f : StartWS;
+			const APowerLineDistrictDataManager* DM = Line->ResolveDistrictManager();
+
+			DrawDebugString(World, Mid,
+				FString::Printf(TEXT("%s: %d segs (%s)"), *Line->GetName(), Line->LastSegmentCount,
+					DM ? *DM->DistrictId.ToString() : TEXT("no district")),
+				nullptr, FColor::Magenta, 0.f, true);
+		}
+	}
+#endif
+}
+
+void UPowerLineSubsystem::RemoveLineFromChunk(UPowerLineComponent* Line)
+{
+	if (!Line || !Line->bHasKey) return;
+
+	if (FPowerLineChunk* Old = Chunks.Find(Line->CurrentKey))
+	{
+		const int32 Idx = Line->ChunkIndex;
+		if (Old->Lines.IsValidIndex(Idx) && Old->Lines[Idx].Get() == Line)
+		{
+			Old->Lines.RemoveAtSwap(Idx);
+			if (Old->Lines.IsValidIndex(Idx))
+			{
+				if (UPowerLineComponent* Swapped = Old->Lines[Idx].Get())
+				{
+					Swapped->ChunkIndex = Idx;
+				}
+			}
+		}
+		DirtyChunks.Add(Line->CurrentKey);
+	}
+
+	Line->ChunkIndex = INDEX_NONE;
+	Line->bHasKey = false;
+}
+
+void UPowerLineSubsystem::UpdateLineChunk(UPowerLineComponent* Line, const FPowerLineChunkKey& NewKey)
+{
+	if (!Line) return;
+
+	LLM_SCOPE_BYTAG(PowerLine_Chunks);
+
+	// remove from old
+	RemoveLineFromChunk(Line);
+
+	// add to new
+	{
+		FPowerLineChunk& Chunk = Chunks.FindOrAdd(NewKey);
+		Line->ChunkIndex = Chunk.Lines.Add(Line);
+		DirtyChunks.Add(NewKey);
+	}
+
+	Line->CurrentKey = NewKey;
+	Line->bHasKey = true;
+	Line->bRegistered = true;
+}
+
+void UPowerLineSubsystem::RegisterPowerLine(UPowerLineComponent* Line)
+{
+	if (!Line) return;
+
+	// Runtime style kept from an earlier registration: count it again, unless its slot was released meanwhile.
+	const int32 Style = Line->StyleOverride;
+	if (Style != INDEX_NONE && !Line->bRegistered)
+	{
+		const bool bSlotValid = StyleSlots.IsValidIndex(Style) && StyleSlots[Style].bLive && !StyleSlots[Style].bReleased
+			&& StyleSlots[Style].Serial == Line->StyleOverrideSerial;
+		if (bSlotValid)
+		{
+			AddStyleUser(Style);
+		}
+		else
+		{
+			Line->StyleOverride = INDEX_NONE;
+			Line->StyleOverrideSerial = 0;
+			ReplicateWireState(Line);
+		}
+	}
+
+	UpdateWireConnection(Line);
+
+	if (Line->WireMobility == EPowerLineWireMobility::Dynamic && !IsHeadless())
+	{
+		PromoteToDynamic(Line);
+		return;
+	}
+
+	const FPowerLineChunkKey Key = CalcKey(Line->GetComponentLocation());
+	UpdateLineChunk(Line, Key);
+	MarkPowerLineDirty(Line, EPowerLineDirtyCause::Register);
+}
+
+void UPowerLineSubsystem::UnregisterPowerLine(UPowerLineComponent* Line)
+{
+	if (!Line) return;
+
+	HeadlessDirtyLines.Remove(Line);
+
+	if (Line->SimIndex != INDEX_NONE)
+	{
+		RemoveFromSimulation(Line->SimIndex);
+	}
+
+	RemoveHangingForLine(Line);
+	RemoveLineFromChunk(Line);
+	RemoveFromDynamic(Line);
+	RemoveWireConnection(Line);
+	ReleaseSharedStyle(Line->HeldSharedStyle);
+
+	// The override itself is kept for re-registration; only its slot user goes.
+	if (Line->bRegistered)
+	{
+		RemoveStyleUser(Line->StyleOverride);
+	}
+
+	Line->bRegistered = false;
+
+	// Re-registration keeps the replicated state (connection overrides), destruction drops it.
+	if (APowerLineNetState* State = NetState.Get())
+	{
+		if (Line->IsBeingDestroyed())
+		{
+			State->RemoveWire(Line);
+		}
+	}
+}
+
+void UPowerLineSubsystem::MarkPowerLineDirty(UPowerLineComponent* Line, EPowerLineDirtyCause Cause)
+{
+	if (!Line) return;
+
+	Line->LastDirtyCause = Cause;
+
+	// Counted when the batch flushes back through here.
+	if (BatchEditDepth > 0)
+	{
+		DeferredDirty.Add(Line, Cause);
+		return;
+	}
+
+	if (CVarPowerLineWatchdog.GetValueOnGameThread() != 0)
+	{
+		FWatchdogEntry& Entry = WatchdogEntries.FindOrAdd(Line);
+		Entry.Dirties += 1.f;
+		Entry.LastCause = Cause;
+	}
+
+	if (IsHeadless())
+	{
+		// Only the wire itself is re-resolved; chunks are touched just for membership changes.
+		const FPowerLineChunkKey Key = CalcKey(Line->GetComponentLocation());
+		if (!Line->bHasKey || !(Line->CurrentKey == Key))
+		{
+			UpdateLineChunk(Line, Key);
+		}
+		HeadlessDirtyLines.Add(Line);
+		return;
+	}
+
+	// Dynamic wires never touch static chunks.
+	if (Line->bDynamic)
+	{
+		bDynamicDirty = true;
+		return;
+	}
+
+	const FPowerLineChunkKey NewKey = CalcKey(Line->GetComponentLocation());
+
+	// Move between chunks if needed
+	if (!Line->bHasKey || !(Line->CurrentKey == NewKey))
+	{
+		UpdateLineChunk(Line, NewKey);
+	}
+
+	DirtyChunks.Add(Line->CurrentKey);
+}
+
+void UPowerLineSubsystem::MarkPowerLineMoved(UPowerLineComponent* Line, EPowerLineDirtyCause Cause)
+{
+	if (!Line) return;
+
+	// No dynamic buffer without rendering.
+	if (IsHeadless())
+	{
+		MarkPowerLineDirty(Line, Cause);
+		return;
+	}
+
+	if (Line->WireMobility == EPowerLineWireMobility::Auto && !Line->bDynamic && Line->bRegistered)
+	{
+		// Count at most one move per frame (a single move can fire several transform updates).
+		if (Line->LastMoveFrame != GFrameCounter)
+		{
+			const double Now = FPlatformTime::Seconds();
+			const bool bRecent = (Now - Line->LastMoveTime) <= DynamicMotionWindowSeconds;
+			Line->RecentMoveCount = bRecent ? (Line->RecentMoveCount + 1) : 1;
+			Line->LastMoveTime = Now;
+			Line->LastMoveFrame = GFrameCounter;
+
+			if (Line->RecentMoveCount >= DynamicPromoteMoveCount && Line->CanEverMove())
+			{
+				PromoteToDynamic(Line);
+				return;
+			}
+		}
+	}
+	else if (Line->bDynamic)
+	{
+		Line->LastMoveTime = FPlatformTime::Seconds();
+		Line->LastMoveFrame = GFrameCounter;
+	}
+
+	MarkPowerLineDirty(Line, Cause);
+}
+
+void UPowerLineSubsystem::PromoteToDynamic(UPowerLineComponent* Line)
+{
+	if (!Line || Line->bDynamic) return;
+
+	// Moving endpoints win over the simulation tier.
+	if (Line->SimIndex != INDEX_NONE)
+	{
+		RemoveFromSimulation(Line->SimIndex);
+	}
+
+	// Leaving the static chunk costs one rebuild of it; after that it stays untouched.
+	RemoveLineFromChunk(Line);
+
+	Line->bDynamic = true;
+	Line->DynamicIndex = DynamicLines.Add(Line);
+	Line->bRegistered = true;
+	Line->LastMoveTime = FPlatformTime::Seconds();
+	Line->ResetDynamicDistrictCache();
+
+	bDynamicDirty = true;
+}
+
+void UPowerLineSubsystem::RemoveFromDynamic(UPowerLineComponent* Line)
+{
+	if (!Line || !Line->bDynamic) return;
+
+	const int32 Idx = Line->DynamicIndex;
+	if (DynamicLines.IsValidIndex(Idx) && DynamicLines[Idx].Get() == Line)
+	{
+		DynamicLines.RemoveAtSwap(Idx);
+		if (DynamicLines.IsValidIndex(Idx))
+		{
+			if (UPowerLineComponent* Swapped = DynamicLines[Idx].Get())
+			{
+				Swapped->DynamicIndex = Idx;
+			}
+		}
+	}
+
+	Line->bDynamic = false;
+	Line->DynamicIndex = INDEX_NONE;
+	Line->RecentMoveCount = 0;
+	Line->ResetDynamicDistrictCache();
+
+	bDynamicDirty = true;
+}
+
+void UPowerLineSubsystem::DemoteToStatic(UPowerLineComponent* Line)
+{
+	if (!Line || !Line->bDynamic) return;
+
+	RemoveFromDynamic(Line);
+	UpdateLineChunk(Line, CalcKey(Line->GetComponentLocation()));
+}
+
+void UPowerLineSubsystem::GetShapeCacheStats(int64& OutHits, int64& OutMisses, int64& OutBypassed, int32& OutEntries) const
+{
+	OutHits = (int64)ShapeCache.Hits;
+	OutMisses = (int64)ShapeCache.Misses;
+	OutBypassed = (int64)ShapeCache.Bypassed;
+	OutEntries = ShapeCache.Num();
+}
+
+void UPowerLineSubsystem::ResetShapeCache()
+{
+	ShapeCache.Reset();
+}
+
+void UPowerLineSubsystem::GetShapeInstances(TArray<FPowerLineShapeInstance>& Out) const
+{
+	Out.Reset();
+	for (const TPair<FPowerLineChunkKey, FPowerLineChunk>& Pair : Chunks)
+	{
+		for (const TWeakObjectPtr<UPowerLineComponent>& WLine : Pair.Value.Lines)
+		{
+			const UPowerLineComponent* Line = WLine.Get();
+			if (!Line || !Line->bHasResolvedSpan || Line->SimIndex != INDEX_NONE) continue;
+
+			// Cleared when the curve is changed in place (sag rescale, break): those wires are drawn from segments.
+			const FPowerLineWireBuild& Span = Line->ResolvedSpan;
+			if (!Span.Shape || Span.Shape->Points.Num() < 2) continue;
+
+			FPowerLineShapeInstance& Inst = Out.AddDefaulted_GetRef();
+			Inst.Shape = Span.Shape;
+			Inst.Offset = Span.Start;
+			Inst.Skew = Span.GetShapeSkew();
+			Inst.Style = Span.Style;
+			Inst.Wire = WLine;
+		}
+	}
+
+	Out.Sort([](const FPowerLineShapeInstance& A, const FPowerLineShapeInstance& B) { return A.Shape->ShapeId < B.Shape->ShapeId; });
+}
+
+void UPowerLineSubsystem::RemoveHangingForLine(UPowerLineComponent* Line)
+{
+	if (!Line) return;
+
+	if (TWeakObjectPtr<UStaticMeshComponent>* C = HangingByLine.Find(Line))
+	{
+		DestroyHangingComponent(C->Get());
+		HangingByLine.Remove(Line);
+	}
+}
+
+void UPowerLineSubsystem::DestroyHangingComponent(UStaticMeshComponent* Comp)
+{
+	if (!Comp) return;
+
+	if (UStaticMesh* Mesh = Comp->GetStaticMesh())
+	{
+		ReleaseMeshUser(FSoftObjectPath(Mesh));
+	}
+	Comp->DestroyComponent();
+}
+
+void UPowerLineSubsystem::UpdateHangingForLine(UPowerLineComponent* Line)
+{
+	if (IsHeadless()) return;
+
+	if (!Line) return;
+
+	POWERLINE_SCOPE(PowerLine_UpdateHanging);
+	LLM_SCOPE_BYTAG(PowerLine_Hanging);
+
+	// Whatever hung on a cut wire has fallen off.
+	if (Line->IsBroken())
+	{
+		RemoveHangingForLine(Line);
+		return;
+	}
+
+	APowerLineDistrictDataManager* DM = Line->ResolveDistrictManager();
+	if (!DM)
+	{
+		RemoveHangingForLine(Line);
+		return;
+	}
+
+	FVector EndWS;
+	if (!Line->ResolveEndPoint(EndWS))
+	{
+		RemoveHangingForLine(Line);
+		return;
+	}
+
+	TSoftObjectPtr<UStaticMesh> SoftMesh;
+	float N = 0.5f;
+	float YawDeg = 0.f;
+
+	if (!DM->GetHangingAssetForLine(Line->GetComponentLocation(), EndWS, Line->LineId, SoftMesh, N, YawDeg))
+	{
+		RemoveHangingForLine(Line);
+		return;
+	}
+
+	// Not streamed in yet: placed when the load completes.
+	UStaticMesh* Mesh = RequestMesh(SoftMesh, Line);
+	if (!Mesh)
+	{
+		RemoveHangingForLine(Line);
+		return;
+	}
+
+	AActor* Host = EnsureRenderHost();
+	if (!Host) return;
+
+	UStaticMeshComponent* Comp = nullptr;
+	if (TWeakObjectPtr<UStaticMeshComponent>* Existing = HangingByLine.Find(Line))
+	{
+		Comp = Existing->Get();
+	}
+	if (!Comp)
+	{
+		Comp = NewObject<UStaticMeshComponent>(Host);
+		Comp->SetupAttachment(Host->GetRootComponent());
+		Comp->RegisterComponent();
+		HangingByLine.Add(Line, Comp);
+	}
+
+	if (Comp->GetStaticMesh() != Mesh)
+	{
+		if (UStaticMesh* OldMesh = Comp->GetStaticMesh())
+		{
+			ReleaseMeshUser(FSoftObjectPath(OldMesh));
+		}
+		AddMeshUser(Mesh);
+		Comp->SetStaticMesh(Mesh);
+	}
+	Comp->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	Comp->SetGenerateOverlapEvents(false);
+
+	// Place along wire, accounting for sag at sample point N.
+	FVector StartWS = Line->GetComponentLocation();
+
+	// Same sag the wire is drawn with (hashed from the centre line, shared by all conductors).
+	const float EffectiveSag = Line->bHasResolvedSpan ? Line->ResolvedSpan.Sag : DM->GetSagForLine(StartWS, EndWS, Line->LineId);
+
+	// Bundles: hang from the first conductor (the centre line carries no wire).
+	if (Line->bHasResolvedSpan && Line->ResolvedSpan.Bundle && Line->ResolvedSpan.Bundle->StartOffsets.Num() > 0)
+	{
+		StartWS += Line->ResolvedSpan.Bundle->StartOffsets[0];
+		EndWS += Line->ResolvedSpan.Bundle->EndOffsets[0];
+	}
+
+	const FVector Pos = FMath::Lerp(StartWS, EndWS, N);
+	const float SagFactor = FMath::Clamp(4.f * N * (1.f - N), 0.f, 1.f);
+	const FVector SaggedPos = Pos - FVector(0, 0, EffectiveSag * SagFactor);
+
+	// Rotate around tangent
+	const FVector Tangent = (EndWS - StartWS).GetSafeNormal();
+	const FRotator Rot = FRotationMatrix::MakeFromX(Tangent).Rotator() + FRotator(0.f, YawDeg, 0.f);
+
+	FTransform T;
+	T.SetLocation(SaggedPos - FVector(0, 0, DM->Hanging.DownOffsetCm));
+	T.SetRotation(Rot.Quaternion());
+	T.SetScale3D(FVector(1));
+
+	Comp->SetWorldTransform(T);
+}
+
+// ============================
+// Headless (dedicated server)
+// ============================
+
+bool UPowerLineSubsystem::IsHeadless() const
+{
+	switch (HeadlessMode)
+	{
+	case EPowerLineHeadlessMode::Always: return true;
+	case EPowerLineHeadlessMode::Never:  return false;
+	default: break;
+	}
+
+	if (IsRunningDedicatedServer() || !FApp::CanEverRender())
+	{
+		return true;
+	}
+
+	const UWorld* World = GetWorld();
+	return World && World->GetNetMode() == NM_DedicatedServer;
+}
+
+void UPowerLineSubsystem::UpdateHeadlessLines()
+{
+	POWERLINE_SCOPE(PowerLine_RebuildChunks);
+	const bool bWatchdog = CVarPowerLineWatchdog.GetValueOnGameThread() != 0;
+
+	for (const TWeakObjectPtr<UPowerLineComponent>& WLine : HeadlessDirtyLines)
+	{
+		UPowerLineComponent* Line = WLine.Get();
+		if (!Line || !Line->bRegistered) continue;
+
+		const uint64 WireStart = bWatchdog ? FPlatformTime::Cycles64() : 0;
+		Line->bHasResolvedSpan = Line->ResolveBuildInputs(Line->ResolvedSpan);
+		if (Line->bHasResolvedSpan)
+		{
+			ResolveBuildResources(Line, Line->ResolvedSpan);
+		}
+		Line->LastSegmentCount = 0;
+		INC_DWORD_STAT(STAT_PowerLine_WiresRebuilt);
+
+		if (bEnableWireQueries && Line->ChunkIndex != INDEX_NONE)
+		{
+			QueryDirtyChunks.Add(Line->CurrentKey);
+		}
+
+		if (bWatchdog)
+		{
+			RecordWireRebuild(Line, FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - WireStart));
+		}
+	}
+
+	HeadlessDirtyLines.Reset();
+}
+
+void UPowerLineSubsystem::RebuildDirtyChunksHeadless()
+{
+	// Membership only: drop dead wires and track empty chunks for reclaim.
+	for (const FPowerLineChunkKey& Key : DirtyChunks)
+	{
+		FPowerLineChunk* Chunk = Chunks.Find(Key);
+		if (!Chunk) continue;
+
+		if (bEnableWireQueries)
+		{
+			QueryDirtyChunks.Add(Key);
+		}
+
+		for (int32 i = Chunk->Lines.Num() - 1; i >= 0; --i)
+		{
+			if (Chunk->Lines[i].IsValid()) continue;
+
+			Chunk->Lines.RemoveAtSwap(i);
+			if (Chunk->Lines.IsValidIndex(i))
+			{
+				if (UPowerLineComponent* Swapped = Chunk->Lines[i].Get())
+				{
+					Swapped->ChunkIndex = i;
+				}
+			}
+		}
+
+		if (Chunk->Lines.Num() == 0)
+		{
+			if (Chunk->EmptySince <= 0.0)
+			{
+				Chunk->EmptySince = FPlatformTime::Seconds();
+			}
+			EmptyChunks.Add(Key);
+		}
+		else
+		{
+			Chunk->EmptySince = 0.0;
+		}
+	}
+
+	DirtyChunks.Reset();
+}
+
+// ============================
+// Subsystem - Wind
+// ============================
+
+void UPowerLineSubsystem::SetWind(const FPowerLineWindSettings& NewWind)
+{
+	Wind = NewWind;
+	PushWindToRenderComponents();
+}
+
+void UPowerLineSubsystem::PushWindToRenderComponents()
+{
+	PowerLineCore::FWindParams Params;
+	const FVector Dir = FVector(Wind.Direction.X, Wind.Direction.Y, 0.f).GetSafeNormal();
+	Params.Direction = FVector3f(Dir.IsNearlyZero() ? FVector::ForwardVector : Dir);
+	Params.Strength = FMath::Max(0.f, Wind.Strength);
+	Params.Frequency = FMath::Max(0.f, Wind.FrequencyHz);
+	Params.Gust = FMath::Clamp(Wind.Gust, 0.f, 1.f);
+
+	// District scales edited since last frame (a handful of groups): only the palette entry changes.
+	float MaxScale = 1.f;
+	for (int32 Group = 1; Group < WindGroupDistricts.Num(); ++Group)
+	{
+		if (const APowerLineDistrictDataManager* District = WindGroupDistricts[Group].Get())
+		{
+			const float Scale = FMath::Max(0.f, District->WindScale);
+			if (Scale != PushedWindScales[Group])
+			{
+				PushedWindScales[Group] = Scale;
+				PushWindScale(Group);
+			}
+		}
+		MaxScale = FMath::Max(MaxScale, PushedWindScales[Group]);
+	}
+
+	if (Params == PushedWind && MaxScale == PushedMaxWindScale) return;
+	PushedWind = Params;
+	PushedMaxWindScale = MaxScale;
+
+	// Chunk, dynamic and multi-pole render components of this world.
+	const UWorld* World = GetWorld();
+	for (TObjectIterator<UPowerLineRenderComponent> It; It; ++It)
+	{
+		if (It->GetWorld() == World && It->IsRegistered())
+		{
+			It->SetWind_GameThread(PushedWind, PushedMaxWindScale);
+		}
+	}
+}
+
+uint16 UPowerLineSubsystem::ResolveWindGroup(APowerLineDistrictDataManager* District)
+{
+	if (!District) return 0;
+
+	if (const uint16* Found = WindGroups.Find(District))
+	{
+		return *Found;
+	}
+
+	// Groups are never reused: wires of a destroyed district keep its last scale until they are rebuilt.
+	if (WindGroupDistricts.Num() == 0)
+	{
+		WindGroupDistricts.Add(nullptr);
+	}
+	if (WindGroupDistricts.Num() > MAX_uint16) return 0;
+
+	const uint16 Group = (uint16)WindGroupDistricts.Num();
+	WindGroupDistricts.Add(District);
+	PushedWindScales.Add(FMath::Max(0.f, District->WindScale));
+	WindGroups.Add(District, Group);
+	PushWindScale(Group);
+	return Group;
+}
+
+void UPowerLineSubsystem::PushWindScale(int32 Group)
+{
+	if (IsHeadless()) return;
+
+	// Enqueued before the segments that reference the group are uploaded (same as PushStyle).
+	const float Scale = PushedWindScales[Group];
+	ENQUEUE_RENDER_COMMAND(PowerLine_SetWindScale)(
+		[Palette = StylePaletteRT, Group, Scale](FRHICommandListImmediate& RHICmdList) {
+			while (Palette->WindScales.Num() <= Group)
+			{
+				Palette->WindScales.Add(1.f);
+			}
+			Palette->WindScales[Group] = Scale;
+		});
+}
+
+// ============================
+// Subsystem - Sag rescale
+// ============================
+
+// Sag is a pure vertical offset Sag * 4t(1-t), so the chord parameter t of a curve point is recovered
+// from XY alone and a sag change is one vertical offset per point. Start/End are the attachments of this one
+// curve (a bundle conductor's own, not the centre line). False for (near) vertical wires: rebuild those.
+static bool RescaleSegmentSag(TArrayView<FPowerLineSegment> Segs, const FVector& Start, const FVector& End, float DeltaSag, uint16 WindAmplitude)
+{
+	const FVector2D Chord = FVector2D(End - Start);
+	const double ChordLenSq = Chord.SizeSquared();
+	if (ChordLenSq <= KINDA_SMALL_NUMBER) return false;
+
+	const double InvLenSq = 1.0 / ChordLenSq;
+	auto Offset = [&](const FVector& P) {
+		const double T = FMath::Clamp(FVector2D::DotProduct(FVector2D(P - Start), Chord) * InvLenSq, 0.0, 1.0);
+		return DeltaSag * 4.0 * T * (1.0 - T);
+		};
+
+	for (FPowerLineSegment& S : Segs)
+	{
+		S.Start.Z -= Offset(S.Start);
+		S.End.Z -= Offset(S.End);
+		S.Wind.Amplitude = WindAmplitude;
+	}
+	return true;
+}
+
+bool UPowerLineSubsystem::RescaleDistrictSag(APowerLineDistrictDataManager* District, float OldScale, float NewScale)
+{
+	if (!District || OldScale <= KINDA_SMALL_NUMBER || BatchEditDepth > 0) return false;
+
+	POWERLINE_SCOPE(PowerLine_RescaleSag);
+	LLM_SCOPE_BYTAG(PowerLine_Segments);
+
+	const float Ratio = NewScale / OldScale;
+	const bool bHeadless = IsHeadless();
+
+	for (TPair<FPowerLineChunkKey, FPowerLineChunk>& Pair : Chunks)
+	{
+		FPowerLineChunk& Chunk = Pair.Value;
+
+		// Pending rebuilds pick the new scale up anyway (and their ranges may be stale).
+		const bool bRebuildPending = DirtyChunks.Contains(Pair.Key);
+		bool bTouched = false;
+		bool bNeedsRebuild = false;
+		TArray<FVector> Scratch;
+		TArray<FPowerLineSegment> Reemitted;
+
+		for (const TWeakObjectPtr<UPowerLineComponent>& WLine : Chunk.Lines)
+		{
+			UPowerLineComponent* Line = WLine.Get();
+			if (!Line || !Line->bHasResolvedSpan || Line->ResolvedSpan.District.Get() != District) continue;
+
+			FPowerLineWireBuild& Span = Line->ResolvedSpan;
+			const float DeltaSag = Span.Sag * (Ratio - 1.f);
+			Span.Sag *= Ratio;
+			Span.Shape.Reset();
+			bTouched = true;
+
+			if (bHeadless || bRebuildPending || Line->SimIndex != INDEX_NONE) continue;
+
+			const int32 First = Line->SegmentFirst;
+			const int32 Count = Line->LastSegmentCount;
+			if (First < 0 || Count <= 0 || First + Count > Chunk.BatchedSegments.Num()) continue;
+
+			// Dangling pieces are not a sag curve (and their lengths follow the sag): re-emit them.
+			if (Line->IsBroken())
+			{
+				Reemitted.Reset();
+				Span.Emit(Scratch, Reemitted);
+				if (Reemitted.Num() != Count)
+				{
+					bNeedsRebuild = true;
+					continue;
+				}
+				for (int32 i = 0; i < Count; ++i)
+				{
+					Chunk.BatchedSegments[First + i] = Reemitted[i];
+				}
+				continue;
+			}
+
+			// Bundles: each conductor is its own sag curve between its own attachments (the centre chord would
+			// recover the wrong curve parameter for offset conductors).
+			const uint16 WindAmplitude = PowerLineCore::PackWindAttributes(0.f, 0.f, 0, FMath::Abs(Span.Sag)).Amplitude;
+			const int32 NumConductors = Span.Bundle ? Span.Bundle->StartOffsets.Num() : 1;
+			if (NumConductors <= 0 || Count % NumConductors != 0)
+			{
+				bNeedsRebuild = true;
+				continue;
+			}
+
+			const int32 PerConductor = Count / NumConductors;
+			bool bRescaled = true;
+			for (int32 c = 0; c < NumConductors && bRescaled; ++c)
+			{
+				const FVector ConductorStart = Span.Bundle ? Span.Start + Span.Bundle->StartOffsets[c] : Span.Start;
+				const FVector ConductorEnd = Span.Bundle ? Span.End + Span.Bundle->EndOffsets[c] : Span.End;
+				bRescaled = RescaleSegmentSag(TArrayView<FPowerLineSegment>(Chunk.BatchedSegments.GetData() + First + c * PerConductor, PerConductor),
+					ConductorStart, ConductorEnd, DeltaSag, WindAmplitude);
+			}
+			if (!bRescaled)
+			{
+				bNeedsRebuild = true;
+				continue;
+			}
+
+			if (HangingByLine.Contains(Line))
+			{
+				UpdateHangingForLine(Line);
+			}
+		}
+
+		if (!bTouched) continue;
+
+		if (bEnableWireQueries)
+		{
+			QueryDirtyChunks.Add(Pair.Key);
+		}
+
+		if (bHeadless || bRebuildPending) continue;
+
+		if (bNeedsRebuild)
+		{
+			DirtyChunks.Add(Pair.Key);
+			continue;
+		}
+
+		if (TWeakObjectPtr<UPowerLineRenderComponent>* RCW = RenderComponents.Find(Pair.Key))
+		{
+			if (UPowerLineRenderComponent* RC = RCW->Get())
+			{
+				RC->UpdateSegments_GameThread(Chunk.BatchedSegments);
+			}
+		}
+	}
+
+	// Dynamic wires resolve their district policy on every rebuild.
+	for (const TWeakObjectPtr<UPowerLineComponent>& WLine : DynamicLines)
+	{
+		const UPowerLineComponent* Line = WLine.Get();
+		if (Line && Line->bHasResolvedSpan && Line->ResolvedSpan.District.Get() == District)
+		{
+			bDynamicDirty = true;
+			break;
+		}
+	}
+
+	return true;
+}
+
+// ============================
+// Subsystem - Breaks
+// ============================
+
+bool UPowerLineSubsystem::BreakWire(UPowerLineComponent* Line, float BreakT)
+{
+	if (!Line) return false;
+
+	const float T = FMath::Clamp(BreakT, 0.01f, 0.99f);
+	if (Line->IsBroken() && FMath::IsNearlyEqual(Line->BreakT, T)) return true;
+
+	POWERLINE_SCOPE(PowerLine_BreakWire);
+	LLM_SCOPE_BYTAG(PowerLine_Segments);
+
+	// Simulated wires go back to their static range first (the cut pieces are not simulated).
+	if (Line->SimIndex != INDEX_NONE)
+	{
+		RemoveFromSimulation(Line->SimIndex);
+	}
+
+	Line->BreakT = T;
+	TraceBreakGround(Line);
+	RemoveWireConnection(Line);
+	RemoveHangingForLine(Line);
+	UpdateWireInPlace(Line);
+	ReplicateWireState(Line);
+	return true;
+}
+
+bool UPowerLineSubsystem::ReconnectWire(UPowerLineComponent* Line)
+{
+	if (!Line || !Line->IsBroken()) return false;
+
+	POWERLINE_SCOPE(PowerLine_BreakWire);
+	LLM_SCOPE_BYTAG(PowerLine_Segments);
+
+	Line->BreakT = -1.f;
+
+	// Unregistered wires (streamed out) get their edge and hanging mesh back on registration.
+	if (Line->bRegistered)
+	{
+		UpdateWireConnection(Line);
+		UpdateWireInPlace(Line);
+
+		if (Line->bHasResolvedSpan)
+		{
+			UpdateHangingForLine(Line);
+		}
+	}
+
+	ReplicateWireState(Line);
+	return true;
+}
+
+void UPowerLineSubsystem::TraceBreakGround(UPowerLineComponent* Line) const
+{
+	Line->BreakGroundZ[0] = -MAX_flt;
+	Line->BreakGroundZ[1] = -MAX_flt;
+
+	UWorld* World = GetWorld();
+	FVector End;
+	if (!World || !Line->ResolveEndPoint(End)) return;
+
+	// Nothing hangs lower than the wire is long.
+	const FVector Start = Line->GetComponentLocation();
+	const float Reach = FVector::Dist(Start, End) + FMath::Abs(Line->bHasResolvedSpan ? Line->ResolvedSpan.Sag : 0.f);
+
+	// The poles themselves are not ground.
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(PowerLineBreakGround), false, Line->GetOwner());
+	Params.AddIgnoredActor(Line->ResolveEffectiveTargetActor());
+
+	const FVector Anchors[2] = { Start, End };
+	for (int32 i = 0; i < 2; ++i)
+	{
+		FHitResult Hit;
+		if (World->LineTraceSingleByChannel(Hit, Anchors[i], Anchors[i] - FVector(0.f, 0.f, Reach), ECC_WorldStatic, Params))
+		{
+			Line->BreakGroundZ[i] = Hit.ImpactPoint.Z;
+		}
+	}
+}
+
+void UPowerLineSubsystem::UpdateWireInPlace(UPowerLineComponent* Line)
+{
+	if (!Line->bRegistered || !Line->bHasResolvedSpan) return;
+
+	FPowerLineWireBuild& Span = Line->ResolvedSpan;
+	Span.BreakT = Line->BreakT;
+	Span.BreakGroundZ[0] = Line->BreakGroundZ[0];
+	Span.BreakGroundZ[1] = Line->BreakGroundZ[1];
+	Span.Shape.Reset();
+
+	if (IsHeadless())
+	{
+		if (bEnableWireQueries && Line->ChunkIndex != INDEX_NONE)
+		{
+			QueryDirtyChunks.Add(Line->CurrentKey);
+		}
+		return;
+	}
+
+	if (Line->bDynamic)
+	{
+		bDynamicDirty = true;
+		bDynamicQueryDirty = bEnableWireQueries;
+		return;
+	}
+
+	if (bEnableWireQueries && Line->bHasKey)
+	{
+		QueryDirtyChunks.Add(Line->CurrentKey);
+	}
+
+	// A pending rebuild emits the new state anyway.
+	if (!Line->bHasKey || DirtyChunks.Contains(Line->CurrentKey)) return;
+
+	FPowerLineChunk* Chunk = Chunks.Find(Line->CurrentKey);
+	const int32 First = Line->SegmentFirst;
+	const int32 Count = Line->LastSegmentCount;
+	if (!Chunk || First < 0 || Count <= 0 || First + Count > Chunk->BatchedSegments.Num())
+	{
+		MarkPowerLineDirty(Line, EPowerLineDirtyCause::Property);
+		return;
+	}
+
+	// Both pieces together keep the wire's segment count, so the range is rewritten without moving its neighbours.
+	TArray<FVector> Scratch;
+	TArray<FPowerLineSegment> Segments;
+	Segments.Reserve(Count);
+	Span.Emit(Scratch, Segments);
+	if (Segments.Num() != Count)
+	{
+		MarkPowerLineDirty(Line, EPowerLineDirtyCause::Property);
+		return;
+	}
+	for (int32 i = 0; i < Count; ++i)
+	{
+		Chunk->BatchedSegments[First + i] = Segments[i];
+	}
+
+	InPlaceUploadChunks.Add(Line->CurrentKey);
+}
+
+// ============================
+// Subsystem - Styles
+// ============================
+
+int32 UPowerLineSubsystem::AllocateStyle(const FPowerLineStyle& Style, bool bShared)
+{
+	const int32 Index = FreeStyles.Num() > 0 ? FreeStyles.Pop() : StyleSlots.AddDefaulted();
+
+	FStyleSlot& Slot = StyleSlots[Index];
+	Slot = FStyleSlot();
+	Slot.Style = Style;
+	Slot.bLive = true;
+	Slot.bShared = bShared;
+	Slot.Serial = ++NextStyleSerial;
+
+	PushStyle(Index);
+	return Index;
+}
+
+static uint64 SharedStyleKey(FColor Color, float Thickness)
+{
+	// Thickness quantized to 0.01 (editor precision).
+	return ((uint64)Color.DWColor() << 32) | (uint32)FMath::Max(0, FMath::RoundToInt(Thickness * 100.f));
+}
+
+void UPowerLineSubsystem::FreeStyle(int32 Index)
+{
+	if (StyleSlots[Index].bShared)
+	{
+		SharedStyles.Remove(SharedStyleKey(StyleSlots[Index].Style.Color, StyleSlots[Index].Style.Thickness));
+	}
+
+	StyleSlots[Index] = FStyleSlot();
+	FreeStyles.Add(Index);
+
+	if (APowerLineNetState* State = NetState.Get())
+	{
+		State->RemoveStyle(Index);
+	}
+}
+
+void UPowerLineSubsystem::AddStyleUser(int32 Index)
+{
+	if (StyleSlots.IsValidIndex(Index))
+	{
+		++StyleSlots[Index].Users;
+	}
+}
+
+void UPowerLineSubsystem::RemoveStyleUser(int32 Index)
+{
+	if (!StyleSlots.IsValidIndex(Index)) return;
+
+	FStyleSlot& Slot = StyleSlots[Index];
+	if (--Slot.Users <= 0 && Slot.bReleased)
+	{
+		FreeStyle(Index);
+	}
+}
+
+void UPowerLineSubsystem::PushStyle(int32 Index)
+{
+	// Nothing draws on a headless server.
+	if (IsHeadless()) return;
+
+	// Enqueued before any segment upload that references the slot, so proxies never see an unknown index.
+	const FPowerLineStyle Style = StyleSlots[Index].Style;
+	ENQUEUE_RENDER_COMMAND(PowerLine_SetStyle)(
+		[Palette = StylePaletteRT, Index, Style](FRHICommandListImmediate& RHICmdList) {
+			if (Index >= Palette->Styles.Num())
+			{
+				Palette->Styles.SetNum(Index + 1);
+			}
+			Palette->Styles[Index] = Style;
+		});
+}
+
+int32 UPowerLineSubsystem::AcquireSharedStyle(FColor Color, float Thickness, int32& InOutHeld)
+{
+	const uint64 Key = SharedStyleKey(Color, Thickness);
+	int32 Index = INDEX_NONE;
+	if (const int32* Found = SharedStyles.Find(Key))
+	{
+		Index = *Found;
+	}
+	else
+	{
+		FPowerLineStyle Style;
+		Style.Color = Color;
+		Style.Thickness = Thickness;
+		Index = AllocateStyle(Style, true);
+		SharedStyles.Add(Key, Index);
+	}
+
+	if (Index != InOutHeld)
+	{
+		++StyleSlots[Index].Users;
+		ReleaseSharedStyle(InOutHeld);
+		InOutHeld = Index;
+	}
+	return Index;
+}
+
+void UPowerLineSubsystem::ReleaseSharedStyle(int32& InOutHeld)
+{
+	const int32 Index = InOutHeld;
+	InOutHeld = INDEX_NONE;
+	if (!StyleSlots.IsValidIndex(Index) || !StyleSlots[Index].bShared) return;
+
+	// Editor color/thickness edits would otherwise leave one palette entry per value tried.
+	if (--StyleSlots[Index].Users <= 0)
+	{
+		FreeStyle(Index);
+	}
+}
+
+int32 UPowerLineSubsystem::ResolveWireStyle(UPowerLineComponent* Line)
+{
+	if (!Line) return 0;
+
+	const int32 Override = Line->StyleOverride;
+	if (StyleSlots.IsValidIndex(Override) && StyleSlots[Override].bLive)
+	{
+		ReleaseSharedStyle(Line->HeldSharedStyle);
+		return Override;
+	}
+	return AcquireSharedStyle(Line->LineColor, Line->LineThickness, Line->HeldSharedStyle);
+}
+
+void UPowerLineSubsystem::ResolveBuildResources(UPowerLineComponent* Line, FPowerLineWireBuild& Build)
+{
+	// Refcounted slots: taken here, on the game thread, never from ResolveBuildInputs (a pure read).
+	Build.Style = ResolveWireStyle(Line);
+	Build.WindGroup = ResolveWindGroup(Build.District.Get());
+}
+
+int32 UPowerLineSubsystem::CreateLineStyle(FColor Color, float Thickness)
+{
+	FPowerLineStyle Style;
+	Style.Color = Color;
+	Style.Thickness = FMath::Max(0.1f, Thickness);
+	return AllocateStyle(Style, false);
+}
+
+void UPowerLineSubsystem::SetLineStyle(int32 Style, FColor Color, float Thickness)
+{
+	if (!StyleSlots.IsValidIndex(Style)) return;
+
+	// Shared styles are keyed by their value; wires change those through LineColor/LineThickness.
+	FStyleSlot& Slot = StyleSlots[Style];
+	if (!Slot.bLive || Slot.bShared || Slot.bReleased) return;
+
+	Slot.Style.Color = Color;
+	Slot.Style.Thickness = FMath::Max(0.1f, Thickness);
+	PushStyle(Style);
+
+	// Clients only hear about styles some wire was pointed at.
+	if (NetState.IsValid() && NetState->HasStyle(Style))
+	{
+		ReplicateStyle(Style);
+	}
+}
+
+void UPowerLineSubsystem::ReleaseLineStyle(int32 Style)
+{
+	if (!StyleSlots.IsValidIndex(Style)) return;
+
+	FStyleSlot& Slot = StyleSlots[Style];
+	if (!Slot.bLive || Slot.bShared) return;
+
+	if (Slot.Users > 0)
+	{
+		// Wires keep drawing with it until they are pointed elsewhere.
+		Slot.bReleased = true;
+		return;
+	}
+
+	FreeStyle(Style);
+}
+
+void UPowerLineSubsystem::SetWireStyle(UPowerLineComponent* Line, int32 Style)
+{
+	if (!Line) return;
+	if (Style != INDEX_NONE && (!StyleSlots.IsValidIndex(Style) || !StyleSlots[Style].bLive || StyleSlots[Style].bReleased)) return;
+
+	const int32 OldStyle = Line->StyleOverride;
+	if (OldStyle == Style) return;
+
+	Line->StyleOverride = Style;
+	Line->StyleOverrideSerial = Style != INDEX_NONE ? StyleSlots[Style].Serial : 0;
+	ReplicateWireState(Line);
+
+	// Unregistered wires pick the user count up on registration.
+	if (Line->bRegistered)
+	{
+		AddStyleUser(Style);
+		RemoveStyleUser(OldStyle);
+	}
+
+	if (!Line->bRegistered || !Line->bHasResolvedSpan) return;
+
+	// Simulated wires copy the style from the span every step.
+	const int32 NewIndex = ResolveWireStyle(Line);
+	Line->ResolvedSpan.Style = NewIndex;
+
+	if (IsHeadless() || Line->SimIndex != INDEX_NONE) return;
+
+	if (Line->bDynamic)
+	{
+		bDynamicDirty = true;
+		return;
+	}
+
+	// A pending rebuild resolves the new style anyway.
+	if (!Line->bHasKey || DirtyChunks.Contains(Line->CurrentKey)) return;
+
+	FPowerLineChunk* Chunk = Chunks.Find(Line->CurrentKey);
+	if (!Chunk) return;
+
+	const int32 First = Line->SegmentFirst;
+	const int32 Count = Line->LastSegmentCount;
+	if (First < 0 || Count <= 0 || First + Count > Chunk->BatchedSegments.Num()) return;
+
+	for (int32 i = First; i < First + Count; ++i)
+	{
+		Chunk->BatchedSegments[i].Style = NewIndex;
+	}
+
+	// Uploaded once per chunk in Tick (restyling a whole circuit touches many wires per chunk).
+	InPlaceUploadChunks.Add(Line->CurrentKey);
+}
+
+// ============================
+// Subsystem - Connectivity
+// ============================
+
+int32 UPowerLineSubsystem::FindGridVertex(AActor* Actor) const
+{
+	const int32* Found = Actor ? GridVertexByActor.Find(Actor) : nullptr;
+	return Found ? *Found : INDEX_NONE;
+}
+
+int32 UPowerLineSubsystem::FindOrAddGridVertex(AActor* Actor)
+{
+	if (const int32* Found = GridVertexByActor.Find(Actor))
+	{
+		++GridVertexRefs[*Found];
+		return *Found;
+	}
+
+	const int32 V = Grid.AddVertex();
+	if (V >= GridActors.Num())
+	{
+		GridActors.SetNum(V + 1);
+		GridVertexRefs.SetNum(V + 1);
+	}
+	GridActors[V] = Actor;
+	GridVertexRefs[V] = 1;
+	GridVertexByActor.Add(Actor, V);
+	return V;
+}
+
+void UPowerLineSubsystem::ReleaseGridVertex(int32 Vertex)
+{
+	if (!GridVertexRefs.IsValidIndex(Vertex) || --GridVertexRefs[Vertex] > 0) return;
+
+	// Weak keys keep their hash after the actor is gone.
+	GridVertexByActor.Remove(GridActors[Vertex]);
+	GridActors[Vertex] = nullptr;
+	Grid.RemoveVertex(Vertex);
+}
+
+void UPowerLineSubsystem::RemoveWireConnection(UPowerLineComponent* Line)
+{
+	const int32 Edge = Line->GridEdge;
+	Line->GridEdge = INDEX_NONE;
+	if (!Grid.IsValidEdge(Edge)) return;
+
+	int32 A, B;
+	Grid.GetEdgeVertices(Edge, A, B);
+	Grid.RemoveEdge(Edge);
+	GridEdgeWires[Edge] = nullptr;
+	ReleaseGridVertex(A);
+	ReleaseGridVertex(B);
+}
+
+void UPowerLineSubsystem::UpdateWireConnection(UPowerLineComponent* Line)
+{
+	if (!Line) return;
+
+	// A cut wire connects nothing (ReconnectWire restores the edge).
+	if (Line->IsBroken())
+	{
+		RemoveWireConnection(Line);
+		return;
+	}
+
+	AActor* Owner = Line->GetOwner();
+	AActor* Target = Line->ResolveEffectiveTargetActor();
+
+	// Rebinds also happen for attach key edits: keep the edge when its actors did not change.
+	if (Grid.IsValidEdge(Line->GridEdge))
+	{
+		int32 A, B;
+		Grid.GetEdgeVertices(Line->GridEdge, A, B);
+		if (Target && GridActors[A].Get() == Owner && GridActors[B].Get() == Target) return;
+	}
+
+	RemoveWireConnection(Line);
+	if (!Owner || !Target || Owner == Target) return;
+
+	const int32 A = FindOrAddGridVertex(Owner);
+	const int32 B = FindOrAddGridVertex(Target);
+	const int32 Edge = Grid.AddEdge(A, B);
+	if (Edge >= GridEdgeWires.Num())
+	{
+		GridEdgeWires.SetNum(Edge + 1);
+	}
+	GridEdgeWires[Edge] = Line;
+	Line->GridEdge = Edge;
+}
+
+void UPowerLineSubsystem::SetPowerSource(AActor* Actor, bool bIsSource)
+{
+	if (!Actor) return;
+
+	if (bIsSource)
+	{
+		bool bAlreadySource = false;
+		PowerSources.Add(Actor, &bAlreadySource);
+		if (!bAlreadySource)
+		{
+			Grid.SetSource(FindOrAddGridVertex(Actor), true);
+		}
+	}
+	else if (PowerSources.Remove(Actor) > 0)
+	{
+		const int32 V = FindGridVertex(Actor);
+		Grid.SetSource(V, false);
+		ReleaseGridVertex(V);
+	}
+}
+
+bool UPowerLineSubsystem::IsPowered(AActor* Actor) const
+{
+	return Grid.IsPowered(FindGridVertex(Actor));
+}
+
+bool UPowerLineSubsystem::AreConnected(AActor* A, AActor* B) const
+{
+	if (A && A == B) return true;
+	return Grid.AreConnected(FindGridVertex(A), FindGridVertex(B));
+}
+
+int32 UPowerLineSubsystem::GetConnectedActors(AActor* Actor, TArray<AActor*>& OutActors) const
+{
+	const int32 V = FindGridVertex(Actor);
+	if (V == INDEX_NONE) return 0;
+
+	TArray<int32> Vertices;
+	Grid.GetComponent(V, Vertices);
+
+	const int32 FirstOut = OutActors.Num();
+	for (int32 U : Vertices)
+	{
+		if (AActor* Connected = GridActors[U].Get())
+		{
+			OutActors.Add(Connected);
+		}
+	}
+	return OutActors.Num() - FirstOut;
+}
+
+int32 UPowerLineSubsystem::GetWiresFeedingActor(AActor* Actor, TArray<UPowerLineComponent*>& OutWires) const
+{
+	const int32 V = FindGridVertex(Actor);
+	if (V == INDEX_NONE) return 0;
+
+	const int32 FirstOut = OutWires.Num();
+	for (int32 Edge : Grid.GetVertexEdges(V))
+	{
+		int32 A, B;
+		Grid.GetEdgeVertices(Edge, A, B);
+		if (B != V) continue;
+
+		if (UPowerLineComponent* Wire = GridEdgeWires[Edge].Get())
+		{
+			OutWires.Add(Wire);
+		}
+	}
+	return OutWires.Num() - FirstOut;
+}
+
+void UPowerLineSubsystem::GetGridStats(int32& OutActors, int32& OutWires, int32& OutComponents) const
+{
+	OutActors = Grid.NumVertices();
+	OutWires = Grid.NumEdges();
+	OutComponents = Grid.NumComponents();
+}
+
+// ============================
+// Network wire state
+// ============================
+
+APowerLineNetState::APowerLineNetState()
+{
+	bReplicates = true;
+	bAlwaysRelevant = true;
+	SetReplicatingMovement(false);
+
+	Styles.Owner = this;
+	Wires.Owner = this;
+}
+
+void APowerLineNetState::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	// Styles first: wires reference them by server index.
+	DOREPLIFETIME(APowerLineNetState, Styles);
+	DOREPLIFETIME(APowerLineNetState, Wires);
+}
+
+void APowerLineNetState::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// Clients: the subsystem reads traffic counters from the replicated instance.
+	if (UPowerLineSubsystem* Sub = GetPowerLineSubsystem(this))
+	{
+		if (!Sub->NetState.IsValid())
+		{
+			Sub->NetState = this;
+		}
+	}
+}
+
+FPowerLineNetWire& APowerLineNetState::FindOrAddWire(UPowerLineComponent* Line)
+{
+	const TObjectKey<UPowerLineComponent> Key(Line);
+	if (const int32* Found = WireItems.Find(Key))
+	{
+		return Wires.Items[*Found];
+	}
+
+	const int32 Index = Wires.Items.AddDefaulted();
+	Wires.Items[Index].Wire = Line;
+	Wires.Items[Index].Key = Key;
+	WireItems.Add(Key, Index);
+	return Wires.Items[Index];
+}
+
+const FPowerLineNetWire* APowerLineNetState::FindWire(UPowerLineComponent* Line) const
+{
+	const int32* Found = WireItems.Find(TObjectKey<UPowerLineComponent>(Line));
+	return Found ? &Wires.Items[*Found] : nullptr;
+}
+
+FPowerLineNetStyle& APowerLineNetState::FindOrAddStyle(int32 Style)
+{
+	if (const int32* Found = StyleItems.Find(Style))
+	{
+		return Styles.Items[*Found];
+	}
+
+	const int32 Index = Styles.Items.AddDefaulted();
+	Styles.Items[Index].ServerStyle = Style;
+	StyleItems.Add(Style, Index);
+	return Styles.Items[Index];
+}
+
+void APowerLineNetState::MarkWireDirty(FPowerLineNetWire& Item)
+{
+	Wires.MarkItemDirty(Item);
+	++ChangesRecorded;
+}
+
+void APowerLineNetState::MarkStyleDirty(FPowerLineNetStyle& Item)
+{
+	Styles.MarkItemDirty(Item);
+	++ChangesRecorded;
+}
+
+void APowerLineNetState::RemoveWire(UPowerLineComponent* Line)
+{
+	if (const int32* Found = WireItems.Find(TObjectKey<UPowerLineComponent>(Line)))
+	{
+		RemoveWireAt(*Found);
+	}
+
+	if (++RemovalsSincePrune >= PruneInterval)
+	{
+		PruneWires();
+	}
+}
+
+void APowerLineNetState::RemoveWireAt(int32 Index)
+{
+	WireItems.Remove(Wires.Items[Index].Key);
+	Wires.Items.RemoveAtSwap(Index);
+
+	// The item moved into the hole is re-keyed by its own handle, valid even if its wire is gone.
+	if (Wires.Items.IsValidIndex(Index))
+	{
+		WireItems.Add(Wires.Items[Index].Key, Index);
+	}
+	Wires.MarkArrayDirty();
+	++ChangesRecorded;
+}
+
+void APowerLineNetState::PruneWires()
+{
+	RemovalsSincePrune = 0;
+
+	// Back to front: swap removal only moves items that were already checked.
+	for (int32 i = Wires.Items.Num() - 1; i >= 0; --i)
+	{
+		if (!IsValid(Wires.Items[i].Wire))
+		{
+			RemoveWireAt(i);
+		}
+	}
+}
+
+void APowerLineNetState::RemoveStyle(int32 Style)
+{
+	int32 Index = INDEX_NONE;
+	if (!StyleItems.RemoveAndCopyValue(Style, Index)) return;
+
+	Styles.Items.RemoveAtSwap(Index);
+	if (Styles.Items.IsValidIndex(Index))
+	{
+		StyleItems.Add(Styles.Items[Index].ServerStyle, Index);
+	}
+	Styles.MarkArrayDirty();
+	++ChangesRecorded;
+}
+
+void APowerLineNetState::CountDelta(const FNetDeltaSerializeInfo& DeltaParms, int64 BitsBefore)
+{
+	if (DeltaParms.Writer)
+	{
+		const int64 Bits = DeltaParms.Writer->GetNumBits() - BitsBefore;
+		if (Bits > 0)
+		{
+			NetBitsWritten += Bits;
+			++NetDeltasWritten;
+		}
+	}
+	else if (DeltaParms.Reader)
+	{
+		const int64 Bits = DeltaParms.Reader->GetPosBits() - BitsBefore;
+		if (Bits > 0)
+		{
+			NetBitsRead += Bits;
+			++NetDeltasRead;
+		}
+	}
+}
+
+static int64 GetNetDeltaBitPos(const FNetDeltaSerializeInfo& DeltaParms)
+{
+	if (DeltaParms.Writer) return DeltaParms.Writer->GetNumBits();
+	if (DeltaParms.Reader) return DeltaParms.Reader->GetPosBits();
+	return 0;
+}
+
+bool FPowerLineNetStyleArray::NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+{
+	const int64 BitsBefore = GetNetDeltaBitPos(DeltaParms);
+	const bool bResult = FFastArraySerializer::FastArrayDeltaSerialize<FPowerLineNetStyle, FPowerLineNetStyleArray>(Items, DeltaParms, *this);
+	if (Owner)
+	{
+		Owner->CountDelta(DeltaParms, BitsBefore);
+	}
+	return bResult;
+}
+
+void FPowerLineNetStyleArray::PostReplicatedAdd(const TArrayView<int32>& AddedIndices, int32 FinalSize)
+{
+	PostReplicatedChange(AddedIndices, FinalSize);
+}
+
+void FPowerLineNetStyleArray::PostReplicatedChange(const TArrayView<int32>& ChangedIndices, int32 FinalSize)
+{
+	UPowerLineSubsystem* Sub = GetPowerLineSubsystem(Owner);
+	if (!Sub) return;
+
+	for (const int32 Index : ChangedIndices)
+	{
+		if (Items.IsValidIndex(Index))
+		{
+			Sub->ApplyNetStyle(Items[Index]);
+		}
+	}
+}
+
+void FPowerLineNetStyleArray::PreReplicatedRemove(const TArrayView<int32>& RemovedIndices, int32 FinalSize)
+{
+	UPowerLineSubsystem* Sub = GetPowerLineSubsystem(Owner);
+	if (!Sub) return;
+
+	for (const int32 Index : RemovedIndices)
+	{
+		if (Items.IsValidIndex(Index))
+		{
+			Sub->RemoveNetStyle(Items[Index]);
+		}
+	}
+}
+
+bool FPowerLineNetWireArray::NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+{
+	const int64 BitsBefore = GetNetDeltaBitPos(DeltaParms);
+	const bool bResult = FFastArraySerializer::FastArrayDeltaSerialize<FPowerLineNetWire, FPowerLineNetWireArray>(Items, DeltaParms, *this);
+	if (Owner)
+	{
+		Owner->CountDelta(DeltaParms, BitsBefore);
+	}
+	return bResult;
+}
+
+void FPowerLineNetWireArray::PostReplicatedAdd(const TArrayView<int32>& AddedIndices, int32 FinalSize)
+{
+	PostReplicatedChange(AddedIndices, FinalSize);
+}
+
+void FPowerLineNetWireArray::PostReplicatedChange(const TArrayView<int32>& ChangedIndices, int32 FinalSize)
+{
+	UPowerLineSubsystem* Sub = GetPowerLineSubsystem(Owner);
+	if (!Sub) return;
+
+	for (const int32 Index : ChangedIndices)
+	{
+		if (Items.IsValidIndex(Index))
+		{
+			Sub->ApplyNetWire(Items[Index]);
+		}
+	}
+}
+
+void FPowerLineNetWireArray::PreReplicatedRemove(const TArrayView<int32>& RemovedIndices, int32 FinalSize)
+{
+	UPowerLineSubsystem* Sub = GetPowerLineSubsystem(Owner);
+	if (!Sub) return;
+
+	for (const int32 Index : RemovedIndices)
+	{
+		if (Items.IsValidIndex(Index))
+		{
+			Sub->RemoveNetWire(Items[Index]);
+		}
+	}
+}
+
+// ============================
+// Subsystem - Network state
+// ============================
+
+bool UPowerLineSubsystem::IsNetServer() const
+{
+	const UWorld* World = GetWorld();
+	if (!World) return false;
+
+	const ENetMode Mode = World->GetNetMode();
+	return Mode == NM_ListenServer || Mode == NM_DedicatedServer;
+}
+
+APowerLineNetState* UPowerLineSubsystem::EnsureNetState()
+{
+	if (APowerLineNetState* State = NetState.Get())
+	{
+		return State;
+	}
+
+	UWorld* W = GetWorld();
+	if (!W || !IsNetServer()) return nullptr;
+
+	FActorSpawnParameters P;
+	UObject* NameOuter = W->PersistentLevel ? static_cast<UObject*>(W->PersistentLevel) : static_cast<UObject*>(W);
+	P.Name = MakeUniqueObjectName(NameOuter, APowerLineNetState::StaticClass(), TEXT("PowerLine_NetState"));
+	P.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	P.ObjectFlags |= RF_Transient;
+
+	APowerLineNetState* State = W->SpawnActor<APowerLineNetState>(APowerLineNetState::StaticClass(), FVector::ZeroVector, FRotator::ZeroRotator, P);
+	NetState = State;
+	return State;
+}
+
+void UPowerLineSubsystem::ReplicateStyle(int32 Style)
+{
+	APowerLineNetState* State = EnsureNetState();
+	if (!State || !StyleSlots.IsValidIndex(Style)) return;
+
+	const FPowerLineStyle& Value = StyleSlots[Style].Style;
+	FPowerLineNetStyle& Item = State->FindOrAddStyle(Style);
+	Item.Color = Value.Color;
+	Item.ThicknessQ = (uint16)FMath::Clamp(FMath::RoundToInt(Value.Thickness * 100.f), 0, (int32)MAX_uint16);
+	State->MarkStyleDirty(Item);
+}
+
+void UPowerLineSubsystem::ReplicateWireState(UPowerLineComponent* Line)
+{
+	if (!IsNetServer()) return;
+
+	const int32 Style = Line->StyleOverride;
+	if (Style == INDEX_NONE && !Line->IsBroken())
+	{
+		// Back to the authored state: drop the item unless it still carries a connection override.
+		APowerLineNetState* Current = NetState.Get();
+		const FPowerLineNetWire* Existing = Current ? Current->FindWire(Line) : nullptr;
+		if (!Existing) return;
+		if (!Existing->bHasTarget)
+		{
+			Current->RemoveWire(Line);
+			return;
+		}
+	}
+
+	APowerLineNetState* State = EnsureNetState();
+	if (!State) return;
+
+	// Table entry before the wire item, so clients resolve the index in the same update.
+	if (Style != INDEX_NONE && !State->HasStyle(Style))
+	{
+		ReplicateStyle(Style);
+	}
+
+	FPowerLineNetWire& Item = State->FindOrAddWire(Line);
+	Item.ServerStyle = Style;
+	Item.BreakQ = Line->IsBroken() ? (uint16)(FMath::RoundToInt(Line->BreakT * 65534.f) + 1) : 0;
+	State->MarkWireDirty(Item);
+}
+
+void UPowerLineSubsystem::SetWireTarget(UPowerLineComponent* Line, AActor* Target)
+{
+	if (!Line) return;
+
+	if (Line->TargetActor != Target)
+	{
+		Line->TargetActor = Target;
+		Line->RefreshTargetBinding();
+	}
+
+	if (!IsNetServer()) return;
+
+	if (APowerLineNetState* State = EnsureNetState())
+	{
+		FPowerLineNetWire& Item = State->FindOrAddWire(Line);
+		Item.Target = Target;
+		Item.bHasTarget = true;
+		State->MarkWireDirty(Item);
+	}
+}
+
+int32 UPowerLineSubsystem::ResolveNetStyle(UPowerLineComponent* Line, int32 ServerStyle)
+{
+	const int32* Local = ServerStyle != INDEX_NONE ? NetStyleToLocal.Find(ServerStyle) : nullptr;
+	if (Local || ServerStyle == INDEX_NONE)
+	{
+		NetStyleWaiting.Remove(Line);
+		return Local ? *Local : INDEX_NONE;
+	}
+
+	// Wire arrived before its style entry: it keeps its authored style until ApplyNetStyle points it over.
+	NetStyleWaiting.Add(Line, ServerStyle);
+	return INDEX_NONE;
+}
+
+void UPowerLineSubsystem::ApplyNetStyle(const FPowerLineNetStyle& Item)
+{
+	const float Thickness = (float)Item.ThicknessQ * 0.01f;
+	if (const int32* Local = NetStyleToLocal.Find(Item.ServerStyle))
+	{
+		SetLineStyle(*Local, Item.Color, Thickness);
+		return;
+	}
+
+	const int32 Local = CreateLineStyle(Item.Color, Thickness);
+	NetStyleToLocal.Add(Item.ServerStyle, Local);
+
+	for (auto It = NetStyleWaiting.CreateIterator(); It; ++It)
+	{
+		if (It->Value != Item.ServerStyle) continue;
+
+		if (UPowerLineComponent* Line = It->Key.Get())
+		{
+			SetWireStyle(Line, Local);
+		}
+		It.RemoveCurrent();
+	}
+}
+
+void UPowerLineSubsystem::RemoveNetStyle(const FPowerLineNetStyle& Item)
+{
+	int32 Local = INDEX_NONE;
+	if (NetStyleToLocal.RemoveAndCopyValue(Item.ServerStyle, Local))
+	{
+		ReleaseLineStyle(Local);
+	}
+}
+
+void UPowerLineSubsystem::ApplyNetWire(const FPowerLineNetWire& Item)
+{
+	// Unmapped reference (wire not loaded here yet): the fast array reports a change once it resolves.
+	UPowerLineComponent* Line = Item.Wire;
+	if (!Line) return;
+
+	// Geometry is regenerated locally from the new endpoints (deterministic sag and hanging).
+	if (Item.bHasTarget && Line->TargetActor != Item.Target)
+	{
+		Line->TargetActor = Item.Target;
+		Line->RefreshTargetBinding();
+	}
+
+	SetWireStyle(Line, ResolveNetStyle(Line, Item.ServerStyle));
+
+	if (Item.BreakQ != 0)
+	{
+		BreakWire(Line, (float)(Item.BreakQ - 1) / 65534.f);
+	}
+	else if (Line->IsBroken())
+	{
+		ReconnectWire(Line);
+	}
+}
+
+void UPowerLineSubsystem::RemoveNetWire(const FPowerLineNetWire& Item)
+{
+	if (UPowerLineComponent* Line = Item.Wire)
+	{
+		NetStyleWaiting.Remove(Line);
+		SetWireStyle(Line, INDEX_NONE);
+		if (Line->IsBroken())
+		{
+			ReconnectWire(Line);
+		}
+	}
+}
+
+void UPowerLineSubsystem::GetNetStats(int32& OutChanges, int64& OutBytesSent, int64& OutBytesReceived, int32& OutDeltasSent) const
+{
+	const APowerLineNetState* State = NetState.Get();
+	OutChanges = State ? State->ChangesRecorded : 0;
+	OutBytesSent = State ? (State->NetBitsWritten + 7) / 8 : 0;
+	OutBytesReceived = State ? (State->NetBitsRead + 7) / 8 : 0;
+	OutDeltasSent = State ? State->NetDeltasWritten : 0;
+}
+
+void UPowerLineSubsystem::ResetNetStats()
+{
+	if (APowerLineNetState* State = NetState.Get())
+	{
+		State->NetBitsWritten = 0;
+		State->NetBitsRead = 0;
+		State->NetDeltasWritten = 0;
+		State->NetDeltasRead = 0;
+		State->ChangesRecorded = 0;
+	}
+}
+
+static void PowerLineNetStatsCommand(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+{
+	UPowerLineSubsystem* Sub = World ? World->GetSubsystem<UPowerLineSubsystem>() : nullptr;
+	if (!Sub)
+	{
+		Ar.Log(TEXT("powerline.NetStats: no PowerLine subsystem in this world."));
+		return;
+	}
+
+	if (Args.Num() > 0 && Args[0] == TEXT("reset"))
+	{
+		Sub->ResetNetStats();
+		Ar.Log(TEXT("powerline.NetStats: counters reset."));
+		return;
+	}
+
+	int32 Changes = 0;
+	int32 Deltas = 0;
+	int64 Sent = 0;
+	int64 Received = 0;
+	Sub->GetNetStats(Changes, Sent, Received, Deltas);
+
+	// Each change goes to every client connection.
+	const UNetDriver* Driver = World->GetNetDriver();
+	const int32 Connections = Driver ? Driver->ClientConnections.Num() : 0;
+	const double PerChange = (Changes > 0 && Connections > 0) ? (double)Sent / ((double)Changes * (double)Connections) : 0.0;
+
+	Ar.Logf(TEXT("PowerLine net state: %d changes, %d deltas, %lld bytes sent to %d connections (%.1f bytes per change per client), %lld bytes received"),
+		Changes, Deltas, Sent, Connections, PerChange, Received);
+}
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GPowerLineNetStatsCommand(
+	TEXT("powerline.NetStats"),
+	TEXT("Replicated wire-state traffic of this world (run on the server and on clients in a multi-client PIE session). Usage: powerline.NetStats [reset]"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&PowerLineNetStatsCommand));
+
+static void PowerLineNetBenchCommand(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+{
+	UPowerLineSubsystem* Sub = World ? World->GetSubsystem<UPowerLineSubsystem>() : nullptr;
+	if (!Sub || !Sub->IsNetServer())
+	{
+		Ar.Log(TEXT("powerline.NetBench: run on the server (listen or dedicated) of a multi-client session."));
+		return;
+	}
+
+	const int32 Count = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 100;
+	const FString Kind = Args.Num() > 1 ? Args[1] : TEXT("style");
+
+	// Reproducible wire choice: registered wires of this world in name order.
+	TArray<UPowerLineComponent*> Wires;
+	for (TObjectIterator<UPowerLineComponent> It; It; ++It)
+	{
+		if (It->GetWorld() == World && It->bRegistered)
+		{
+			Wires.Add(*It);
+		}
+	}
+	Wires.Sort([](const UPowerLineComponent& A, const UPowerLineComponent& B) { return A.GetPathName() < B.GetPathName(); });
+	Wires.SetNum(FMath::Min(Count, Wires.Num()));
+
+	// One change per wire; powerline.NetStats on the server then reports bytes per change per client.
+	Sub->ResetNetStats();
+	if (Kind == TEXT("break"))
+	{
+		for (UPowerLineComponent* Line : Wires)
+		{
+			if (Line->IsBroken())
+			{
+				Sub->ReconnectWire(Line);
+			}
+			else
+			{
+				Sub->BreakWire(Line, 0.5f);
+			}
+		}
+	}
+	else
+	{
+		// A fresh style per run (one table entry on top of the wire items); released, so it goes with the next run.
+		const int32 Style = Sub->CreateLineStyle(FColor::MakeRandomColor(), 3.f);
+		for (UPowerLineComponent* Line : Wires)
+		{
+			Sub->SetWireStyle(Line, Style);
+		}
+		Sub->ReleaseLineStyle(Style);
+	}
+
+	Ar.Logf(TEXT("powerline.NetBench: %d %s changes issued; run powerline.NetStats after the next net update."), Wires.Num(), *Kind);
+}
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GPowerLineNetBenchCommand(
+	TEXT("powerline.NetBench"),
+	TEXT("Server: resets the net stats and issues one replicated change on each of N wires (toggles a style or a break). Usage: powerline.NetBench [N=100] [style|break]"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&PowerLineNetBenchCommand));
+
+// ============================
+// Subsystem - Auto wiring
+// ============================
+
+static PowerLineCore::FAutoWireParams MakeAutoWireParams(EPowerLineAutoWirePolicy Policy, float MaxSpanCm, int32 NearestK)
+{
+	PowerLineCore::FAutoWireParams Params;
+	Params.Policy = Policy == EPowerLineAutoWirePolicy::NearestK ? PowerLineCore::EAutoWirePolicy::NearestK : PowerLineCore::EAutoWirePolicy::MinimumSpanningTree;
+	Params.MaxSpanCm = MaxSpanCm;
+	Params.K = FMath::Max(1, NearestK);
+	return Params;
+}
+
+int32 UPowerLineSubsystem::AutoWirePoles(const TArray<APowerLine_Pole*>& Poles, EPowerLineAutoWirePolicy Policy, float MaxSpanCm, int32 NearestK,
+	bool bApply, TArray<FPowerLineAutoWireLink>& OutLinks)
+{
+	POWERLINE_SCOPE(PowerLine_AutoWire);
+
+	// Positions and attach key sets (sorted, hashed) of the valid poles.
+	TArray<APowerLine_Pole*> Valid;
+	TArray<FVector> Points;
+	TArray<uint32> Groups;
+	Valid.Reserve(Poles.Num());
+	Points.Reserve(Poles.Num());
+	Groups.Reserve(Poles.Num());
+
+	TSet<APowerLine_Pole*> Unique;
+	TArray<UPowerLineComponent*> Wires;
+	TArray<FName> Keys;
+	for (APowerLine_Pole* Pole : Poles)
+	{
+		bool bDuplicate = false;
+		if (!IsValid(Pole)) continue;
+		Unique.Add(Pole, &bDuplicate);
+		if (bDuplicate) continue;
+
+		Pole->GetComponents(Wires);
+		Keys.Reset();
+		for (const UPowerLineComponent* Wire : Wires)
+		{
+			Keys.Add(Wire->GetAttachKey());
+		}
+		Keys.Sort(FNameLexicalLess());
+
+		uint32 Group = 0;
+		for (const FName& Key : Keys)
+		{
+			Group = HashCombine(Group, GetTypeHash(Key));
+		}
+
+		Valid.Add(Pole);
+		Points.Add(Pole->GetActorLocation());
+		Groups.Add(Group);
+	}
+
+	TArray<PowerLineCore::FAutoWireLink> Links;
+	PowerLineCore::AutoWire(Points, Groups, MakeAutoWireParams(Policy, MaxSpanCm, NearestK), Links);
+
+	// Orient: breadth-first from the first pole of each network, every pole targets the pole it was reached from.
+	const int32 Num = Valid.Num();
+	TArray<TArray<int32, TInlineAllocator<4>>> Adjacency;
+	Adjacency.SetNum(Num);
+	for (int32 l = 0; l < Links.Num(); ++l)
+	{
+		Adjacency[Links[l].A].Add(l);
+		Adjacency[Links[l].B].Add(l);
+	}
+
+	TArray<int32> ParentLink;
+	ParentLink.Init(INDEX_NONE, Num);
+	TBitArray<> Seen(false, Num);
+	TArray<int32> Queue;
+	for (int32 Root = 0; Root < Num; ++Root)
+	{
+		if (Seen[Root]) continue;
+
+		Seen[Root] = true;
+		Queue.Reset();
+		Queue.Add(Root);
+		for (int32 q = 0; q < Queue.Num(); ++q)
+		{
+			const int32 V = Queue[q];
+			for (int32 l : Adjacency[V])
+			{
+				const int32 U = Links[l].A == V ? Links[l].B : Links[l].A;
+				if (Seen[U]) continue;
+
+				Seen[U] = true;
+				ParentLink[U] = l;
+				Queue.Add(U);
+			}
+		}
+	}
+
+	const int32 FirstOut = OutLinks.Num();
+	OutLinks.Reserve(FirstOut + Links.Num());
+	for (int32 l = 0; l < Links.Num(); ++l)
+	{
+		const PowerLineCore::FAutoWireLink& L = Links[l];
+		const bool bFromB = ParentLink[L.B] == l;
+
+		FPowerLineAutoWireLink& Out = OutLinks.AddDefaulted_GetRef();
+		Out.From = Valid[bFromB ? L.B : L.A];
+		Out.To = Valid[bFromB ? L.A : L.B];
+		Out.Length = L.Length;
+		Out.bBound = bFromB || ParentLink[L.A] == l;
+	}
+
+	if (bApply)
+	{
+#if WITH_EDITOR
+		// Engine-level transaction (UEditorEngine implements it), so the module does not link UnrealEd.
+		const bool bTransact = GEngine && GIsEditor && GetWorld() && !GetWorld()->IsGameWorld();
+		if (bTransact)
+		{
+			GEngine->BeginTransaction(TEXT("PowerLine"), NSLOCTEXT("PowerLine", "AutoWirePoles", "Auto-Wire Power Lines"), nullptr);
+		}
+#endif
+		{
+			// One rebuild (and one rebind per wire) for the whole network.
+			FPowerLineBatchEditScope Batch(GetWorld());
+			for (int32 V = 0; V < Num; ++V)
+			{
+				// Roots are cleared too: a previous run's target would leave an extra edge (or a cycle) behind.
+				AActor* Target = nullptr;
+				if (ParentLink[V] != INDEX_NONE)
+				{
+					const PowerLineCore::FAutoWireLink& L = Links[ParentLink[V]];
+					Target = Valid[L.A == V ? L.B : L.A];
+				}
+
+				APowerLine_Pole* Pole = Valid[V];
+				if (Pole->DefaultTargetActor == Target) continue;
+
+				Pole->Modify();
+				Pole->DefaultTargetActor = Target;
+				Pole->MarkChildWiresDirty();
+			}
+		}
+#if WITH_EDITOR
+		if (bTransact)
+		{
+			GEngine->EndTransaction();
+		}
+#endif
+	}
+
+	return OutLinks.Num() - FirstOut;
+}
+
+int32 UPowerLineSubsystem::AutoWireMultiPoleNodes(UPowerLineMultiPoleComponent* MultiPole, EPowerLineAutoWirePolicy Policy, float MaxSpanCm, int32 NearestK,
+	TArray<FIntPoint>& OutLinks)
+{
+	POWERLINE_SCOPE(PowerLine_AutoWire);
+
+	if (!IsValid(MultiPole)) return 0;
+
+	TArray<FVector> Points;
+	Points.Reserve(MultiPole->Nodes.Num());
+	for (const FPowerLinePoleNode& Node : MultiPole->Nodes)
+	{
+		Points.Add(MultiPole->GetWirePointWS(Node));
+	}
+
+	TArray<uint32> Groups;
+	Groups.SetNumZeroed(Points.Num());
+
+	TArray<PowerLineCore::FAutoWireLink> Links;
+	PowerLineCore::AutoWire(Points, Groups, MakeAutoWireParams(Policy, MaxSpanCm, NearestK), Links);
+
+	OutLinks.Reserve(OutLinks.Num() + Links.Num());
+	for (const PowerLineCore::FAutoWireLink& L : Links)
+	{
+		OutLinks.Emplace(L.A, L.B);
+	}
+	return Links.Num();
+}
+
+static void PowerLineAutoWireCommand(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+{
+	UPowerLineSubsystem* Sub = World ? World->GetSubsystem<UPowerLineSubsystem>() : nullptr;
+	if (!Sub)
+	{
+		Ar.Log(TEXT("powerline.AutoWire: no PowerLine subsystem in this world."));
+		return;
+	}
+
+	const float MaxSpan = Args.Num() > 0 ? FCString::Atof(*Args[0]) : 5000.f;
+	const int32 K = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 0;
+
+	TArray<APowerLine_Pole*> Poles;
+	for (TActorIterator<APowerLine_Pole> It(World); It; ++It)
+	{
+		Poles.Add(*It);
+	}
+
+	const double Start = FPlatformTime::Seconds();
+	TArray<FPowerLineAutoWireLink> Links;
+	Sub->AutoWirePoles(Poles, K > 0 ? EPowerLineAutoWirePolicy::NearestK : EPowerLineAutoWirePolicy::MinimumSpanningTree, MaxSpan, K, true, Links);
+
+	int32 Bound = 0;
+	for (const FPowerLineAutoWireLink& Link : Links)
+	{
+		Bound += Link.bBound ? 1 : 0;
+	}
+	Ar.Logf(TEXT("powerline.AutoWire: %d poles, %d links (%d bound) in %.1f ms"),
+		Poles.Num(), Links.Num(), Bound, (FPlatformTime::Seconds() - Start) * 1000.0);
+}
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GPowerLineAutoWireCommand(
+	TEXT("powerline.AutoWire"),
+	TEXT("Wires every APowerLine_Pole of the world to its neighbours (sets DefaultTargetActor). Usage: powerline.AutoWire [MaxSpanCm] [K (0 = spanning tree)]"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&PowerLineAutoWireCommand));
+
+// ============================
+// Subsystem - Cable simulation
+// ============================
+
+int32 UPowerLineSubsystem::PromoteToSimulation(UPowerLineComponent* Line)
+{
+	if (!Line || !Line->bRegistered) return INDEX_NONE;
+	if (Line->SimIndex != INDEX_NONE) return Line->SimIndex;
+	if (Line->bDynamic || !Line->bHasResolvedSpan) return INDEX_NONE;
+
+	// One particle chain per intact wire: bundles and broken wires stay on their static curves.
+	if (Line->ResolvedSpan.Bundle || Line->IsBroken()) return INDEX_NONE;
+
+	// Start from the static curve so promotion is seamless.
+	const FPowerLineWireBuild& Span = Line->ResolvedSpan;
+	TArray<FVector> Points;
+	if (!PowerLineCore::BuildSaggedCurve(Span.Start, Span.End, Span.Sag, Span.Segments, Points)) return INDEX_NONE;
+	if (SimParticles + Points.Num() > SimulationParticleBudget) return INDEX_NONE;
+
+	FSimWire& Sim = SimWires.AddDefaulted_GetRef();
+	Sim.Line = Line;
+	Sim.State.Init(Points);
+	Sim.PinA = Span.Start;
+	Sim.PinB = Span.End;
+	SimParticles += Points.Num();
+
+	Line->SimIndex = SimWires.Num() - 1;
+	if (Line->bHasKey)
+	{
+		DirtyChunks.Add(Line->CurrentKey);
+	}
+	return Line->SimIndex;
+}
+
+void UPowerLineSubsystem::RemoveFromSimulation(int32 Index)
+{
+	if (!SimWires.IsValidIndex(Index)) return;
+
+	SimParticles -= SimWires[Index].State.Num();
+
+	// Back to the static curve (one rebuild of its chunk).
+	if (UPowerLineComponent* Line = SimWires[Index].Line.Get())
+	{
+		Line->SimIndex = INDEX_NONE;
+		if (Line->bRegistered && Line->bHasKey)
+		{
+			DirtyChunks.Add(Line->CurrentKey);
+		}
+	}
+
+	SimWires.RemoveAtSwap(Index);
+	if (SimWires.IsValidIndex(Index))
+	{
+		if (UPowerLineComponent* Swapped = SimWires[Index].Line.Get())
+		{
+			Swapped->SimIndex = Index;
+		}
+	}
+}
+
+int32 UPowerLineSubsystem::AddCableImpulse(const FVector& Center, float Radius, const FVector& VelocityCmPerSec)
+{
+	if (!bEnableCableSimulation || IsHeadless()) return 0;
+
+	TArray<FPowerLineWireHit> Hits;
+	FindWiresInRadius(Center, Radius, Hits);
+
+	const PowerLineCore::FCableSimParams Params;
+	int32 Affected = 0;
+	for (const FPowerLineWireHit& Hit : Hits)
+	{
+		const int32 Index = PromoteToSimulation(Hit.Wire.Get());
+		if (Index == INDEX_NONE) continue;
+
+		FSimWire& Sim = SimWires[Index];
+		Sim.State.AddImpulse(Center, Radius, VelocityCmPerSec, Params.SubstepSeconds);
+		Sim.QuietSince = 0.0;
+		++Affected;
+	}
+	return Affected;
+}
+
+void UPowerLineSubsystem::GetCableSimStats(int32& OutWires, int32& OutParticles, float& OutSolveMs) const
+{
+	OutWires = SimWires.Num();
+	OutParticles = SimParticles;
+	OutSolveMs = SimSolveMs;
+}
+
+void UPowerLineSubsystem::UpdateCableSimulation(float DeltaTime)
+{
+	POWERLINE_SCOPE(PowerLine_CableSim);
+	LLM_SCOPE_BYTAG(PowerLine_Segments);
+
+	if (!bEnableCableSimulation || IsHeadless())
+	{
+		while (SimWires.Num() > 0)
+		{
+			RemoveFromSimulation(SimWires.Num() - 1);
+		}
+	}
+	else
+	{
+		// 1) Camera tier: nearest wires first, kept while within a slightly larger radius (no churn at the edge).
+		for (FSimWire& Sim : SimWires)
+		{
+			Sim.bNearCamera = false;
+		}
+
+		const UWorld* World = GetWorld();
+		if (World && SimulationCameraRadius > 0.f)
+		{
+			TArray<FPowerLineWireHit> Hits;
+			for (const FVector& ViewLocation : World->ViewLocationsRenderedLastFrame)
+			{
+				Hits.Reset();
+				FindWiresInRadius(ViewLocation, SimulationCameraRadius * 1.25f, Hits);
+				for (const FPowerLineWireHit& Hit : Hits)
+				{
+					UPowerLineComponent* Line = Hit.Wire.Get();
+					const int32 Index = (Line && Line->SimIndex == INDEX_NONE && Hit.Distance <= SimulationCameraRadius)
+						? PromoteToSimulation(Line)
+						: (Line ? Line->SimIndex : INDEX_NONE);
+					if (Index != INDEX_NONE)
+					{
+						SimWires[Index].bNearCamera = true;
+					}
+				}
+			}
+		}
+
+		// 2) Game thread: pins from the current attachments.
+		for (int32 i = SimWires.Num() - 1; i >= 0; --i)
+		{
+			FSimWire& Sim = SimWires[i];
+			UPowerLineComponent* Line = Sim.Line.Get();
+			FVector EndWS;
+			if (!Line || !Line->bRegistered || !Line->ResolveEndPoint(EndWS))
+			{
+				RemoveFromSimulation(i);
+				continue;
+			}
+
+			Sim.PinA = Line->GetComponentLocation();
+			Sim.PinB = EndWS;
+		}
+
+		// 3) Workers: one task per cable.
+		PowerLineCore::FCableSimParams Params;
+		Params.Damping = SimulationDamping;
+		Params.Iterations = SimulationIterations;
+
+		const uint64 SolveStart = FPlatformTime::Cycles64();
+		TArray<float> Speeds;
+		Speeds.SetNumZeroed(SimWires.Num());
+		ParallelFor(SimWires.Num(), [&](int32 i) {
+			FSimWire& Sim = SimWires[i];
+			Speeds[i] = Sim.State.Step(Params, Sim.PinA, Sim.PinB, DeltaTime);
+			}, SimWires.Num() < 8);
+		SimSolveMs = (float)FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - SolveStart);
+
+		// 4) Settled wires out of camera range go back to their static curve.
+		const double Now = FPlatformTime::Seconds();
+		for (int32 i = SimWires.Num() - 1; i >= 0; --i)
+		{
+			FSimWire& Sim = SimWires[i];
+			if (Speeds[i] > SimulationSettleSpeed)
+			{
+				Sim.QuietSince = 0.0;
+				continue;
+			}
+
+			if (Sim.QuietSince <= 0.0)
+			{
+				Sim.QuietSince = Now;
+			}
+			else if (!Sim.bNearCamera && Now - Sim.QuietSince >= SimulationSettleSeconds)
+			{
+				RemoveFromSimulation(i);
+			}
+		}
+	}
+
+	SET_DWORD_STAT(STAT_PowerLine_SimWires, SimWires.Num());
+	SET_DWORD_STAT(STAT_PowerLine_SimParticles, SimParticles);
+
+	// 5) Upload (every frame while anything is simulated, once more to clear).
+	SimSegments.Reset();
+	TArray<FVector> Points;
+	for (const FSimWire& Sim : SimWires)
+	{
+		const UPowerLineComponent* Line = Sim.Line.Get();
+		if (!Line) continue;
+
+		Sim.State.GetPoints(Points);
+		for (int32 p = 0; p + 1 < Points.Num(); ++p)
+		{
+			FPowerLineSegment& S = SimSegments.AddDefaulted_GetRef();
+			S.Start = Points[p];
+			S.End = Points[p + 1];
+			S.Style = Line->ResolvedSpan.Style;
+		}
+	}
+
+	INC_DWORD_STAT_BY(STAT_PowerLine_SegmentsSubmitted, SimSegments.Num());
+
+	UPowerLineRenderComponent* RC = SimRender.Get();
+	if (!RC)
+	{
+		if (SimSegments.Num() == 0) return;
+
+		AActor* Host = EnsureRenderHost();
+		if (!Host) return;
+
+		RC = NewObject<UPowerLineRenderComponent>(Host);
+		RC->SetupAttachment(Host->GetRootComponent());
+		RC->RegisterComponent();
+		SimRender = RC;
+	}
+	else if (SimSegments.Num() == 0 && RC->FrontBuffer.Num() == 0)
+	{
+		return;
+	}
+
+	RC->UpdateSegments_GameThread(SimSegments);
+}
+
+// ============================
+// Subsystem - Wire queries
+// ============================
+
+void UPowerLineSubsystem::UpdateWireQueries()
+{
+	POWERLINE_SCOPE(PowerLine_UpdateQueries);
+	LLM_SCOPE_BYTAG(PowerLine_Queries);
+
+	if (!bEnableWireQueries)
+	{
+		ChunkQueries.Reset();
+		DynamicQuery.Reset();
+		QueryDirtyChunks.Reset();
+		bDynamicQueryDirty = false;
+
+		FPowerLineQuerySnapshotPtr Old;
+		{
+			FWriteScopeLock Lock(QuerySnapshotLock);
+			Old = MoveTemp(QuerySnapshot);
+		}
+		return;
+	}
+
+	const double BuildStart = FPlatformTime::Seconds();
+
+	struct FQueryInput
+	{
+		FPowerLineChunkKey Key;
+		bool bDynamic = false;
+		TArray<TWeakObjectPtr<UPowerLineComponent>> Wires;
+		TArray<int32> LineIds;
+		TArray<FPowerLineWireBuild> Spans;
+		FPowerLineChunkQueryPtr Result;
+	};
+
+	// Game thread: copy the resolved spans (UObject access).
+	auto Gather = [](const TArray<TWeakObjectPtr<UPowerLineComponent>>& Lines, FQueryInput& In) {
+		for (const TWeakObjectPtr<UPowerLineComponent>& WLine : Lines)
+		{
+			const UPowerLineComponent* Line = WLine.Get();
+			if (!Line || !Line->bHasResolvedSpan) continue;
+
+			In.Wires.Add(WLine);
+			In.LineIds.Add(Line->LineId);
+			In.Spans.Add(Line->ResolvedSpan);
+		}
+		};
+
+	TArray<FQueryInput> Inputs;
+	Inputs.Reserve(QueryDirtyChunks.Num() + 1);
+	for (const FPowerLineChunkKey& Key : QueryDirtyChunks)
+	{
+		FQueryInput& In = Inputs.AddDefaulted_GetRef();
+		In.Key = Key;
+		if (const FPowerLineChunk* Chunk = Chunks.Find(Key))
+		{
+			Gather(Chunk->Lines, In);
+		}
+	}
+
+	if (bDynamicQueryDirty)
+	{
+		FQueryInput& In = Inputs.AddDefaulted_GetRef();
+		In.bDynamic = true;
+		Gather(DynamicLines, In);
+	}
+
+	QueryDirtyChunks.Reset();
+	bDynamicQueryDirty = false;
+
+	// Workers: curves + BVH per chunk (empty chunks publish nothing).
+	ParallelFor(Inputs.Num(), [&Inputs](int32 Index) {
+		FQueryInput& In = Inputs[Index];
+		if (In.Spans.Num() == 0) return;
+
+		TSharedPtr<FPowerLineChunkQuery, ESPMode::ThreadSafe> Query = MakeShared<FPowerLineChunkQuery, ESPMode::ThreadSafe>();
+		TArray<PowerLineCore::FWireSegment> Segments;
+		TArray<FVector> Points;
+		const FVector Origin = In.Spans[0].Start;
+
+		for (int32 i = 0; i < In.Spans.Num(); ++i)
+		{
+			// Every conductor (and both pieces of a broken wire) reports its component.
+			In.Spans[i].ForEachPolyline(Points, [&](TArrayView<const FVector> Polyline, uint32, float, float) {
+				PowerLineCore::AppendWireSegments(Polyline, Origin, i, Segments);
+				});
+		}
+
+		Query->BVH.Build(MoveTemp(Segments), Origin);
+		Query->Bounds = Query->BVH.GetBounds();
+		Query->Wires = MoveTemp(In.Wires);
+		Query->LineIds = MoveTemp(In.LineIds);
+		In.Result = Query;
+		}, Inputs.Num() < 4);
+
+	for (FQueryInput& In : Inputs)
+	{
+		if (In.bDynamic)
+		{
+			DynamicQuery = MoveTemp(In.Result);
+		}
+		else if (In.Result)
+		{
+			ChunkQueries.Add(In.Key, MoveTemp(In.Result));
+		}
+		else
+		{
+			ChunkQueries.Remove(In.Key);
+		}
+	}
+
+	PublishQuerySnapshot(BuildStart);
+}
+
+void UPowerLineSubsystem::PublishQuerySnapshot(double BuildStart)
+{
+	// New pointer array only: unchanged chunks are shared with the previous snapshot.
+	TSharedPtr<FPowerLineQuerySnapshot, ESPMode::ThreadSafe> Next = MakeShared<FPowerLineQuerySnapshot, ESPMode::ThreadSafe>();
+	Next->Chunks.Reserve(ChunkQueries.Num() + 1);
+	Next->Bounds.Reserve(ChunkQueries.Num() + 1);
+
+	auto AddChunk = [&Next](const FPowerLineChunkQueryPtr& Query) {
+		Next->Chunks.Add(Query);
+		Next->Bounds.Add(Query->Bounds);
+		Next->NumSegments += Query->BVH.NumSegments();
+		};
+
+	for (const TPair<FPowerLineChunkKey, FPowerLineChunkQueryPtr>& Pair : ChunkQueries)
+	{
+		AddChunk(Pair.Value);
+	}
+	if (DynamicQuery)
+	{
+		AddChunk(DynamicQuery);
+	}
+
+	Next->Version = ++QuerySnapshotVersion;
+	Next->BuildMs = (FPlatformTime::Seconds() - BuildStart) * 1000.0;
+
+	// The previous snapshot is released outside the lock (freed here unless a reader still holds it).
+	FPowerLineQuerySnapshotPtr Old;
+	{
+		FWriteScopeLock Lock(QuerySnapshotLock);
+		Old = MoveTemp(QuerySnapshot);
+		QuerySnapshot = MoveTemp(Next);
+	}
+}
+
+FPowerLineQuerySnapshotPtr UPowerLineSubsystem::GetQuerySnapshot() const
+{
+	FReadScopeLock Lock(QuerySnapshotLock);
+	return QuerySnapshot;
+}
+
+static void ToWireHit(const FPowerLineChunkQuery& Query, const PowerLineCore::FSegmentHit& Hit, FPowerLineWireHit& Out)
+{
+	Out.Wire = Query.Wires[Hit.Wire];
+	Out.LineId = Query.LineIds[Hit.Wire];
+	Out.Distance = Hit.Distance;
+	Out.DistanceAlongWire = Hit.DistanceAlongWire;
+	Out.Location = Hit.Location;
+}
+
+bool FPowerLineQuerySnapshot::CapsuleCast(const FVector& Start, const FVector& End, float Radius, bool bAnyHit, FPowerLineWireHit* OutHit) const
+{
+	const FBox QueryBox = FBox(Start.ComponentMin(End), Start.ComponentMax(End)).ExpandBy(Radius);
+
+	bool bFound = false;
+	float BestDistance = TNumericLimits<float>::Max();
+
+	for (int32 c = 0; c < Chunks.Num(); ++c)
+	{
+		if (!Bounds[c].Intersect(QueryBox)) continue;
+
+		const FPowerLineChunkQuery& Query = *Chunks[c];
+		PowerLineCore::FSegmentHit Hit;
+		if (!Query.BVH.CapsuleCast(Start, End, Radius, bAnyHit, Hit)) continue;
+
+		if (bAnyHit)
+		{
+			if (OutHit)
+			{
+				ToWireHit(Query, Hit, *OutHit);
+			}
+			return true;
+		}
+
+		if (Hit.Distance < BestDistance)
+		{
+			BestDistance = Hit.Distance;
+			bFound = true;
+			if (OutHit)
+			{
+				ToWireHit(Query, Hit, *OutHit);
+			}
+		}
+	}
+
+	return bFound;
+}
+
+bool FPowerLineQuerySnapshot::FindNearest(const FVector& Point, float MaxDistance, FPowerLineWireHit& OutHit) const
+{
+	float Best = (MaxDistance > 0.f) ? MaxDistance : TNumericLimits<float>::Max();
+	bool bFound = false;
+
+	for (int32 c = 0; c < Chunks.Num(); ++c)
+	{
+		// Chunks farther than the best hit so far can't contain a closer wire.
+		if (Bounds[c].ComputeSquaredDistanceToPoint(Point) > FMath::Square((double)Best)) continue;
+
+		const FPowerLineChunkQuery& Query = *Chunks[c];
+		PowerLineCore::FSegmentHit Hit;
+		if (!Query.BVH.FindNearest(Point, Best, Hit)) continue;
+
+		Best = Hit.Distance;
+		bFound = true;
+		ToWireHit(Query, Hit, OutHit);
+	}
+
+	return bFound;
+}
+
+int32 FPowerLineQuerySnapshot::FindInRadius(const FVector& Point, float Radius, TArray<FPowerLineWireHit>& OutHits) const
+{
+	const int32 FirstOut = OutHits.Num();
+	const double RadiusSq = FMath::Square((double)Radius);
+	TArray<PowerLineCore::FSegmentHit, TInlineAllocator<32>> Hits;
+
+	for (int32 c = 0; c < Chunks.Num(); ++c)
+	{
+		if (Bounds[c].ComputeSquaredDistanceToPoint(Point) > RadiusSq) continue;
+
+		// Each wire lives in exactly one chunk, so per-chunk de-duplication is enough.
+		const FPowerLineChunkQuery& Query = *Chunks[c];
+		Hits.Reset();
+		Query.BVH.FindInRadius(Point, Radius, Hits);
+		for (const PowerLineCore::FSegmentHit& Hit : Hits)
+		{
+			ToWireHit(Query, Hit, OutHits.AddDefaulted_GetRef());
+		}
+	}
+
+	Algo::Sort(TArrayView<FPowerLineWireHit>(OutHits.GetData() + FirstOut, OutHits.Num() - FirstOut),
+		[](const FPowerLineWireHit& A, const FPowerLineWireHit& B) { return A.Distance < B.Distance; });
+
+	return OutHits.Num() - FirstOut;
+}
+
+SIZE_T FPowerLineQuerySnapshot::GetAllocatedSize() const
+{
+	SIZE_T Bytes = Chunks.GetAllocatedSize() + Bounds.GetAllocatedSize();
+	for (const FPowerLineChunkQueryPtr& Query : Chunks)
+	{
+		Bytes += sizeof(FPowerLineChunkQuery) + Query->GetAllocatedSize();
+	}
+	return Bytes;
+}
+
+bool UPowerLineSubsystem::RaycastWires(const FVector& Start, const FVector& End, FPowerLineWireHit& OutHit) const
+{
+	const FPowerLineQuerySnapshotPtr Snapshot = GetQuerySnapshot();
+	return Snapshot && Snapshot->CapsuleCast(Start, End, WireQueryRadius, false, &OutHit);
+}
+
+bool UPowerLineSubsystem::SweepSphereWires(const FVector& Start, const FVector& End, float SphereRadius, FPowerLineWireHit& OutHit) const
+{
+	const FPowerLineQuerySnapshotPtr Snapshot = GetQuerySnapshot();
+	return Snapshot && Snapshot->CapsuleCast(Start, End, WireQueryRadius + FMath::Max(0.f, SphereRadius), false, &OutHit);
+}
+
+bool UPowerLineSubsystem::SegmentIntersectsWires(const FVector& Start, const FVector& End) const
+{
+	const FPowerLineQuerySnapshotPtr Snapshot = GetQuerySnapshot();
+	return Snapshot && Snapshot->CapsuleCast(Start, End, WireQueryRadius, true, nullptr);
+}
+
+bool UPowerLineSubsystem::FindNearestWire(const FVector& Point, float MaxDistance, FPowerLineWireHit& OutHit) const
+{
+	const FPowerLineQuerySnapshotPtr Snapshot = GetQuerySnapshot();
+	return Snapshot && Snapshot->FindNearest(Point, MaxDistance, OutHit);
+}
+
+int32 UPowerLineSubsystem::FindWiresInRadius(const FVector& Point, float Radius, TArray<FPowerLineWireHit>& OutHits) const
+{
+	const FPowerLineQuerySnapshotPtr Snapshot = GetQuerySnapshot();
+	return Snapshot ? Snapshot->FindInRadius(Point, Radius, OutHits) : 0;
+}
+
+void UPowerLineSubsystem::DumpQueryStats(FOutputDevice& Ar, int32 Samples) const
+{
+	const FPowerLineQuerySnapshotPtr Snapshot = GetQuerySnapshot();
+	if (!Snapshot || Snapshot->Chunks.Num() == 0)
+	{
+		Ar.Log(TEXT("powerline.QueryStats: no wire query data (bEnableWireQueries off or no wires)."));
+		return;
+	}
+
+	Ar.Logf(TEXT("==== PowerLine wire queries (%s) ===="), *GetWorld()->GetName());
+	Ar.Logf(TEXT("  Snapshot v%u: %d chunks, %d segments, %.1f KB, built in %.3f ms"),
+		Snapshot->Version, Snapshot->Chunks.Num(), Snapshot->NumSegments,
+		(double)Snapshot->GetAllocatedSize() / 1024.0, Snapshot->BuildMs);
+
+	// Latency: points/rays around random chunk centers (same snapshot for every sample).
+	Samples = FMath::Max(1, Samples);
+	FRandomStream Rand(Samples);
+	TArray<FVector> Points;
+	Points.SetNum(Samples);
+	for (FVector& P : Points)
+	{
+		const FBox& Box = Snapshot->Bounds[Rand.RandHelper(Snapshot->Bounds.Num())];
+		P = Box.GetCenter() + Rand.GetUnitVector() * Box.GetExtent().GetMax();
+	}
+
+	FPowerLineWireHit Hit;
+	TArray<FPowerLineWireHit> Hits;
+	auto TimeUs = [&](auto&& Fn) {
+		const uint64 Start = FPlatformTime::Cycles64();
+		for (const FVector& P : Points)
+		{
+			Fn(P);
+		}
+		return FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - Start) * 1000.0 / (double)Samples;
+		};
+
+	const double RayUs = TimeUs([&](const FVector& P) { Snapshot->CapsuleCast(P, P + FVector(5000.f, 0.f, 0.f), WireQueryRadius, false, &Hit); });
+	const double NearestUs = TimeUs([&](const FVector& P) { Snapshot->FindNearest(P, 0.f, Hit); });
+	const double RadiusUs = TimeUs([&](const FVector& P) { Hits.Reset(); Snapshot->FindInRadius(P, 1000.f, Hits); });
+
+	Ar.Logf(TEXT("  Latency (%d samples): raycast %.2f us, nearest %.2f us, radius(10m) %.2f us"), Samples, RayUs, NearestUs, RadiusUs);
+}
+
+static void PowerLineQueryStatsCommand(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+{
+	const UPowerLineSubsystem* Sub = World ? World->GetSubsystem<UPowerLineSubsystem>() : nullptr;
+	if (!Sub)
+	{
+		Ar.Log(TEXT("powerline.QueryStats: no PowerLine subsystem in this world."));
+		return;
+	}
 
-	// Move between chunks if needed
-	if (!Line->bHasKey || !(Line->CurrentKey == NewKey))
+	Sub->DumpQueryStats(Ar, Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 1000);
+}
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GPowerLineQueryStatsCommand(
+	TEXT("powerline.QueryStats"),
+	TEXT("Wire query snapshot size and sampled query latency. Usage: powerline.QueryStats [Samples]"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&PowerLineQueryStatsCommand));
+
+// ============================
+// Batch edits
+// ============================
+
+void UPowerLineSubsystem::BeginBatchEdit()
+{
+	++BatchEditDepth;
+}
+
+void UPowerLineSubsystem::EndBatchEdit()
+{
+	if (BatchEditDepth <= 0)
 	{
-		UpdateLineChunk(Line, NewKey);
+		UE_LOG(LogPowerLine, Warning, TEXT("EndBatchEdit called without a matching BeginBatchEdit."));
+		return;
 	}
 
-	DirtyChunks.Add(Line->CurrentKey);
+	if (--BatchEditDepth == 0)
+	{
+		FlushBatchEdit();
+	}
 }
 
-void UPowerLineSubsystem::RemoveHangingForLine(UPowerLineComponent* Line)
+void UPowerLineSubsystem::BeginFrameBatchEdit()
 {
-	if (!Line) return;
+	if (bFrameBatchOpen) return;
 
-	if (TWeakObjectPtr<UStaticMeshComponent>* C = HangingByLine.Find(Line))
+	bFrameBatchOpen = true;
+	BeginBatchEdit();
+}
+
+bool UPowerLineSubsystem::DeferTargetRebind(UPowerLineComponent* Line)
+{
+	if (BatchEditDepth <= 0) return false;
+
+	DeferredRebinds.Add(Line);
+	return true;
+}
+
+bool UPowerLineSubsystem::DeferDistrictRefresh(APowerLineDistrictDataManager* District)
+{
+	if (BatchEditDepth <= 0) return false;
+
+	DeferredDistricts.Add(District);
+	return true;
+}
+
+void UPowerLineSubsystem::FlushBatchEdit()
+{
+	// Take the queues first: flushing goes back through the normal (now immediate) paths.
+	TSet<TWeakObjectPtr<UPowerLineComponent>> Rebinds = MoveTemp(DeferredRebinds);
+	TSet<TWeakObjectPtr<APowerLineDistrictDataManager>> Districts = MoveTemp(DeferredDistricts);
+	TMap<TWeakObjectPtr<UPowerLineComponent>, EPowerLineDirtyCause> Dirty = MoveTemp(DeferredDirty);
+	DeferredRebinds.Reset();
+	DeferredDistricts.Reset();
+	DeferredDirty.Reset();
+
+	for (const TWeakObjectPtr<UPowerLineComponent>& WLine : Rebinds)
 	{
-		if (UStaticMeshComponent* Comp = C->Get())
+		UPowerLineComponent* Line = WLine.Get();
+		if (Line && Line->IsRegistered())
 		{
-			Comp->DestroyComponent();
+			Line->RefreshTargetBinding();
+		}
+	}
+
+	for (const TWeakObjectPtr<APowerLineDistrictDataManager>& WDistrict : Districts)
+	{
+		if (APowerLineDistrictDataManager* District = WDistrict.Get())
+		{
+			District->MarkAllDistrictWiresDirty();
+		}
+	}
+
+	for (const TPair<TWeakObjectPtr<UPowerLineComponent>, EPowerLineDirtyCause>& Pair : Dirty)
+	{
+		UPowerLineComponent* Line = Pair.Key.Get();
+		if (Line && Line->bRegistered)
+		{
+			MarkPowerLineDirty(Line, Pair.Value);
 		}
-		HangingByLine.Remove(Line);
+	}
+
+	// One rebuild for the whole batch (parallel above ParallelRebuildMinWires).
+	if (DirtyChunks.Num() > 0)
+	{
+		RebuildDirtyChunks();
 	}
 }
 
-void UPowerLineSubsystem::UpdateHangingForLine(UPowerLineComponent* Line)
+FPowerLineBatchEditScope::FPowerLineBatchEditScope(UWorld* World)
+	: Subsystem(World ? World->GetSubsystem<UPowerLineSubsystem>() : nullptr)
 {
-	if (!Line) return;
+	if (UPowerLineSubsystem* Sub = Subsystem.Get())
+	{
+		Sub->BeginBatchEdit();
+	}
+}
 
-	APowerLineDistrictDataManager* DM = Line->ResolveDistrictManager();
-	if (!DM)
+FPowerLineBatchEditScope::~FPowerLineBatchEditScope()
+{
+	if (UPowerLineSubsystem* Sub = Subsystem.Get())
 	{
-		RemoveHangingForLine(Line);
-		return;
+		Sub->EndBatchEdit();
 	}
+}
 
-	FVector EndWS;
-	if (!Line->ResolveEndPoint(EndWS))
+void UPowerLineSubsystem::Tick(float DeltaTime)
+{
+	POWERLINE_SCOPE(PowerLine_Tick);
+
+	const bool bWatchdog = CVarPowerLineWatchdog.GetValueOnGameThread() != 0;
+	const double TickStart = bWatchdog ? FPlatformTime::Seconds() : 0.0;
+	if (!bWatchdog && WatchdogEntries.Num() > 0)
 	{
-		RemoveHangingForLine(Line);
-		return;
+		WatchdogEntries.Reset();
 	}
 
-	UStaticMesh* Mesh = nullptr;
-	float N = 0.5f;
-	float YawDeg = 0.f;
+	// Editor multi-edit / undo batch opened since last frame.
+	if (bFrameBatchOpen)
+	{
+		bFrameBatchOpen = false;
+		EndBatchEdit();
+	}
 
-	if (!DM->GetHangingForLine(Line->GetComponentLocation(), EndWS, Line->LineId, Mesh, N, YawDeg))
+	// Before the rebuild stages, so pending dirty chunks show up as backlog.
+	if (const int32 HeatmapMode = CVarPowerLineDebugHeatmap.GetValueOnGameThread())
 	{
-		RemoveHangingForLine(Line);
-		return;
+		DrawDebugHeatmap(HeatmapMode);
 	}
 
-	AActor* Host = EnsureRenderHost();
-	if (!Host) return;
+	// Wind edited in the details panel or set from code: one push to every render component, no rebuild.
+	if (!IsHeadless())
+	{
+		PushWindToRenderComponents();
+	}
 
-	UStaticMeshComponent* Comp = nullptr;
-	if (TWeakObjectPtr<UStaticMeshComponent>* Existing = HangingByLine.Find(Line))
+	// Dynamic first: promotions/demotions dirty static chunks that are then rebuilt in the same frame.
+	if (DynamicLines.Num() > 0 || bDynamicDirty)
 	{
-		Comp = Existing->Get();
+		UpdateDynamicLines();
 	}
-	if (!Comp)
+
+	// Same for simulation promotions/demotions.
+	if (bEnableCableSimulation || SimWires.Num() > 0)
 	{
-		Comp = NewObject<UStaticMeshComponent>(Host);
-		Comp->SetupAttachment(Host->GetRootComponent());
-		Comp->RegisterComponent();
-		HangingByLine.Add(Line, Comp);
+		UpdateCableSimulation(DeltaTime);
 	}
 
-	Comp->SetStaticMesh(Mesh);
-	Comp->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-	Comp->SetGenerateOverlapEvents(false);
+	if (bAdaptiveChunking)
+	{
+		const double Now = FPlatformTime::Seconds();
+		if (Now - LastMergeCheckTime >= AdaptiveMergeIntervalSeconds)
+		{
+			LastMergeCheckTime = Now;
+			MergeSparseChunks();
+		}
+	}
+	else if (SplitChunks.Num() > 0)
+	{
+		// Adaptive chunking was turned off: collapse everything back to the root grid.
+		TArray<FPowerLineChunkKey> Keys;
+		Chunks.GetKeys(Keys);
+		SplitChunks.Reset();
+		for (const FPowerLineChunkKey& Key : Keys)
+		{
+			if (Key.Level > 0)
+			{
+				RehomeChunkLines(Key);
+			}
+		}
+	}
 
-	// Place along wire, accounting for sag at sample point N.
-	const FVector StartWS = Line->GetComponentLocation();
-	const FVector Pos = FMath::Lerp(StartWS, EndWS, N);
-	const float EffectiveSag = DM->GetSagForLine(StartWS, EndWS, Line->LineId);
-	const float SagFactor = FMath::Clamp(4.f * N * (1.f - N), 0.f, 1.f);
-	const FVector SaggedPos = Pos - FVector(0, 0, EffectiveSag * SagFactor);
+	if (DirtyChunks.Num() > 0)
+	{
+		RebuildDirtyChunks();
+	}
 
-	// Rotate around tangent
-	const FVector Tangent = (EndWS - StartWS).GetSafeNormal();
-	const FRotator Rot = FRotationMatrix::MakeFromX(Tangent).Rotator() + FRotator(0.f, YawDeg, 0.f);
+	// Chunks with wire segments rewritten in place (SetWireStyle, BreakWire, ReconnectWire).
+	if (InPlaceUploadChunks.Num() > 0)
+	{
+		for (const FPowerLineChunkKey& Key : InPlaceUploadChunks)
+		{
+			const FPowerLineChunk* Chunk = Chunks.Find(Key);
+			const TWeakObjectPtr<UPowerLineRenderComponent>* RCW = RenderComponents.Find(Key);
+			UPowerLineRenderComponent* RC = RCW ? RCW->Get() : nullptr;
+			if (Chunk && RC)
+			{
+				RC->UpdateSegments_GameThread(Chunk->BatchedSegments);
+			}
+		}
+		InPlaceUploadChunks.Reset();
+	}
 
-	FTransform T;
-	T.SetLocation(SaggedPos - FVector(0, 0, DM->Hanging.DownOffsetCm));
-	T.SetRotation(Rot.Quaternion());
-	T.SetScale3D(FVector(1));
+	if (HeadlessDirtyLines.Num() > 0)
+	{
+		UpdateHeadlessLines();
+	}
 
-	Comp->SetWorldTransform(T);
+	if (EmptyChunks.Num() > 0)
+	{
+		ReclaimEmptyChunks();
+	}
+
+	// Process poles even if no line chunks are dirty.
+
+	if (DirtyPoles.Num() > 0)
+	{
+		ProcessDirtyPoles();
+	}
+
+	if (QueryDirtyChunks.Num() > 0 || bDynamicQueryDirty || (!bEnableWireQueries && QuerySnapshot))
+	{
+		UpdateWireQueries();
+	}
+
+	if (bWatchdog)
+	{
+		UpdateWatchdog((FPlatformTime::Seconds() - TickStart) * 1000.0);
+	}
 }
 
-void UPowerLineSubsystem::Tick(float)
+void UPowerLineSubsystem::RebuildDirtyChunks()
 {
-	// Process poles even if no line chunks are dirty.
-	if (DirtyChunks.Num() == 0 && DirtyPoles.Num() == 0) return;
+	if (IsHeadless())
+	{
+		RebuildDirtyChunksHeadless();
+		return;
+	}
 
+	POWERLINE_SCOPE(PowerLine_RebuildChunks);
+	LLM_SCOPE_BYTAG(PowerLine_Segments);
+	SET_DWORD_STAT(STAT_PowerLine_DirtyChunks, DirtyChunks.Num());
+
+	PowerLineCore::FShapeCache* Cache = bUseShapeCache ? &ShapeCache : nullptr;
+	ShapeCache.MaxEntries = ShapeCacheMaxEntries;
+	const bool bWatchdog = CVarPowerLineWatchdog.GetValueOnGameThread() != 0;
+
+	struct FChunkWork
+	{
+		FPowerLineChunkKey Key;
+		FPowerLineChunk* Chunk = nullptr;
+		int32 FirstWire = 0;
+		int32 NumWires = 0;
+	};
+
+	// 1) Game thread: drop dead wires, resolve endpoints + district policy (UObject access).
+	TArray<FChunkWork> Work;
+	Work.Reserve(DirtyChunks.Num());
+	TArray<FPowerLineWireBuild> Builds;
+	TArray<UPowerLineComponent*> BuildLines;
+	TArray<bool> BuildValid;
+	TArray<double> BuildMs;
+
+	const double Now = FPlatformTime::Seconds();
 	for (const FPowerLineChunkKey& Key : DirtyChunks)
 	{
 		FPowerLineChunk* Chunk = Chunks.Find(Key);
 		if (!Chunk) continue;
 
-		Chunk->BatchedSegments.Reset();
-
-		// Build
 		for (int32 i = Chunk->Lines.Num() - 1; i >= 0; --i)
 		{
-			TWeakObjectPtr<UPowerLineComponent> WLine = Chunk->Lines[i];
+			if (Chunk->Lines[i].IsValid()) continue;
+
+			Chunk->Lines.RemoveAtSwap(i);
+			if (Chunk->Lines.IsValidIndex(i))
+			{
+				if (UPowerLineComponent* Swapped = Chunk->Lines[i].Get())
+				{
+					Swapped->ChunkIndex = i;
+				}
+			}
+		}
+
+		Chunk->RebuildHeat = GetDecayedHeat(*Chunk, Now) + 1.f;
+		Chunk->HeatTime = Now;
+
+		FChunkWork& W = Work.AddDefaulted_GetRef();
+		W.Key = Key;
+		W.Chunk = Chunk;
+		W.FirstWire = Builds.Num();
+		W.NumWires = Chunk->Lines.Num();
+
+		for (const TWeakObjectPtr<UPowerLineComponent>& WLine : Chunk->Lines)
+		{
 			UPowerLineComponent* Line = WLine.Get();
-			if (!Line)
+			const uint64 WireStart = bWatchdog ? FPlatformTime::Cycles64() : 0;
+
+			BuildLines.Add(Line);
+			FPowerLineWireBuild& Build = Builds.AddDefaulted_GetRef();
+			Line->bHasResolvedSpan = Line->ResolveBuildInputs(Build);
+			if (Line->bHasResolvedSpan)
+			{
+				ResolveBuildResources(Line, Build);
+			}
+			Line->ResolvedSpan = Build;
+
+			// Simulated wires are drawn from their particles (span still resolved for queries/hanging).
+			BuildValid.Add(Line->bHasResolvedSpan && Line->SimIndex == INDEX_NONE);
+			BuildMs.Add(bWatchdog ? FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - WireStart) : 0.0);
+		}
+	}
+
+	const bool bParallel = Builds.Num() >= ParallelRebuildMinWires;
+
+	// 2) Shapes: cache lookups on the game thread, missing shapes built in parallel.
+	if (Cache)
+	{
+		TMap<PowerLineCore::FShapeKey, int32> MissingIndex;
+		TArray<PowerLineCore::FShapeKey> Missing;
+		TArray<int32> WireMissing;
+		WireMissing.Init(INDEX_NONE, Builds.Num());
+
+		for (int32 i = 0; i < Builds.Num(); ++i)
+		{
+			if (!BuildValid[i]) continue;
+			if (Builds[i].Bundle || Builds[i].BreakT >= 0.f || Builds[i].bUniqueSag)
 			{
-				Chunk->Lines.RemoveAtSwap(i);
+				++Cache->Bypassed;
 				continue;
 			}
 
-			Line->BuildSegments(Chunk->BatchedSegments);
+			FPowerLineWireBuild& B = Builds[i];
+			const PowerLineCore::FShapeKey Key = PowerLineCore::FShapeCache::MakeKey(B.End - B.Start, B.Sag, B.Segments);
+			B.Shape = Cache->Find(Key);
+			if (!B.Shape)
+			{
+				int32* Idx = MissingIndex.Find(Key);
+				WireMissing[i] = Idx ? *Idx : MissingIndex.Add(Key, Missing.Add(Key));
+			}
+		}
+
+		TArray<TSharedPtr<PowerLineCore::FShape, ESPMode::ThreadSafe>> Built;
+		Built.SetNum(Missing.Num());
+		ParallelFor(Missing.Num(), [&](int32 i) {
+			Built[i] = PowerLineCore::FShapeCache::BuildShape(Missing[i]);
+			}, !bParallel);
+
+		TArray<PowerLineCore::FShapePtr> Added;
+		Added.Reserve(Missing.Num());
+		for (int32 i = 0; i < Missing.Num(); ++i)
+		{
+			Added.Add(Cache->Add(Missing[i], Built[i].ToSharedRef()));
+		}
+
+		for (int32 i = 0; i < Builds.Num(); ++i)
+		{
+			if (WireMissing[i] != INDEX_NONE)
+			{
+				Builds[i].Shape = Added[WireMissing[i]];
+			}
+
+			// Wire -> shape link (GetShapeInstances); the span was copied before the lookup.
+			BuildLines[i]->ResolvedSpan.Shape = Builds[i].Shape;
+		}
+	}
+
+	// 3) Emit segments, one task per chunk (each chunk owns its arrays).
+	TArray<int32> BuildSegCount;
+	TArray<int32> BuildSegFirst;
+	BuildSegCount.SetNumZeroed(Builds.Num());
+	BuildSegFirst.Init(INDEX_NONE, Builds.Num());
+
+	ParallelFor(Work.Num(), [&](int32 WorkIdx) {
+		const FChunkWork& W = Work[WorkIdx];
+		FPowerLineChunk* Chunk = W.Chunk;
+
+		// Per-chunk Insights scope (name is only formatted while the channel is enabled).
+		const bool bTraceChunk = UE_TRACE_CHANNELEXPR_IS_ENABLED(PowerLineChannel);
+		FString ChunkScopeName;
+		if (bTraceChunk)
+		{
+			ChunkScopeName = FString::Printf(TEXT("PowerLine Chunk (%d, %d, %d) L%d [%d wires]"),
+				W.Key.Coord.X, W.Key.Coord.Y, W.Key.Z, (int32)W.Key.Level, W.NumWires);
+		}
+		TRACE_CPUPROFILER_EVENT_SCOPE_TEXT_ON_CHANNEL(bTraceChunk ? *ChunkScopeName : TEXT("PowerLine Chunk"), PowerLineChannel);
+
+		Chunk->BatchedSegments.Reset();
+
+		TArray<FVector> Scratch;
+		for (int32 i = W.FirstWire; i < W.FirstWire + W.NumWires; ++i)
+		{
+			if (!BuildValid[i]) continue;
+
+			const FPowerLineWireBuild& B = Builds[i];
+			const uint64 WireStart = bWatchdog ? FPlatformTime::Cycles64() : 0;
+			const int32 NumBefore = Chunk->BatchedSegments.Num();
+			B.Emit(Scratch, Chunk->BatchedSegments);
+			BuildSegCount[i] = Chunk->BatchedSegments.Num() - NumBefore;
+			BuildSegFirst[i] = NumBefore;
+
+			if (bWatchdog)
+			{
+				BuildMs[i] += FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - WireStart);
+			}
+		}
+		}, !bParallel);
+
+	// 4) Game thread: hanging meshes, upload, chunk lifecycle.
+	TArray<FPowerLineChunkKey> ToSplit;
+
+	for (const FChunkWork& W : Work)
+	{
+		const FPowerLineChunkKey& Key = W.Key;
+		FPowerLineChunk* Chunk = W.Chunk;
+
+		for (int32 i = W.FirstWire; i < W.FirstWire + W.NumWires; ++i)
+		{
+			UPowerLineComponent* Line = BuildLines[i];
+			const uint64 WireStart = bWatchdog ? FPlatformTime::Cycles64() : 0;
+
+			Line->LastSegmentCount = BuildSegCount[i];
+			Line->SegmentFirst = BuildSegFirst[i];
 			UpdateHangingForLine(Line);
+			INC_DWORD_STAT(STAT_PowerLine_WiresRebuilt);
+
+			if (bWatchdog)
+			{
+				RecordWireRebuild(Line, BuildMs[i] + FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - WireStart));
+			}
+		}
+
+		INC_DWORD_STAT_BY(STAT_PowerLine_SegmentsSubmitted, Chunk->BatchedSegments.Num());
+
+		if (bEnableWireQueries)
+		{
+			QueryDirtyChunks.Add(Key);
 		}
 
-		EnsureRenderComponent(Key);
+		// Empty chunks don't need a component (an existing one is still cleared below).
+		if (Chunk->BatchedSegments.Num() > 0)
+		{
+			EnsureRenderComponent(Key);
+		}
 
 		if (TWeakObjectPtr<UPowerLineRenderComponent>* RCW = RenderComponents.Find(Key))
 		{
@@ -1115,6 +5090,24 @@ void UPowerLineSubsystem::Tick(float)
 				RC->UpdateSegments_GameThread(Chunk->BatchedSegments);
 			}
 		}
+
+		if (Chunk->Lines.Num() == 0)
+		{
+			if (Chunk->EmptySince <= 0.0)
+			{
+				Chunk->EmptySince = FPlatformTime::Seconds();
+			}
+			EmptyChunks.Add(Key);
+		}
+		else
+		{
+			Chunk->EmptySince = 0.0;
+		}
+
+		if (bAdaptiveChunking && Chunk->BatchedSegments.Num() > SplitSegmentThreshold && Key.Level < MaxSplitDepth)
+		{
+			ToSplit.Add(Key);
+		}
 	}
 
 	// Cleanup hanging comps for destroyed lines
@@ -1122,35 +5115,115 @@ void UPowerLineSubsystem::Tick(float)
 	{
 		if (!It->Key.IsValid())
 		{
-			if (UStaticMeshComponent* C = It->Value.Get())
-			{
-				C->DestroyComponent();
-			}
+			DestroyHangingComponent(It->Value.Get());
 			It.RemoveCurrent();
 		}
 	}
 
 	DirtyChunks.Reset();
 
-	// ===== process dirty poles =====
-	if (DirtyPoles.Num() > 0)
+	// Children are rebuilt next frame together with the emptied parent (no gap, no double draw).
+	for (const FPowerLineChunkKey& Key : ToSplit)
+	{
+		SplitChunk(Key);
+	}
+}
+
+void UPowerLineSubsystem::UpdateDynamicLines()
+{
+	POWERLINE_SCOPE(PowerLine_UpdateDynamic);
+	LLM_SCOPE_BYTAG(PowerLine_Segments);
+
+	// Settle: Auto wires that stopped moving go back to static chunks.
+	const double Now = FPlatformTime::Seconds();
+	for (int32 i = DynamicLines.Num() - 1; i >= 0; --i)
 	{
-		TArray<TWeakObjectPtr<UPowerLinePoleComponent>> ToProcess;
-		ToProcess.Reserve(DirtyPoles.Num());
-		for (const auto& P : DirtyPoles)
+		UPowerLineComponent* Line = DynamicLines[i].Get();
+		if (!Line)
+		{
+			DynamicLines.RemoveAtSwap(i);
+			if (DynamicLines.IsValidIndex(i))
+			{
+				if (UPowerLineComponent* Swapped = DynamicLines[i].Get())
+				{
+					Swapped->DynamicIndex = i;
+				}
+			}
+			bDynamicDirty = true;
+			continue;
+		}
+
+		if (Line->WireMobility == EPowerLineWireMobility::Auto && (Now - Line->LastMoveTime) > DynamicSettleSeconds)
 		{
-			ToProcess.Add(P);
+			DemoteToStatic(Line);
 		}
-		DirtyPoles.Reset();
+	}
 
-		for (const auto& WeakPole : ToProcess)
+	if (!bDynamicDirty) return;
+	bDynamicDirty = false;
+	bDynamicQueryDirty = bEnableWireQueries;
+
+	// Cheap path: small buffer, no shape cache (moving spans never repeat), cached district.
+	const bool bWatchdog = CVarPowerLineWatchdog.GetValueOnGameThread() != 0;
+	TArray<FVector> Scratch;
+	DynamicSegments.Reset();
+	for (const TWeakObjectPtr<UPowerLineComponent>& WLine : DynamicLines)
+	{
+		if (UPowerLineComponent* Line = WLine.Get())
 		{
-			if (UPowerLinePoleComponent* Pole = WeakPole.Get())
+			const uint64 WireStart = bWatchdog ? FPlatformTime::Cycles64() : 0;
+			const int32 NumBefore = DynamicSegments.Num();
+			Line->bHasResolvedSpan = Line->ResolveBuildInputs(Line->ResolvedSpan);
+			if (Line->bHasResolvedSpan)
+			{
+				ResolveBuildResources(Line, Line->ResolvedSpan);
+				Line->ResolvedSpan.Emit(Scratch, DynamicSegments);
+			}
+			Line->LastSegmentCount = DynamicSegments.Num() - NumBefore;
+			UpdateHangingForLine(Line);
+			INC_DWORD_STAT(STAT_PowerLine_WiresRebuilt);
+
+			if (bWatchdog)
 			{
-				UpdatePoleInstance(Pole);
+				RecordWireRebuild(Line, FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - WireStart));
 			}
 		}
 	}
+
+	INC_DWORD_STAT_BY(STAT_PowerLine_SegmentsSubmitted, DynamicSegments.Num());
+
+	UPowerLineRenderComponent* RC = DynamicRender.Get();
+	if (!RC)
+	{
+		AActor* Host = EnsureRenderHost();
+		if (!Host) return;
+
+		RC = NewObject<UPowerLineRenderComponent>(Host);
+		RC->SetupAttachment(Host->GetRootComponent());
+		RC->RegisterComponent();
+		DynamicRender = RC;
+	}
+
+	RC->UpdateSegments_GameThread(DynamicSegments);
+}
+
+void UPowerLineSubsystem::ProcessDirtyPoles()
+{
+	TArray<TWeakObjectPtr<UPowerLinePoleComponent>> ToProcess;
+	ToProcess.Reserve(DirtyPoles.Num());
+	for (const auto& P : DirtyPoles)
+	{
+		ToProcess.Add(P);
+	}
+	DirtyPoles.Reset();
+
+	for (const auto& WeakPole : ToProcess)
+	{
+		if (UPowerLinePoleComponent* Pole = WeakPole.Get())
+		{
+			UpdatePoleInstance(Pole);
+		}
+	}
 }
 
 // ============================
@@ -1165,7 +5238,8 @@ UPowerLinePoleComponent::UPowerLinePoleComponent()
 
 UStaticMesh* UPowerLinePoleComponent::ResolveMeshAndMaybeHideSource()
 {
-	if (PoleMesh)
+	// Explicit mesh: only returned when loaded (subsystem streams it in).
+	if (!PoleMesh.IsNull())
 	{
 		return PoleMesh.Get();
 	}
@@ -1324,6 +5398,8 @@ UHierarchicalInstancedStaticMeshComponent* UPowerLineSubsystem::GetOrCreatePoleH
 	HISM->SetGenerateOverlapEvents(false);
 	HISM->CastShadow = true;
 
+	AddMeshUser(Mesh);
+
 	FPoleHISMData Data;
 	Data.HISM = HISM;
 	PoleHISMs.Add(HKey, MoveTemp(Data));
@@ -1430,6 +5506,14 @@ void UPowerLineSubsystem::RemovePoleInstance(UPowerLinePoleComponent* Pole)
 		}
 	}
 
+	// Last instance gone: destroy the HISM so its mesh can be released.
+	if (HISM->GetInstanceCount() == 0)
+	{
+		HISM->DestroyComponent();
+		PoleHISMs.Remove(HKey);
+		ReleaseMeshUser(FSoftObjectPath(Mesh));
+	}
+
 	PoleRefs.Remove(Pole);
 
 	Pole->bRegistered = false;
@@ -1442,6 +5526,16 @@ void UPowerLineSubsystem::UpdatePoleInstance(UPowerLinePoleComponent* Pole)
 {
 	if (!Pole || !IsValid(Pole)) return;
 
+	POWERLINE_SCOPE(PowerLine_PoleUpdate);
+	LLM_SCOPE_BYTAG(PowerLine_Poles);
+
+	// Soft mesh not loaded yet: drop any stale instance, the pole is re-added when streaming completes.
+	if (!Pole->PoleMesh.IsNull() && !RequestMesh(Pole->PoleMesh, Pole))
+	{
+		RemovePoleInstance(Pole);
+		return;
+	}
+
 	UStaticMesh* Mesh = Pole->ResolveMeshAndMaybeHideSource();
 	if (!Mesh)
 	{
@@ -1450,7 +5544,7 @@ void UPowerLineSubsystem::UpdatePoleInstance(UPowerLinePoleComponent* Pole)
 	}
 
 	const FTransform XfWS = Pole->GetInstanceTransformWS();
-	const FPowerLineChunkKey NewKey = CalcKey(XfWS.GetLocation());
+	const FPowerLineChunkKey NewKey = CalcRootKey(XfWS.GetLocation());
 
 	FPoleInstanceRef* Ref = PoleRefs.Find(Pole);
 	if (!Ref)
@@ -1479,6 +5573,7 @@ void UPowerLineSubsystem::UpdatePoleInstance(UPowerLinePoleComponent* Pole)
 void UPowerLineSubsystem::RegisterPole(UPowerLinePoleComponent* Pole)
 {
 	if (!Pole) return;
+	LLM_SCOPE_BYTAG(PowerLine_Poles);
 	MarkPoleDirty(Pole);
 }
 
@@ -1491,17 +5586,115 @@ void UPowerLineSubsystem::UnregisterPole(UPowerLinePoleComponent* Pole)
 
 void UPowerLineSubsystem::MarkPoleDirty(UPowerLinePoleComponent* Pole)
 {
-	if (!Pole) return;
+	if (!Pole || IsHeadless()) return;
 	DirtyPoles.Add(Pole);
 }
 
+// ============================
+// Subsystem - Mesh streaming
+// ============================
+
+UStaticMesh* UPowerLineSubsystem::RequestMesh(const TSoftObjectPtr<UStaticMesh>& Mesh, UObject* Requester)
+{
+	if (Mesh.IsNull()) return nullptr;
+
+	if (UStaticMesh* Loaded = Mesh.Get())
+	{
+		return Loaded;
+	}
+
+	const FSoftObjectPath Path = Mesh.ToSoftObjectPath();
+	FStreamedMesh& Entry = StreamedMeshes.FindOrAdd(Path);
+	if (Requester)
+	{
+		Entry.Waiting.AddUnique(Requester);
+	}
+
+	if (!Entry.Handle.IsValid())
+	{
+		Entry.Handle = MeshStreamable.RequestAsyncLoad(
+			Path,
+			FStreamableDelegate::CreateUObject(this, &UPowerLineSubsystem::OnMeshLoaded, Path));
+	}
+
+	return nullptr;
+}
+
+void UPowerLineSubsystem::OnMeshLoaded(FSoftObjectPath Path)
+{
+	FStreamedMesh* Entry = StreamedMeshes.Find(Path);
+	if (!Entry) return;
+
+	TArray<TWeakObjectPtr<UObject>> Waiting = MoveTemp(Entry->Waiting);
+	Entry->Waiting.Reset();
+
+	// Apply right away so users are counted before we decide to keep the handle.
+	for (const TWeakObjectPtr<UObject>& WeakObj : Waiting)
+	{
+		UObject* Obj = WeakObj.Get();
+		if (!Obj) continue;
+
+		if (UPowerLineComponent* Line = Cast<UPowerLineComponent>(Obj))
+		{
+			UpdateHangingForLine(Line);
+		}
+		else if (UPowerLinePoleComponent* Pole = Cast<UPowerLinePoleComponent>(Obj))
+		{
+			DirtyPoles.Remove(Pole);
+			UpdatePoleInstance(Pole);
+		}
+		else if (UPowerLineMultiPoleComponent* Multi = Cast<UPowerLineMultiPoleComponent>(Obj))
+		{
+			Multi->RebuildNow();
+		}
+	}
+
+	// Nobody ended up using it (wires moved/unregistered meanwhile).
+	Entry = StreamedMeshes.Find(Path);
+	if (Entry && Entry->Users <= 0 && Entry->Waiting.Num() == 0)
+	{
+		if (Entry->Handle.IsValid())
+		{
+			Entry->Handle->ReleaseHandle();
+		}
+		StreamedMeshes.Remove(Path);
+	}
+}
+
+void UPowerLineSubsystem::AddMeshUser(const UStaticMesh* Mesh)
+{
+	if (!Mesh) return;
+
+	// Meshes loaded by someone else are counted too, so the entry is dropped consistently.
+	StreamedMeshes.FindOrAdd(FSoftObjectPath(Mesh)).Users++;
+}
+
+void UPowerLineSubsystem::ReleaseMeshUser(const FSoftObjectPath& Path)
+{
+	FStreamedMesh* Entry = StreamedMeshes.Find(Path);
+	if (!Entry) return;
+
+	Entry->Users = FMath::Max(0, Entry->Users - 1);
+	if (Entry->Users > 0 || Entry->Waiting.Num() > 0) return;
+
+	// No chunk uses it anymore: let GC unload it.
+	if (Entry->Handle.IsValid())
+	{
+		Entry->Handle->ReleaseHandle();
+	}
+	StreamedMeshes.Remove(Path);
+}
+
 // ============================
 // Multi Pole Component
 // ============================
 
 UPowerLineMultiPoleComponent::UPowerLineMultiPoleComponent()
 {
-	PrimaryComponentTick.bCanEverTick = false;
+	// Ticks only in spline mode, to pick up spline edits (cheap version compare).
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+	bTickInEditor = true;
 	SetMobility(EComponentMobility::Movable);
 }
 
@@ -1515,6 +5708,9 @@ void UPowerLineMultiPoleComponent::OnRegister()
 			this, &UPowerLineMultiPoleComponent::HandleTransformChanged);
 	}
 
+	SetComponentTickEnabled(bFollowSpline);
+	CachedSplineOwnerComponents = INDEX_NONE;
+
 	EnsureRuntimeComponents();
 	RebuildNow();
 }
@@ -1527,6 +5723,22 @@ void UPowerLineMultiPoleComponent::OnUnregister()
 		TransformChangedHandle.Reset();
 	}
 
+	ReleaseHeldMesh();
+
+	if (UPowerLineSubsystem* Sub = GetPowerLineSubsystem(this))
+	{
+		Sub->ReleaseSharedStyle(HeldSharedStyle);
+	}
+
+	// In-flight ground traces belong to the old registration.
+	++GroundTraceGeneration;
+	PendingGroundTraces = 0;
+	SplineSections.Reset();
+
+	// The render component may come back with a fresh buffer: upload everything on the next rebuild.
+	bNodeLinksValid = false;
+	bWiresUploaded = false;
+
 	Super::OnUnregister();
 }
 
@@ -1534,10 +5746,26 @@ void UPowerLineMultiPoleComponent::OnUnregister()
 void UPowerLineMultiPoleComponent::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
 {
 	Super::PostEditChangeProperty(PropertyChangedEvent);
+	SetComponentTickEnabled(bFollowSpline);
+	CachedSplineOwnerComponents = INDEX_NONE;
 	RebuildNow();
 }
 #endif
 
+void UPowerLineMultiPoleComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	if (!bFollowSpline) return;
+
+	// Spline edits (editor drags included) bump the curve version; no spline change event exists.
+	USplineComponent* Spline = ResolveSpline();
+	if (Spline != LayoutSpline.Get() || (Spline && Spline->SplineCurves.Version != LayoutSplineVersion))
+	{
+		RebuildNow();
+	}
+}
+
 void UPowerLineMultiPoleComponent::HandleTransformChanged(
 	USceneComponent*,
 	EUpdateTransformFlags,
@@ -1551,7 +5779,8 @@ void UPowerLineMultiPoleComponent::EnsureRuntimeComponents()
 	AActor* Owner = GetOwner();
 	if (!Owner) return;
 
-	if (!PoleHISM)
+	// Pole HISM is created only once its mesh is streamed in.
+	if (!PoleHISM && PoleMesh.Get())
 	{
 		PoleHISM = NewObject<UHierarchicalInstancedStaticMeshComponent>(Owner);
 		PoleHISM->SetupAttachment(this);
@@ -1569,110 +5798,513 @@ void UPowerLineMultiPoleComponent::EnsureRuntimeComponents()
 	}
 }
 
+UStaticMesh* UPowerLineMultiPoleComponent::ResolvePoleMesh()
+{
+	if (PoleMesh.IsNull()) return nullptr;
+
+	UWorld* W = GetWorld();
+	UPowerLineSubsystem* Sub = W ? W->GetSubsystem<UPowerLineSubsystem>() : nullptr;
+	if (!Sub)
+	{
+		return PoleMesh.LoadSynchronous();
+	}
+
+	// Async: RebuildNow runs again when the load completes.
+	return Sub->RequestMesh(PoleMesh, this);
+}
+
+void UPowerLineMultiPoleComponent::ReleaseHeldMesh()
+{
+	if (HeldMeshPath.IsNull()) return;
+
+	if (UWorld* W = GetWorld())
+	{
+		if (UPowerLineSubsystem* Sub = W->GetSubsystem<UPowerLineSubsystem>())
+		{
+			Sub->ReleaseMeshUser(HeldMeshPath);
+		}
+	}
+	HeldMeshPath.Reset();
+}
+
 FVector UPowerLineMultiPoleComponent::GetWirePointWS(const FPowerLinePoleNode& Node) const
 {
 	const FVector Local = Node.LocalPosition + FVector(0.f, 0.f, WireAttachHeightCm);
 	return GetComponentTransform().TransformPosition(Local);
 }
 
-void UPowerLineMultiPoleComponent::RebuildNow()
+void UPowerLineMultiPoleComponent::GatherNodeLinks()
 {
-	EnsureRuntimeComponents();
-	if (!PoleHISM || !WireRender) return;
-
-	PoleHISM->SetStaticMesh(PoleMesh);
-	PoleHISM->ClearInstances();
-
+	const bool bLoop = (bFollowSpline && LayoutSpline.IsValid()) ? bLayoutClosed : bClosedLoop;
+	const FTransform& ToWorld = GetComponentTransform();
+	uint32 Hash = GetTypeHash(bAutoWireNodes);
+	Hash = HashCombine(Hash, GetTypeHash(AutoWireMaxSpanCm));
+	Hash = HashCombine(Hash, GetTypeHash(AutoWireNearestK));
+	Hash = HashCombine(Hash, GetTypeHash(bLoop));
+	Hash = HashCombine(Hash, GetTypeHash(WireAttachHeightCm));
+	Hash = HashCombine(Hash, GetTypeHash(ToWorld.GetLocation()));
+	Hash = HashCombine(Hash, GetTypeHash(ToWorld.GetRotation().Euler()));
+	Hash = HashCombine(Hash, GetTypeHash(ToWorld.GetScale3D()));
 	for (const FPowerLinePoleNode& Node : Nodes)
 	{
-		FTransform T(FQuat::Identity, Node.LocalPosition, PoleScale);
-		PoleHISM->AddInstance(T);
+		Hash = HashCombine(Hash, GetTypeHash(Node.LocalPosition));
 	}
+	if (bNodeLinksValid && Hash == NodeLinksHash) return;
 
-	TArray<FPowerLineSegment> Segs;
-	const int32 NodeCount = Nodes.Num();
-	if (NodeCount < 2)
+	NodeLinksHash = Hash;
+	bNodeLinksValid = true;
+	NodeLinks.Reset();
+
+	UPowerLineSubsystem* Sub = GetPowerLineSubsystem(this);
+	if (bAutoWireNodes && Sub)
 	{
-		WireRender->UpdateSegments_GameThread(Segs);
+		const EPowerLineAutoWirePolicy Policy = AutoWireNearestK > 0 ? EPowerLineAutoWirePolicy::NearestK : EPowerLineAutoWirePolicy::MinimumSpanningTree;
+		Sub->AutoWireMultiPoleNodes(this, Policy, AutoWireMaxSpanCm, AutoWireNearestK, NodeLinks);
 		return;
 	}
 
-	const int32 EffectiveSegments = FMath::Max(2, NumSegments);
-	const int32 PairCount = bClosedLoop ? NodeCount : (NodeCount - 1);
-	Segs.Reserve(PairCount * EffectiveSegments);
+	const int32 NodeCount = Nodes.Num();
+	if (NodeCount < 2) return;
 
+	const int32 PairCount = bLoop ? NodeCount : (NodeCount - 1);
 	for (int32 PairIdx = 0; PairIdx < PairCount; ++PairIdx)
 	{
-		const int32 NextIdx = (PairIdx + 1) % NodeCount;
-		const FVector StartWS = GetWirePointWS(Nodes[PairIdx]);
-		const FVector EndWS = GetWirePointWS(Nodes[NextIdx]);
+		NodeLinks.Emplace(PairIdx, (PairIdx + 1) % NodeCount);
+	}
+}
 
-		auto PointAt = [&](float T) {
-			const FVector P = FMath::Lerp(StartWS, EndWS, T);
-			const float SagFactor = FMath::Clamp(4.f * T * (1.f - T), 0.f, 1.f);
-			return P - FVector(0, 0, SagAmount * SagFactor);
-			};
+USplineComponent* UPowerLineMultiPoleComponent::ResolveSpline()
+{
+	AActor* Owner = GetOwner();
+	if (!Owner) return nullptr;
 
-		const int32 SampleCount = FMath::Clamp(EffectiveSegments * 8, 32, 512);
-		TArray<FVector> Samples;
-		Samples.Reserve(SampleCount + 1);
+	// Ticked every frame: the component list is only walked again once components were added or removed.
+	const int32 NumComponents = Owner->GetComponents().Num();
+	if (NumComponents == CachedSplineOwnerComponents && !CachedSpline.IsStale())
+	{
+		USplineComponent* Cached = CachedSpline.Get();
+		if (!Cached || (Cached->GetOwner() == Owner && (SplineComponentName == NAME_None || Cached->GetFName() == SplineComponentName)))
+		{
+			return Cached;
+		}
+	}
 
-		TArray<float> CumLen;
-		CumLen.Reserve(SampleCount + 1);
+	CachedSpline.Reset();
+	CachedSplineOwnerComponents = NumComponents;
 
-		float TotalLen = 0.f;
-		FVector Prev = PointAt(0.f);
-		Samples.Add(Prev);
-		CumLen.Add(0.f);
+	TArray<USplineComponent*> Splines;
+	Owner->GetComponents<USplineComponent>(Splines);
 
-		for (int32 i = 1; i <= SampleCount; ++i)
+	for (USplineComponent* Spline : Splines)
+	{
+		if (SplineComponentName == NAME_None || Spline->GetFName() == SplineComponentName)
 		{
-			const float T = (float)i / (float)SampleCount;
-			const FVector Cur = PointAt(T);
-			TotalLen += FVector::Dist(Prev, Cur);
-			Samples.Add(Cur);
-			CumLen.Add(TotalLen);
-			Prev = Cur;
+			CachedSpline = Spline;
+			return Spline;
 		}
+	}
+	return nullptr;
+}
+
+void UPowerLineMultiPoleComponent::RefreshSplineLayout()
+{
+	SplineSections.Reset();
+	RebuildNow();
+}
 
-		if (TotalLen <= KINDA_SMALL_NUMBER)
+void UPowerLineMultiPoleComponent::UpdateSplineLayout(USplineComponent* Spline)
+{
+	POWERLINE_SCOPE(PowerLine_SplineLayout);
+
+	// No spline yet: keep whatever Nodes hold.
+	LayoutSpline = Spline;
+	if (!Spline) return;
+
+	LayoutSplineVersion = Spline->SplineCurves.Version;
+	bLayoutClosed = Spline->IsClosedLoop();
+
+	const int32 NumPoints = Spline->GetNumberOfSplinePoints();
+	const int32 NumCurveSections = NumPoints > 0 ? Spline->GetNumberOfSplineSegments() : 0;
+
+	// Open splines get a trailing one-node section for their last point.
+	const int32 NumSections = NumCurveSections + ((NumPoints > 0 && !bLayoutClosed) ? 1 : 0);
+
+	// Anything that moves every pole (settings, our transform, spline relative to us) is folded into each section hash.
+	const FTransform& ToWorld = GetComponentTransform();
+	uint32 Salt = GetTypeHash(SplineSpacingCm);
+	Salt = HashCombine(Salt, GetTypeHash(bSnapToGround));
+	Salt = HashCombine(Salt, GetTypeHash(GroundTraceUpCm));
+	Salt = HashCombine(Salt, GetTypeHash(GroundTraceDownCm));
+	Salt = HashCombine(Salt, GetTypeHash((uint8)GroundTraceChannel));
+	Salt = HashCombine(Salt, GetTypeHash(ToWorld.GetLocation()));
+	Salt = HashCombine(Salt, GetTypeHash(ToWorld.GetRotation().Euler()));
+	Salt = HashCombine(Salt, GetTypeHash(ToWorld.GetScale3D()));
+
+	const FTransform& SplineToWorld = Spline->GetComponentTransform();
+	Salt = HashCombine(Salt, GetTypeHash(SplineToWorld.GetLocation()));
+	Salt = HashCombine(Salt, GetTypeHash(SplineToWorld.GetRotation().Euler()));
+	Salt = HashCombine(Salt, GetTypeHash(SplineToWorld.GetScale3D()));
+
+	auto HashPoint = [Spline](int32 Point) -> uint32
 		{
-			continue;
+			uint32 H = GetTypeHash(Spline->GetLocationAtSplinePoint(Point, ESplineCoordinateSpace::Local));
+			H = HashCombine(H, GetTypeHash(Spline->GetArriveTangentAtSplinePoint(Point, ESplineCoordinateSpace::Local)));
+			H = HashCombine(H, GetTypeHash(Spline->GetLeaveTangentAtSplinePoint(Point, ESplineCoordinateSpace::Local)));
+			H = HashCombine(H, GetTypeHash((uint8)Spline->GetSplinePointType(Point)));
+			return H;
+		};
+
+	const float SplineLength = Spline->GetSplineLength();
+	const float Spacing = FMath::Max(100.f, SplineSpacingCm);
+
+	TArray<FSplineSection> NewSections;
+	NewSections.SetNum(NumSections);
+
+	TArray<FPowerLinePoleNode> NewNodes;
+	TArray<int32> NewNodeSections;
+	TArray<int32, TInlineAllocator<16>> Retrace;
+
+	// Sections are matched by hash, so inserting or removing a control point only re-places its neighbours.
+	TMap<uint32, int32> OldByHash;
+	OldByHash.Reserve(SplineSections.Num());
+	for (int32 i = 0; i < SplineSections.Num(); ++i)
+	{
+		OldByHash.Add(SplineSections[i].Hash, i);
+	}
+
+	bool bChanged = NumSections != SplineSections.Num();
+	for (int32 Section = 0; Section < NumSections; ++Section)
+	{
+		const bool bTail = Section >= NumCurveSections;
+		const int32 P0 = bTail ? NumPoints - 1 : Section;
+		const int32 P1 = bTail ? P0 : (Section + 1) % NumPoints;
+
+		uint32 Hash = HashCombine(Salt, HashPoint(P0));
+		Hash = HashCombine(Hash, bTail ? 0x7a11u : HashPoint(P1));
+
+		FSplineSection& Out = NewSections[Section];
+		Out.Hash = Hash;
+		Out.FirstNode = NewNodes.Num();
+
+		const int32* OldIdx = OldByHash.Find(Hash);
+		const FSplineSection* Old = OldIdx ? &SplineSections[*OldIdx] : nullptr;
+		if (Old && Nodes.IsValidIndex(Old->FirstNode + Old->NumNodes - 1))
+		{
+			bChanged |= *OldIdx != Section;
+
+			// Unchanged section: keep its (possibly ground-snapped) nodes.
+			Out.NumNodes = Old->NumNodes;
+			NewNodes.Append(&Nodes[Old->FirstNode], Old->NumNodes);
+
+			// Its previous batch is dropped below: trace it again.
+			if (Old->PendingTraces > 0)
+			{
+				Retrace.Add(Section);
+			}
 		}
+		else
+		{
+			bChanged = true;
 
-		auto EvalAtDistance = [&](float TargetLen) {
-			const float ClampedTarget = FMath::Clamp(TargetLen, 0.f, TotalLen);
-			for (int32 Idx = 1; Idx < CumLen.Num(); ++Idx)
+			const float D0 = Spline->GetDistanceAlongSplineAtSplinePoint(P0);
+			const float D1 = bTail ? D0 : (P1 == 0 ? SplineLength : Spline->GetDistanceAlongSplineAtSplinePoint(P1));
+			Out.NumNodes = bTail ? 1 : FMath::Max(1, FMath::RoundToInt((D1 - D0) / Spacing));
+
+			for (int32 i = 0; i < Out.NumNodes; ++i)
 			{
-				if (CumLen[Idx] < ClampedTarget)
-				{
-					continue;
-				}
+				const float D = D0 + (D1 - D0) * ((float)i / (float)Out.NumNodes);
+				FPowerLinePoleNode& Node = NewNodes.AddDefaulted_GetRef();
+				Node.LocalPosition = ToWorld.InverseTransformPosition(
+					Spline->GetLocationAtDistanceAlongSpline(D, ESplineCoordinateSpace::World));
+			}
+			Retrace.Add(Section);
+		}
+
+		for (int32 i = 0; i < Out.NumNodes; ++i)
+		{
+			NewNodeSections.Add(Section);
+		}
+	}
+
+	if (!bChanged) return;
+
+	Nodes = MoveTemp(NewNodes);
+	NodeSections = MoveTemp(NewNodeSections);
+	SplineSections = MoveTemp(NewSections);
+
+	// Node indices moved: drop every in-flight batch and re-trace whatever is not snapped yet.
+	++GroundTraceGeneration;
+	PendingGroundTraces = 0;
+
+	UWorld* World = GetWorld();
+	if (!bSnapToGround || !World) return;
+
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(PowerLineGround), false, GetOwner());
+	const FTraceDelegate Delegate = FTraceDelegate::CreateUObject(
+		this, &UPowerLineMultiPoleComponent::OnGroundTraceDone, GroundTraceGeneration);
+
+	// One batch: the async trace queue runs all of them off the game thread and calls back next frame.
+	const FVector Up = FVector::UpVector;
+	for (const int32 SectionIdx : Retrace)
+	{
+		FSplineSection& Section = SplineSections[SectionIdx];
+		for (int32 i = 0; i < Section.NumNodes; ++i)
+		{
+			const int32 NodeIdx = Section.FirstNode + i;
+			const FVector P = ToWorld.TransformPosition(Nodes[NodeIdx].LocalPosition);
+			World->AsyncLineTraceByChannel(EAsyncTraceType::Single,
+				P + Up * GroundTraceUpCm, P - Up * GroundTraceDownCm,
+				GroundTraceChannel, Params, FCollisionResponseParams::DefaultResponseParam,
+				&Delegate, (uint32)NodeIdx);
+		}
+		Section.PendingTraces = Section.NumNodes;
+		PendingGroundTraces += Section.NumNodes;
+	}
+}
+
+void UPowerLineMultiPoleComponent::OnGroundTraceDone(const FTraceHandle&, FTraceDatum& Datum, uint32 Generation)
+{
+	if (Generation != GroundTraceGeneration) return;
+
+	const int32 NodeIdx = (int32)Datum.UserData;
+	if (!Nodes.IsValidIndex(NodeIdx) || !NodeSections.IsValidIndex(NodeIdx)) return;
+
+	// No ground below: the pole stays on the spline.
+	for (const FHitResult& Hit : Datum.OutHits)
+	{
+		if (Hit.bBlockingHit)
+		{
+			Nodes[NodeIdx].LocalPosition = GetComponentTransform().InverseTransformPosition(Hit.ImpactPoint);
+			break;
+		}
+	}
+
+	FSplineSection& Section = SplineSections[NodeSections[NodeIdx]];
+	Section.PendingTraces = FMath::Max(0, Section.PendingTraces - 1);
+
+	// Whole batch landed: rebuild poles and wires once.
+	if (--PendingGroundTraces <= 0)
+	{
+		PendingGroundTraces = 0;
+		RebuildNow();
+	}
+}
+
+void UPowerLineMultiPoleComponent::RebuildNow()
+{
+	LLM_SCOPE_BYTAG(PowerLine_Segments);
 
-				const float L0 = CumLen[Idx - 1];
-				const float L1 = CumLen[Idx];
-				const float A = (L1 > L0) ? ((ClampedTarget - L0) / (L1 - L0)) : 0.f;
-				return FMath::Lerp(Samples[Idx - 1], Samples[Idx], A);
+	// Nothing to show on a headless server (no HISM, no wire render, no mesh streaming).
+	if (UPowerLineSubsystem* Sub = GetPowerLineSubsystem(this))
+	{
+		if (Sub->IsHeadless()) return;
+	}
+
+	if (bFollowSpline)
+	{
+		UpdateSplineLayout(ResolveSpline());
+	}
+
+	UStaticMesh* Mesh = ResolvePoleMesh();
+
+	EnsureRuntimeComponents();
+	if (!WireRender) return;
+
+	// Track which streamed mesh this group keeps alive.
+	const FSoftObjectPath MeshPath = Mesh ? FSoftObjectPath(Mesh) : FSoftObjectPath();
+	if (MeshPath != HeldMeshPath)
+	{
+		ReleaseHeldMesh();
+		if (Mesh)
+		{
+			if (UPowerLineSubsystem* Sub = GetWorld() ? GetWorld()->GetSubsystem<UPowerLineSubsystem>() : nullptr)
+			{
+				Sub->AddMeshUser(Mesh);
+				HeldMeshPath = MeshPath;
 			}
+		}
+	}
+
+	if (PoleHISM)
+	{
+		UpdatePoleInstances(Mesh);
+	}
+
+	UpdateWires();
+}
+
+void UPowerLineMultiPoleComponent::UpdatePoleInstances(UStaticMesh* Mesh)
+{
+	PoleHISM->SetStaticMesh(Mesh);
+
+	// Scale changes touch every instance; a count mismatch means the HISM was changed behind our back.
+	if (!Mesh || PoleScale != InstanceScale || PoleHISM->GetInstanceCount() != InstancePositions.Num())
+	{
+		PoleHISM->ClearInstances();
+		InstancePositions.Reset();
+		InstanceScale = PoleScale;
+	}
+	if (!Mesh) return;
+
+	// Instances are interchangeable: poles still standing keep theirs, new positions reuse the freed ones.
+	TMultiMap<FVector, int32> Unmatched;
+	Unmatched.Reserve(InstancePositions.Num());
+	for (int32 i = 0; i < InstancePositions.Num(); ++i)
+	{
+		Unmatched.Add(InstancePositions[i], i);
+	}
+
+	TArray<FVector> Added;
+	for (const FPowerLinePoleNode& Node : Nodes)
+	{
+		if (const int32* Found = Unmatched.Find(Node.LocalPosition))
+		{
+			const int32 Instance = *Found;
+			Unmatched.Remove(Node.LocalPosition, Instance);
+		}
+		else
+		{
+			Added.Add(Node.LocalPosition);
+		}
+	}
+	if (Added.Num() == 0 && Unmatched.Num() == 0) return;
+
+	TArray<int32> Freed;
+	Unmatched.GenerateValueArray(Freed);
+	Freed.Sort();
+
+	auto MoveInstance = [this](int32 Instance, const FVector& Position)
+		{
+			PoleHISM->UpdateInstanceTransform(Instance, FTransform(FQuat::Identity, Position, PoleScale), false, false, true);
+			InstancePositions[Instance] = Position;
+		};
+
+	const int32 Reused = FMath::Min(Added.Num(), Freed.Num());
+	for (int32 i = 0; i < Reused; ++i)
+	{
+		MoveInstance(Freed[i], Added[i]);
+	}
+
+	if (Added.Num() > Reused)
+	{
+		TArray<FTransform> Transforms;
+		Transforms.Reserve(Added.Num() - Reused);
+		for (int32 i = Reused; i < Added.Num(); ++i)
+		{
+			Transforms.Emplace(FQuat::Identity, Added[i], PoleScale);
+			InstancePositions.Add(Added[i]);
+		}
+		PoleHISM->AddInstances(Transforms, false);
+	}
+	else if (Freed.Num() > Reused)
+	{
+		// Surplus instances: tail instances move into the freed slots below the new count, then the tail is
+		// removed, so indices stay valid whether the HISM shifts or swaps on removal.
+		const int32 NewCount = InstancePositions.Num() - (Freed.Num() - Reused);
+		TBitArray<> IsFree(false, InstancePositions.Num());
+		for (int32 i = Reused; i < Freed.Num(); ++i)
+		{
+			IsFree[Freed[i]] = true;
+		}
+
+		int32 Tail = NewCount;
+		for (int32 i = Reused; i < Freed.Num() && Freed[i] < NewCount; ++i)
+		{
+			while (IsFree[Tail]) ++Tail;
+			MoveInstance(Freed[i], InstancePositions[Tail]);
+			++Tail;
+		}
+
+		TArray<int32> Remove;
+		for (int32 i = InstancePositions.Num() - 1; i >= NewCount; --i)
+		{
+			Remove.Add(i);
+		}
+		PoleHISM->RemoveInstances(Remove);
+		InstancePositions.SetNum(NewCount);
+	}
+
+	PoleHISM->MarkRenderStateDirty();
+}
+
+void UPowerLineMultiPoleComponent::UpdateWires()
+{
+	GatherNodeLinks();
+
+	const int32 EffectiveSegments = FMath::Max(2, NumSegments);
+	UPowerLineSubsystem* Sub = GetPowerLineSubsystem(this);
+	const int32 Style = Sub ? Sub->AcquireSharedStyle(LineColor, LineThickness, HeldSharedStyle) : 0;
+
+	// Anything that changes every wire drops the cache.
+	uint32 Settings = GetTypeHash(EffectiveSegments);
+	Settings = HashCombine(Settings, GetTypeHash(SagAmount));
+	Settings = HashCombine(Settings, GetTypeHash(Style));
+	if (Settings != BuiltWireSettings)
+	{
+		BuiltWires.Reset();
+		BuiltSegments.Reset();
+		BuiltWireSettings = Settings;
+	}
+
+	// Wires are matched by their end points: a spline drag re-sags only the spans next to moved poles.
+	TMap<TPair<FVector, FVector>, int32> OldByEnds;
+	OldByEnds.Reserve(BuiltWires.Num());
+	for (int32 i = 0; i < BuiltWires.Num(); ++i)
+	{
+		OldByEnds.Add(MakeTuple(BuiltWires[i].Start, BuiltWires[i].End), i);
+	}
+
+	bool bChanged = !bWiresUploaded || NodeLinks.Num() != BuiltWires.Num();
+	TArray<FBuiltWire> NewWires;
+	TArray<FPowerLineSegment> NewSegs;
+	NewWires.Reserve(NodeLinks.Num());
+	NewSegs.Reserve(NodeLinks.Num() * EffectiveSegments);
+
+	TArray<FVector> Points;
+	for (int32 PairIdx = 0; PairIdx < NodeLinks.Num(); ++PairIdx)
+	{
+		FBuiltWire& Wire = NewWires.AddDefaulted_GetRef();
+		Wire.Start = GetWirePointWS(Nodes[NodeLinks[PairIdx].X]);
+		Wire.End = GetWirePointWS(Nodes[NodeLinks[PairIdx].Y]);
+		Wire.FirstSegment = NewSegs.Num();
 
-			return Samples.Last();
-			};
+		if (const int32* Old = OldByEnds.Find(MakeTuple(Wire.Start, Wire.End)))
+		{
+			const FBuiltWire& OldWire = BuiltWires[*Old];
+			NewSegs.Append(BuiltSegments.GetData() + OldWire.FirstSegment, OldWire.NumSegments);
+			Wire.NumSegments = OldWire.NumSegments;
+			bChanged |= *Old != PairIdx;
+			continue;
+		}
 
-		for (int32 i = 0; i < EffectiveSegments; ++i)
+		bChanged = true;
+		if (!PowerLineCore::BuildSaggedCurve(Wire.Start, Wire.End, SagAmount, EffectiveSegments, Points))
 		{
-			const float L0 = (TotalLen * (float)i) / (float)EffectiveSegments;
-			const float L1 = (TotalLen * (float)(i + 1)) / (float)EffectiveSegments;
+			continue;
+		}
+
+		// Phase from the end points only, so a wire keeps its sway when node indices shift.
+		const uint32 LineHash = PowerLineCore::HashLine(Wire.Start, Wire.End, 0);
+		const float InvSegs = 1.f / (float)(Points.Num() - 1);
 
+		for (int32 i = 0; i + 1 < Points.Num(); ++i)
+		{
 			FPowerLineSegment S;
-			S.Start = EvalAtDistance(L0);
-			S.End = EvalAtDistance(L1);
-			S.Color = LineColor;
-			S.Thickness = LineThickness;
+			S.Start = Points[i];
+			S.End = Points[i + 1];
+			S.Style = Style;
 			S.DepthBias = 0.f;
 			S.bScreenSpace = true;
-			Segs.Add(S);
+			S.Wind = PowerLineCore::PackWindAttributes(i * InvSegs, (i + 1) * InvSegs, LineHash, FMath::Abs(SagAmount));
+			NewSegs.Add(S);
 		}
+		Wire.NumSegments = NewSegs.Num() - Wire.FirstSegment;
 	}
 
-	WireRender->UpdateSegments_GameThread(Segs);
+	BuiltWires = MoveTemp(NewWires);
+	BuiltSegments = MoveTemp(NewSegs);
+	if (!bChanged) return;
+
+	WireRender->UpdateSegments_GameThread(BuiltSegments);
+	bWiresUploaded = true;
 }
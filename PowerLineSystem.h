@@ -11,7 +11,13 @@
 #include "Components/SphereComponent.h"
 #include "Components/BoxComponent.h"
 #include "Subsystems/WorldSubsystem.h"
+#include "GameFramework/Info.h"
+#include "Net/Serialization/FastArraySerializer.h"
+#include "UObject/ObjectKey.h"
+#include "Engine/StreamableManager.h"
+#include "Stats/Stats.h"
 #include "Tickable.h"
+#include "PowerLineCore.h"
 #include "PowerLineSystem.generated.h"
 
 // ============================
@@ -76,8 +82,9 @@ struct FPowerLineHangingSettings
 	GENERATED_BODY()
 
 	// Pool of meshes that can appear on a wire (ex: shoes). If empty -> feature disabled.
+	// Soft references: the subsystem streams a mesh in only when a wire that uses it is built.
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PowerLine|Hanging")
-	TArray<TObjectPtr<UStaticMesh>> MeshPool;
+	TArray<TSoftObjectPtr<UStaticMesh>> MeshPool;
 
 	// Chance to spawn ONE mesh on a wire. Typical values: 0.01 .. 0.10
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PowerLine|Hanging", meta = (ClampMin = "0", ClampMax = "1"))
@@ -147,6 +154,11 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PowerLine")
 	FPowerLineHangingSettings Hanging;
 
+	// Multiplier on the subsystem wind for wires of this district (0 = sheltered). Applied at draw time, so runtime
+	// changes show up on the next frame without rebuilding any wire.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PowerLine|Wind", meta = (ClampMin = "0"))
+	float WindScale = 1.f;
+
 	// Get sag (cm, positive value -> downward sag).
 	// LineId can be used to diversify multiple wires between same points.
 	UFUNCTION(BlueprintCallable, Category = "PowerLine")
@@ -157,7 +169,7 @@ public:
 	int32 GetSegmentsForLength(float LengthCm) const;
 
 	// Decide if a wire should have a hanging mesh and produce deterministic placement.
-	// Returns false if disabled or chance failed.
+	// Returns false if disabled or chance failed. Loads the picked mesh synchronously if needed.
 	UFUNCTION(BlueprintCallable, Category = "PowerLine")
 	bool GetHangingForLine(
 		const FVector& StartWS,
@@ -167,18 +179,35 @@ public:
 		float& OutNormalizedDistance,
 		float& OutYawDeg) const;
 
+	// Same as GetHangingForLine, but returns the soft mesh reference (no loading).
+	bool GetHangingAssetForLine(
+		const FVector& StartWS,
+		const FVector& EndWS,
+		int32 LineId,
+		TSoftObjectPtr<UStaticMesh>& OutMesh,
+		float& OutNormalizedDistance,
+		float& OutYawDeg) const;
+
 	// Mark all wires that reference this manager dirty (useful after changing settings at runtime).
 	UFUNCTION(BlueprintCallable, Category = "PowerLine")
 	void MarkAllDistrictWiresDirty();
 
+	// Animated sag (ice load, heat): built wires are rescaled in place instead of rebuilt.
+	UFUNCTION(BlueprintCallable, Category = "PowerLine|Sag")
+	void SetSagScale(float NewScale);
+
 	UFUNCTION(BlueprintCallable, Category = "PowerLine|Area")
 	bool AffectsWorldLocation(const FVector& LocationWS) const;
 
+	// Plain-data copy of the sag/segment policy (see PowerLineCore.h).
+	PowerLineCore::FDistrictParams GetCoreParams() const;
+
 protected:
 	static uint32 HashLine(const FVector& A, const FVector& B, int32 LineId);
 
 #if WITH_EDITOR
 	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+	virtual void PostEditUndo() override;
 #endif
 
 private:
@@ -216,6 +245,7 @@ public:
 protected:
 #if WITH_EDITOR
 	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+	virtual void PostEditUndo() override;
 #endif
 
 private:
@@ -231,24 +261,148 @@ struct FPowerLineSegment
 {
 	FVector Start;
 	FVector End;
-	FColor Color = FColor::White;
-	float Thickness = 1.f;
+	int32 Style = 0; // Palette index (color/thickness are looked up at draw time)
 	float DepthBias = 0.f;
 	bool bScreenSpace = true;
+
+	// Along-span parameter, phase and amplitude for the draw-time wind sway.
+	PowerLineCore::FWindAttributes Wind;
+	uint16 WindGroup = 0; // District wind scale slot (FPowerLineStylePalette::WindScales), 0 = no district
+};
+
+// ============================
+// Wire styles
+// Color/thickness live in a per-world palette read by the proxies at draw time; segments only keep the index.
+// ============================
+
+struct FPowerLineStyle
+{
+	FColor Color = FColor::Black;
+	float Thickness = 2.f;
+};
+
+// Render-thread copy of a subsystem's palette, shared by all of its render components.
+// Only written by render commands, so the proxies read it without locks.
+struct FPowerLineStylePalette
+{
+	TArray<FPowerLineStyle> Styles;
+	TArray<float> WindScales; // District wind multipliers by wind group (UPowerLineSubsystem::ResolveWindGroup)
+
+	const FPowerLineStyle& Get(int32 Index) const
+	{
+		static const FPowerLineStyle Fallback;
+		return Styles.IsValidIndex(Index) ? Styles[Index] : Fallback;
+	}
+
+	float GetWindScale(int32 Group) const
+	{
+		return WindScales.IsValidIndex(Group) ? WindScales[Group] : 1.f;
+	}
+};
+
+typedef TSharedPtr<FPowerLineStylePalette, ESPMode::ThreadSafe> FPowerLineStylePalettePtr;
+
+// ============================
+// Wire build inputs
+// ============================
+
+// Conductors of a bundled span: world offsets at both ends and wind phase hash, one entry per conductor.
+struct FPowerLineBundle
+{
+	TArray<FVector, TInlineAllocator<4>> StartOffsets;
+	TArray<FVector, TInlineAllocator<4>> EndOffsets;
+	TArray<uint32, TInlineAllocator<4>> LineHashes;
+};
+
+typedef TSharedPtr<const FPowerLineBundle, ESPMode::ThreadSafe> FPowerLineBundlePtr;
+
+// Wire inputs resolved on the game thread (endpoints, district policy); curves are then built on any thread.
+struct FPowerLineWireBuild
+{
+	FVector Start = FVector::ZeroVector;
+	FVector End = FVector::ZeroVector;
+	float Sag = 0.f;
+	int32 Segments = 2;
+	int32 Style = 0; // Palette index (UPowerLineSubsystem::ResolveWireStyle)
+
+	// Wind: phase source and district scale slot (amplitude = |Sag|, the district scale is applied at draw time).
+	uint32 LineHash = 0;
+	uint16 WindGroup = 0;
+
+	// District the sag came from (in-place sag rescale).
+	TWeakObjectPtr<APowerLineDistrictDataManager> District;
+
+	// District sag randomized per wire (hashed from the absolute endpoints): the curve is practically never shared,
+	// so the shape cache is skipped instead of filling it with single-use entries.
+	bool bUniqueSag = false;
+
+	// Shared curve (shape cache path); null -> curve is built from Start/End.
+	PowerLineCore::FShapePtr Shape;
+
+	// Conductor bundle around the Start/End centre line (null = single wire). Bundles bypass the shape cache.
+	FPowerLineBundlePtr Bundle;
+
+	// Cut position along the wire (UPowerLineSubsystem::BreakWire), < 0 = intact. Broken wires bypass the shape cache.
+	float BreakT = -1.f;
+	// Ground height under the start/end anchors while broken (-MAX_flt = none found).
+	float BreakGroundZ[2] = { -MAX_flt, -MAX_flt };
+
+	// Emit line segments for this wire (Scratch is reused between calls).
+	void Emit(TArray<FVector>& Scratch, TArray<FPowerLineSegment>& Out) const;
+
+	// Shape path: per-point correction from the shape's quantized end to the exact End (point i moves by Skew * i).
+	FVector GetShapeSkew() const;
+
+	// Every drawn polyline (one per conductor, two per conductor when broken) with its wind hash and span range.
+	// Always built from Start/End (ignores Shape). Same segment count broken or intact.
+	void ForEachPolyline(TArray<FVector>& Scratch, TFunctionRef<void(TArrayView<const FVector> Points, uint32 Hash, float SpanT0, float SpanT1)> Fn) const;
+};
+
+// ============================
+// Shape cache feed (PowerLineCore::FShapeCache holds the shapes)
+// ============================
+
+class UPowerLineComponent;
+
+// One static wire as shared shape + translation (UPowerLineSubsystem::GetShapeInstances), the input of a
+// shared-geometry instanced draw path. Point i of the wire = Offset + Shape->Points[i] + Skew * i.
+struct FPowerLineShapeInstance
+{
+	PowerLineCore::FShapePtr Shape;
+	FVector Offset = FVector::ZeroVector; // Wire start
+	FVector Skew = FVector::ZeroVector;   // FPowerLineWireBuild::GetShapeSkew
+	int32 Style = 0;
+	TWeakObjectPtr<UPowerLineComponent> Wire;
 };
 
 struct FPowerLineChunkKey
 {
 	FIntPoint Coord;
 
-	bool operator==(const FPowerLineChunkKey& O) const { return Coord == O.Coord; }
+	// Adaptive chunking: cell size is ChunkSize / 2^Level; Z is used only for vertical splits (0 otherwise).
+	int32 Z = 0;
+	uint8 Level = 0;
+
+	bool operator==(const FPowerLineChunkKey& O) const { return Coord == O.Coord && Z == O.Z && Level == O.Level; }
 
-	friend uint32 GetTypeHash(const FPowerLineChunkKey& K) { return GetTypeHash(K.Coord); }
+	friend uint32 GetTypeHash(const FPowerLineChunkKey& K)
+	{
+		uint32 H = GetTypeHash(K.Coord);
+		if (K.Level > 0)
+		{
+			H = HashCombine(H, GetTypeHash(K.Z));
+			H = HashCombine(H, GetTypeHash(K.Level));
+		}
+		return H;
+	}
 };
 
 class UPowerLineSubsystem;
 class APowerLine_Pole;
 class UArrowComponent;
+class USplineComponent;
+struct FTraceHandle;
+struct FTraceDatum;
 
 USTRUCT(BlueprintType)
 struct FPowerLinePoleNode
@@ -260,6 +414,21 @@ struct FPowerLinePoleNode
 	FVector LocalPosition = FVector::ZeroVector;
 };
 
+// One conductor of a UPowerLineComponent bundle.
+USTRUCT(BlueprintType)
+struct FPowerLineConductor
+{
+	GENERATED_BODY()
+
+	// Crossarm offset in the wire component's space (applied in the target attach point's space at the far end).
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PowerLine")
+	FVector Offset = FVector::ZeroVector;
+
+	// Diversifies the wind phase of this conductor.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PowerLine")
+	int32 LineId = 0;
+};
+
 // ============================
 // Render Component (one per chunk)
 // ============================
@@ -281,7 +450,16 @@ public:
 	// Called from Subsystem on GT
 	void UpdateSegments_GameThread(const TArray<FPowerLineSegment>& Segs);
 
+	// Wind the proxy applies at draw time (taken from the subsystem on register, pushed when it changes).
+	PowerLineCore::FWindParams Wind;
+	float MaxWindScale = 1.f; // Largest district wind scale (bounds only)
+	void SetWind_GameThread(const PowerLineCore::FWindParams& InWind, float InMaxWindScale);
+
+	// Subsystem style palette (taken on register, handed to the proxy; null draws the fallback style).
+	FPowerLineStylePalettePtr Palette;
+
 	// UPrimitiveComponent
+	virtual void OnRegister() override;
 	virtual FPrimitiveSceneProxy* CreateSceneProxy() override;
 	virtual FBoxSphereBounds CalcBounds(const FTransform& LocalToWorld) const override;
 	virtual void SendRenderDynamicData_Concurrent() override;
@@ -308,6 +486,55 @@ enum class EPowerLineAttachLookup : uint8
 	ByComponentName UMETA(DisplayName = "By Component Name"),
 };
 
+// ============================
+// Wire mobility (static chunks vs per-frame dynamic buffer)
+// ============================
+
+UENUM(BlueprintType)
+enum class EPowerLineWireMobility : uint8
+{
+	// Static while endpoints are still; moved to the dynamic buffer when motion is observed, back when settled.
+	Auto UMETA(DisplayName = "Auto (observed motion)"),
+
+	// Always batched in static chunks.
+	Static UMETA(DisplayName = "Static"),
+
+	// Always in the per-frame dynamic buffer (cranes, trams, vehicles).
+	Dynamic UMETA(DisplayName = "Dynamic"),
+};
+
+// ============================
+// Headless (dedicated server) mode
+// ============================
+
+UENUM(BlueprintType)
+enum class EPowerLineHeadlessMode : uint8
+{
+	// Headless on dedicated servers and when the process can never render (-nullrhi commandlets, etc.).
+	Auto UMETA(DisplayName = "Auto (server / no rendering)"),
+
+	Always UMETA(DisplayName = "Always headless"),
+
+	// Always build render data (profiling render-side costs in commandlets).
+	Never UMETA(DisplayName = "Never headless"),
+};
+
+// ============================
+// Dirty cause (rebuild watchdog, powerline.DumpWatchdog)
+// ============================
+
+UENUM(BlueprintType)
+enum class EPowerLineDirtyCause : uint8
+{
+	Unknown,
+	Register,
+	OwnTransform UMETA(DisplayName = "Own Transform"),
+	TargetTransform UMETA(DisplayName = "Target Transform"),
+	District UMETA(DisplayName = "District Edit"),
+	Property UMETA(DisplayName = "Property Change"),
+	ChunkNeighbour UMETA(DisplayName = "Chunk Neighbour"), // Rebuilt only because another wire dirtied its chunk
+};
+
 // ============================
 // PowerLine Component (this IS the attach point)
 // Add several of these to a pole/building in Editor.
@@ -380,10 +607,22 @@ public:
 	UPROPERTY(EditAnywhere, Category = "PowerLine|Render")
 	FColor LineColor = FColor::Black;
 
+	// Conductor bundle: one wire per entry (e.g. three phases + neutral) between the same two attach points.
+	// Endpoints, district, sag and delegates are resolved once for the whole bundle. Empty = single wire.
+	UPROPERTY(EditAnywhere, Category = "PowerLine|Bundle")
+	TArray<FPowerLineConductor> Conductors;
+
+	// Static wires share chunk batches; dynamic wires are rebuilt every frame in a small separate buffer.
+	UPROPERTY(EditAnywhere, Category = "PowerLine|Mobility")
+	EPowerLineWireMobility WireMobility = EPowerLineWireMobility::Auto;
+
 	// Call if you change params from code
 	UFUNCTION(BlueprintCallable, Category = "PowerLine")
 	void MarkDirty();
 
+	// Same as MarkDirty, with the reason recorded for the watchdog.
+	void MarkDirtyWithCause(EPowerLineDirtyCause Cause);
+
 	// Returns effective key for this attach point
 	UFUNCTION(BlueprintCallable, Category = "PowerLine|Attach")
 	FName GetAttachKey() const;
@@ -395,15 +634,69 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "PowerLine")
 	void RefreshTargetBinding();
 
-	// Internal use
-	void BuildSegments(TArray<FPowerLineSegment>& Out) const;
+	// Game-thread half of a build: endpoint + district policy. False if not connected. Pure read: the style slot
+	// and wind group are taken by UPowerLineSubsystem::ResolveBuildResources.
+	bool ResolveBuildInputs(FPowerLineWireBuild& Out) const;
 
 	// Current chunk tracking (so moving actor moves between chunks w/o Tick)
 	bool bRegistered = false;
 	FPowerLineChunkKey CurrentKey;
 	bool bHasKey = false;
 
+	// Index inside FPowerLineChunk::Lines (O(1) swap removal).
+	int32 ChunkIndex = INDEX_NONE;
+
+	// Segments emitted by the last build (memory report / budgeting) and where they start in the chunk batch.
+	int32 LastSegmentCount = 0;
+	int32 SegmentFirst = INDEX_NONE;
+
+	// Runtime style (UPowerLineSubsystem::SetWireStyle); INDEX_NONE = shared style of LineColor/LineThickness.
+	// Survives re-registration; the slot only counts the wire as a user while it is registered.
+	int32 StyleOverride = INDEX_NONE;
+	uint32 StyleOverrideSerial = 0; // Slot serial at SetWireStyle (detects a slot freed and reused meanwhile)
+
+	// Shared style slot this wire counts as a user of (UPowerLineSubsystem::ResolveWireStyle).
+	int32 HeldSharedStyle = INDEX_NONE;
+
+	// Edge in the subsystem connectivity graph (owner -> effective target), INDEX_NONE when not connected.
+	int32 GridEdge = INDEX_NONE;
+
+	// Runtime cut (UPowerLineSubsystem::BreakWire): position along the wire, < 0 = intact. Survives re-registration.
+	float BreakT = -1.f;
+	// Ground under the start/end anchors, traced when the wire breaks (the pieces lie on it).
+	float BreakGroundZ[2] = { -MAX_flt, -MAX_flt };
+	bool IsBroken() const { return BreakT >= 0.f; }
+
+	// Why the wire was last marked dirty (watchdog attribution).
+	EPowerLineDirtyCause LastDirtyCause = EPowerLineDirtyCause::Unknown;
+
+	// Span from the last build (endpoints, sag, segment count). This is all a headless server keeps per wire.
+	FPowerLineWireBuild ResolvedSpan;
+	bool bHasResolvedSpan = false;
+
+	// Last resolved span; works on dedicated servers (no segment data needed).
+	UFUNCTION(BlueprintCallable, Category = "PowerLine")
+	bool GetResolvedSpan(FVector& OutStart, FVector& OutEnd, float& OutSag) const;
+
+	// Dynamic buffer tracking (subsystem owned).
+	bool bDynamic = false;
+	int32 DynamicIndex = INDEX_NONE;
+
+	// Index inside the subsystem's simulated cables (INDEX_NONE = static curve).
+	int32 SimIndex = INDEX_NONE;
+
+	// Observed motion (for Auto mobility).
+	int32 RecentMoveCount = 0;
+	double LastMoveTime = 0.0;
+	uint64 LastMoveFrame = 0;
+
+	// True if owner or target can move at runtime (root mobility Movable).
+	bool CanEverMove() const;
+
 private:
+	// District resolved once when the wire becomes dynamic (per-frame path skips actor iteration).
+	mutable TWeakObjectPtr<APowerLineDistrictDataManager> DynamicDistrictCache;
+
 	// Own transform changes
 	FDelegateHandle TransformChangedHandle;
 	void HandleTransformChanged(USceneComponent* InComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
@@ -419,13 +712,16 @@ public:
 	// Resolve effective district manager (manual or auto-found)
 	APowerLineDistrictDataManager* ResolveDistrictManager() const;
 
+	// Drop cached district of a dynamic wire (re-resolved on next use).
+	void ResetDynamicDistrictCache() { DynamicDistrictCache = nullptr; }
+
 	// Get current endpoint (resolved target attach point or manual end).
 	// Returns true if connected to TargetActor.
 	UFUNCTION(BlueprintCallable, Category = "PowerLine")
 	bool GetResolvedEndPointWS(FVector& OutEnd) const;
 
-	// Resolve endpoint
-	bool ResolveEndPoint(FVector& OutEnd) const;
+	// Resolve endpoint (and the frame bundle offsets are applied in at the far end).
+	bool ResolveEndPoint(FVector& OutEnd, FQuat* OutEndRotation = nullptr) const;
 
 protected:
 	virtual void OnRegister() override;
@@ -433,6 +729,7 @@ protected:
 
 #if WITH_EDITOR
 	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+	virtual void PostEditUndo() override;
 #endif
 };
 
@@ -450,8 +747,9 @@ public:
 	UPowerLinePoleComponent();
 
 	// Mesh to instance. If null, component will try to find a UStaticMeshComponent on the same actor and use its mesh.
+	// Streamed asynchronously by the subsystem; the instance appears once the mesh is loaded.
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PowerLine|Pole")
-	TObjectPtr<UStaticMesh> PoleMesh = nullptr;
+	TSoftObjectPtr<UStaticMesh> PoleMesh;
 
 	// If PoleMesh is null and a UStaticMeshComponent is found on the same actor, hide it to avoid double-render.
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PowerLine|Pole")
@@ -512,9 +810,9 @@ class PROGRAMM_API UPowerLineMultiPoleComponent : public USceneComponent
 public:
 	UPowerLineMultiPoleComponent();
 
-	// Mesh for all poles in this group.
+	// Mesh for all poles in this group (streamed asynchronously, poles appear once loaded).
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PowerLine|Pole")
-	TObjectPtr<UStaticMesh> PoleMesh = nullptr;
+	TSoftObjectPtr<UStaticMesh> PoleMesh;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PowerLine|Pole")
 	FVector PoleScale = FVector(1.f, 1.f, 1.f);
@@ -542,9 +840,55 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PowerLine|Wire")
 	FColor LineColor = FColor::Black;
 
+	// Wires follow procedural wiring of the nodes (spline-generated ones included) instead of node order:
+	// a spanning tree, or each node to its K nearest when AutoWireNearestK > 0. bClosedLoop is ignored.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PowerLine|AutoWire")
+	bool bAutoWireNodes = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PowerLine|AutoWire", meta = (EditCondition = "bAutoWireNodes", ClampMin = "100"))
+	float AutoWireMaxSpanCm = 5000.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PowerLine|AutoWire", meta = (EditCondition = "bAutoWireNodes", ClampMin = "0"))
+	int32 AutoWireNearestK = 0;
+
+	// Spline layout: Nodes are generated along a spline of the owner instead of being hand-edited.
+	// Every spline section (between two control points) gets its own evenly spaced poles, so editing one
+	// section re-places and re-traces only that section. Closed splines close the loop (bClosedLoop is ignored).
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PowerLine|Spline")
+	bool bFollowSpline = false;
+
+	// Spline component on the owner (by name). None = first spline component found.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PowerLine|Spline", meta = (EditCondition = "bFollowSpline"))
+	FName SplineComponentName = NAME_None;
+
+	// Target distance between poles along the spline.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PowerLine|Spline", meta = (EditCondition = "bFollowSpline", ClampMin = "100"))
+	float SplineSpacingCm = 3000.f;
+
+	// Snap generated poles to the ground with async line traces (one batch per layout change).
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PowerLine|Spline", meta = (EditCondition = "bFollowSpline"))
+	bool bSnapToGround = true;
+
+	// Ground trace runs from this far above the spline point...
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PowerLine|Spline", meta = (EditCondition = "bFollowSpline && bSnapToGround", ClampMin = "0"))
+	float GroundTraceUpCm = 10000.f;
+
+	// ...to this far below it.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PowerLine|Spline", meta = (EditCondition = "bFollowSpline && bSnapToGround", ClampMin = "0"))
+	float GroundTraceDownCm = 50000.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PowerLine|Spline", meta = (EditCondition = "bFollowSpline && bSnapToGround"))
+	TEnumAsByte<ECollisionChannel> GroundTraceChannel = ECC_WorldStatic;
+
 	UFUNCTION(BlueprintCallable, Category = "PowerLine")
 	void RebuildNow();
 
+	// Re-places and re-traces every spline section (e.g. after the landscape under the line changed).
+	UFUNCTION(BlueprintCallable, Category = "PowerLine")
+	void RefreshSplineLayout();
+
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
 protected:
 	virtual void OnRegister() override;
 	virtual void OnUnregister() override;
@@ -560,11 +904,74 @@ private:
 	UPROPERTY(Transient)
 	TObjectPtr<UPowerLineRenderComponent> WireRender = nullptr;
 
+	// Mesh currently counted as used in the subsystem streaming bookkeeping.
+	FSoftObjectPath HeldMeshPath;
+
+	// Shared wire style slot held by this component (UPowerLineSubsystem::AcquireSharedStyle).
+	int32 HeldSharedStyle = INDEX_NONE;
+
 	FDelegateHandle TransformChangedHandle;
 	void HandleTransformChanged(USceneComponent* InComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
 
 	void EnsureRuntimeComponents();
+	UStaticMesh* ResolvePoleMesh();
+	void ReleaseHeldMesh();
 	FVector GetWirePointWS(const FPowerLinePoleNode& Node) const;
+
+	// Node pairs wired by the last rebuild (node order, or auto-wiring with bAutoWireNodes), kept while the
+	// wire points and wiring settings hash the same.
+	TArray<FIntPoint> NodeLinks;
+	uint32 NodeLinksHash = 0;
+	bool bNodeLinksValid = false;
+	void GatherNodeLinks();
+
+	// Incremental rebuild: pole instance positions in HISM order, and the wires built last time.
+	// Rebuilds only touch instances of poles that appeared or moved, and only re-sag wires whose ends changed.
+	struct FBuiltWire
+	{
+		FVector Start = FVector::ZeroVector;
+		FVector End = FVector::ZeroVector;
+		int32 FirstSegment = 0;
+		int32 NumSegments = 0;
+	};
+	TArray<FVector> InstancePositions;
+	FVector InstanceScale = FVector::ZeroVector;
+	TArray<FBuiltWire> BuiltWires;
+	TArray<FPowerLineSegment> BuiltSegments;
+	uint32 BuiltWireSettings = 0;
+	bool bWiresUploaded = false;
+
+	void UpdatePoleInstances(UStaticMesh* Mesh);
+	void UpdateWires();
+
+	// Spline layout cache: one entry per section (+ the end point of an open spline).
+	struct FSplineSection
+	{
+		uint32 Hash = 0;
+		int32 FirstNode = 0;
+		int32 NumNodes = 0;
+		int32 PendingTraces = 0;
+	};
+	TArray<FSplineSection> SplineSections;
+	TArray<int32> NodeSections;
+
+	TWeakObjectPtr<USplineComponent> LayoutSpline;
+	uint32 LayoutSplineVersion = 0;
+	bool bLayoutClosed = false;
+
+	// Bumped whenever a layout pass re-issues traces; results of older batches are dropped.
+	uint32 GroundTraceGeneration = 0;
+	int32 PendingGroundTraces = 0;
+
+	// Spline lookup cache, dropped when the owner's component count changes or the cached spline goes away.
+	TWeakObjectPtr<USplineComponent> CachedSpline;
+	int32 CachedSplineOwnerComponents = INDEX_NONE;
+
+	USplineComponent* ResolveSpline();
+	void UpdateSplineLayout(USplineComponent* Spline);
+	void OnGroundTraceDone(const FTraceHandle& Handle, FTraceDatum& Datum, uint32 Generation);
+
+	friend class UPowerLineSubsystem;
 };
 
 // ============================
@@ -576,12 +983,320 @@ struct FPowerLineChunk
 	TArray<TWeakObjectPtr<UPowerLineComponent>> Lines;
 	TArray<FPowerLineSegment> BatchedSegments;
 	bool bDirty = true;
+
+	// Time the chunk was last rebuilt with no lines (0 = not empty). Reclaimed after a grace period.
+	double EmptySince = 0.0;
+
+	// Rebuild count decayed over time (debug heatmap), valid at HeatTime.
+	float RebuildHeat = 0.f;
+	double HeatTime = 0.0;
+};
+
+// ============================
+// Wire queries
+// ============================
+
+// Result of the wire queries (casts, nearest, radius).
+USTRUCT(BlueprintType)
+struct FPowerLineWireHit
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "PowerLine|Query")
+	TWeakObjectPtr<UPowerLineComponent> Wire;
+
+	UPROPERTY(BlueprintReadOnly, Category = "PowerLine|Query")
+	int32 LineId = 0;
+
+	// From the query start (casts) or the query point (nearest/radius), cm.
+	UPROPERTY(BlueprintReadOnly, Category = "PowerLine|Query")
+	float Distance = 0.f;
+
+	// From the wire start, along the curve (cm).
+	UPROPERTY(BlueprintReadOnly, Category = "PowerLine|Query")
+	float DistanceAlongWire = 0.f;
+
+	// Closest point on the wire.
+	UPROPERTY(BlueprintReadOnly, Category = "PowerLine|Query")
+	FVector Location = FVector::ZeroVector;
+};
+
+// Query data of one chunk (or the dynamic wires). Immutable once published, shared with other threads.
+struct FPowerLineChunkQuery
+{
+	PowerLineCore::FSegmentBVH BVH;
+	TArray<TWeakObjectPtr<UPowerLineComponent>> Wires; // FWireSegment::Wire -> component
+	TArray<int32> LineIds;
+	FBox Bounds = FBox(ForceInit);
+
+	SIZE_T GetAllocatedSize() const { return BVH.GetAllocatedSize() + Wires.GetAllocatedSize() + LineIds.GetAllocatedSize(); }
+};
+
+typedef TSharedPtr<const FPowerLineChunkQuery, ESPMode::ThreadSafe> FPowerLineChunkQueryPtr;
+
+// All wire query data of one frame. Never modified once published: grab it (GetQuerySnapshot) and query
+// it from any thread without locks while the game thread builds the next one. Chunk data that did not
+// change is shared between consecutive snapshots.
+struct PROGRAMM_API FPowerLineQuerySnapshot
+{
+	TArray<FPowerLineChunkQueryPtr> Chunks; // Static chunks + dynamic wires
+	TArray<FBox> Bounds;                    // Parallel to Chunks (flat for culling)
+	uint32 Version = 0;
+	int32 NumSegments = 0;
+	double BuildMs = 0.0;                   // Game thread time spent building this version
+
+	bool CapsuleCast(const FVector& Start, const FVector& End, float Radius, bool bAnyHit, FPowerLineWireHit* OutHit) const;
+	bool FindNearest(const FVector& Point, float MaxDistance, FPowerLineWireHit& OutHit) const;
+
+	// Sorted by distance, one hit per wire. Returns the number added.
+	int32 FindInRadius(const FVector& Point, float Radius, TArray<FPowerLineWireHit>& OutHits) const;
+
+	// Includes the (possibly shared) chunk data.
+	SIZE_T GetAllocatedSize() const;
+};
+
+typedef TSharedPtr<const FPowerLineQuerySnapshot, ESPMode::ThreadSafe> FPowerLineQuerySnapshotPtr;
+
+// Bytes held by a subsystem (see powerline.MemReport for the per-chunk/per-district breakdown).
+struct FPowerLineMemoryStats
+{
+	SIZE_T Chunks = 0;
+	SIZE_T Render = 0;       // Component front/back buffers + proxy copies (incl. pooled components)
+	SIZE_T Dynamic = 0;
+	SIZE_T Poles = 0;
+	SIZE_T Hanging = 0;
+	SIZE_T Shapes = 0;
+	SIZE_T Queries = 0;      // Wire query BVHs
+	SIZE_T Bookkeeping = 0;
+
+	SIZE_T GetTotal() const { return Chunks + Render + Dynamic + Poles + Hanging + Shapes + Queries + Bookkeeping; }
+};
+
+// ============================
+// Auto wiring
+// ============================
+
+UENUM(BlueprintType)
+enum class EPowerLineAutoWirePolicy : uint8
+{
+	// Shortest total wire length. Every pole but the first of each network gets exactly one DefaultTargetActor.
+	MinimumSpanningTree UMETA(DisplayName = "Minimum Spanning Tree"),
+
+	// Each pole linked to its K nearest (meshed grid). DefaultTargetActor holds one target per pole, so only a
+	// spanning tree of these links is bound; the rest are returned unbound.
+	NearestK UMETA(DisplayName = "Nearest K"),
+};
+
+USTRUCT(BlueprintType)
+struct FPowerLineAutoWireLink
+{
+	GENERATED_BODY()
+
+	// Wires of From go to To (bound links: From->DefaultTargetActor == To).
+	UPROPERTY(BlueprintReadOnly, Category = "PowerLine|AutoWire")
+	TWeakObjectPtr<APowerLine_Pole> From;
+
+	UPROPERTY(BlueprintReadOnly, Category = "PowerLine|AutoWire")
+	TWeakObjectPtr<APowerLine_Pole> To;
+
+	UPROPERTY(BlueprintReadOnly, Category = "PowerLine|AutoWire")
+	float Length = 0.f;
+
+	// Expressed as From's DefaultTargetActor.
+	UPROPERTY(BlueprintReadOnly, Category = "PowerLine|AutoWire")
+	bool bBound = false;
+};
+
+// Global wind for all wires of a world (districts scale it with WindScale at draw time).
+USTRUCT(BlueprintType)
+struct FPowerLineWindSettings
+{
+	GENERATED_BODY()
+
+	// Horizontal direction the wind blows to (Z is ignored).
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PowerLine|Wind")
+	FVector Direction = FVector(1.f, 0.f, 0.f);
+
+	// Mid-span sway in cm per cm of sag (0 = no wind). Example: 0.1 -> a wire sagging 1 m sways up to ~10-15 cm.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PowerLine|Wind", meta = (ClampMin = "0"))
+	float Strength = 0.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PowerLine|Wind", meta = (ClampMin = "0"))
+	float FrequencyHz = 0.4f;
+
+	// Faster ripple on top of the sway.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PowerLine|Wind", meta = (ClampMin = "0", ClampMax = "1"))
+	float Gust = 0.35f;
+};
+
+// ============================
+// Network wire state
+// Wires are rebuilt deterministically from endpoints, Seed and LineId on every machine, so clients only receive
+// what changed at runtime: connection overrides, style indices (with the style table) and breaks.
+// One fast-array item per changed wire/style, spawned by the server subsystem on first change.
+// Wires must be net addressable (placed in the level or default subobjects of replicated actors).
+// ============================
+
+class APowerLineNetState;
+
+// One runtime style on the server (clients map ServerStyle to a local palette slot).
+USTRUCT()
+struct FPowerLineNetStyle : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int32 ServerStyle = INDEX_NONE;
+
+	UPROPERTY()
+	FColor Color = FColor::Black;
+
+	// Thickness in 1/100 px.
+	UPROPERTY()
+	uint16 ThicknessQ = 200;
+};
+
+USTRUCT()
+struct FPowerLineNetStyleArray : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<FPowerLineNetStyle> Items;
+
+	// Not a UPROPERTY: set by the owning actor's constructor.
+	APowerLineNetState* Owner = nullptr;
+
+	void PostReplicatedAdd(const TArrayView<int32>& AddedIndices, int32 FinalSize);
+	void PostReplicatedChange(const TArrayView<int32>& ChangedIndices, int32 FinalSize);
+	void PreReplicatedRemove(const TArrayView<int32>& RemovedIndices, int32 FinalSize);
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms);
+};
+
+template<>
+struct TStructOpsTypeTraits<FPowerLineNetStyleArray> : public TStructOpsTypeTraitsBase2<FPowerLineNetStyleArray>
+{
+	enum { WithNetDeltaSerializer = true };
+};
+
+// Runtime state of one wire that differs from what the level authored.
+USTRUCT()
+struct FPowerLineNetWire : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TObjectPtr<UPowerLineComponent> Wire = nullptr;
+
+	// Connection override (UPowerLineSubsystem::SetWireTarget), valid when bHasTarget.
+	UPROPERTY()
+	TObjectPtr<AActor> Target = nullptr;
+
+	// Server style index (FPowerLineNetStyle::ServerStyle), INDEX_NONE = authored LineColor/LineThickness.
+	// Full int32: the style palette is not capped, and a narrower field would have to drop the change.
+	UPROPERTY()
+	int32 ServerStyle = INDEX_NONE;
+
+	// Cut position quantized to 1/65534 of the wire (+1), 0 = intact.
+	UPROPERTY()
+	uint16 BreakQ = 0;
+
+	UPROPERTY()
+	uint8 bHasTarget : 1;
+
+	// Server: stable handle of Wire (the bookkeeping key), still distinct once the wire is gone. Not replicated.
+	TObjectKey<UPowerLineComponent> Key;
+
+	FPowerLineNetWire() : bHasTarget(false) {}
+};
+
+USTRUCT()
+struct FPowerLineNetWireArray : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<FPowerLineNetWire> Items;
+
+	APowerLineNetState* Owner = nullptr;
+
+	void PostReplicatedAdd(const TArrayView<int32>& AddedIndices, int32 FinalSize);
+	void PostReplicatedChange(const TArrayView<int32>& ChangedIndices, int32 FinalSize);
+	void PreReplicatedRemove(const TArrayView<int32>& RemovedIndices, int32 FinalSize);
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms);
+};
+
+template<>
+struct TStructOpsTypeTraits<FPowerLineNetWireArray> : public TStructOpsTypeTraitsBase2<FPowerLineNetWireArray>
+{
+	enum { WithNetDeltaSerializer = true };
+};
+
+// Replicated carrier of the wire state (always relevant, no movement).
+UCLASS(NotPlaceable, Transient)
+class PROGRAMM_API APowerLineNetState : public AInfo
+{
+	GENERATED_BODY()
+
+public:
+	APowerLineNetState();
+
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+	virtual void BeginPlay() override;
+
+	// Server: item of a wire/style, added on first use. Call the matching Mark*Dirty after editing it.
+	FPowerLineNetWire& FindOrAddWire(UPowerLineComponent* Line);
+	const FPowerLineNetWire* FindWire(UPowerLineComponent* Line) const;
+	FPowerLineNetStyle& FindOrAddStyle(int32 Style);
+	bool HasStyle(int32 Style) const { return StyleItems.Contains(Style); }
+	void MarkWireDirty(FPowerLineNetWire& Item);
+	void MarkStyleDirty(FPowerLineNetStyle& Item);
+	void RemoveWire(UPowerLineComponent* Line);
+	void RemoveStyle(int32 Style);
+
+	// Server: drops items of wires that were collected without being unregistered as destroyed.
+	void PruneWires();
+
+	// Delta traffic (both ends): bits written/read by the two arrays and the number of non-empty deltas.
+	int64 NetBitsWritten = 0;
+	int64 NetBitsRead = 0;
+	int32 NetDeltasWritten = 0;
+	int32 NetDeltasRead = 0;
+
+	// Server: items marked dirty (one per runtime change).
+	int32 ChangesRecorded = 0;
+
+	void CountDelta(const FNetDeltaSerializeInfo& DeltaParms, int64 BitsBefore);
+
+	UPROPERTY(Replicated)
+	FPowerLineNetStyleArray Styles;
+
+	UPROPERTY(Replicated)
+	FPowerLineNetWireArray Wires;
+
+private:
+	// Server bookkeeping: item index per wire/style (swap removal keeps it O(1)). Wires are keyed by
+	// TObjectKey, which stays unique after the wire is destroyed (a weak pointer would turn into a null key).
+	TMap<TObjectKey<UPowerLineComponent>, int32> WireItems;
+	TMap<int32, int32> StyleItems;
+
+	// RemoveWire calls since the last PruneWires (stale items are swept every PruneInterval removals).
+	int32 RemovalsSincePrune = 0;
+	static constexpr int32 PruneInterval = 64;
+
+	void RemoveWireAt(int32 Index);
 };
 
 // ============================
 // Subsystem (autonomous)
 // ============================
 
+// `stat PowerLine`. Cycle counters and per-frame counters live in PowerLineSystem.cpp,
+// Insights scopes are emitted on the "PowerLine" trace channel.
+DECLARE_STATS_GROUP(TEXT("PowerLine"), STATGROUP_PowerLine, STATCAT_Advanced);
+
 UCLASS()
 class PROGRAMM_API UPowerLineSubsystem : public UWorldSubsystem, public FTickableGameObject
 {
@@ -589,9 +1304,293 @@ class PROGRAMM_API UPowerLineSubsystem : public UWorldSubsystem, public FTickabl
 
 public:
 	// Tune
+	// Chunk cell size. With adaptive chunking this is the root (coarsest) cell, so it can be larger than the fixed-grid default.
 	UPROPERTY(EditAnywhere, Category = "PowerLine")
 	float ChunkSize = 10000.f;
 
+	// Split dense chunks into 4 children (8 with bAdaptiveVertical) and merge them back when sparse.
+	UPROPERTY(EditAnywhere, Category = "PowerLine|Adaptive Chunks")
+	bool bAdaptiveChunking = false;
+
+	// Chunks with more segments than this are split (rebuild cost).
+	UPROPERTY(EditAnywhere, Category = "PowerLine|Adaptive Chunks", meta = (ClampMin = "1", EditCondition = "bAdaptiveChunking"))
+	int32 SplitSegmentThreshold = 20000;
+
+	// Children of a split chunk are merged back when their total is below this (draw calls). Keep well below split threshold.
+	UPROPERTY(EditAnywhere, Category = "PowerLine|Adaptive Chunks", meta = (ClampMin = "0", EditCondition = "bAdaptiveChunking"))
+	int32 MergeSegmentThreshold = 4000;
+
+	UPROPERTY(EditAnywhere, Category = "PowerLine|Adaptive Chunks", meta = (ClampMin = "1", ClampMax = "8", EditCondition = "bAdaptiveChunking"))
+	int32 MaxSplitDepth = 3;
+
+	// Also split along Z (high-rise areas). Set before wires register.
+	UPROPERTY(EditAnywhere, Category = "PowerLine|Adaptive Chunks", meta = (EditCondition = "bAdaptiveChunking"))
+	bool bAdaptiveVertical = false;
+
+	// How often split chunks are checked for merging.
+	UPROPERTY(EditAnywhere, Category = "PowerLine|Adaptive Chunks", meta = (ClampMin = "0", EditCondition = "bAdaptiveChunking"))
+	float AdaptiveMergeIntervalSeconds = 1.f;
+
+	// Reuse wire curves between wires with identical relative span/sag/segments (modular kits). Only wires with a
+	// fixed sag share curves: per-wire sag, or a district with MinCm == MaxCm. Districts randomize sag per wire by
+	// default (SagRangeCm), so in practice the cache serves wires outside districts; the rest count as bypassed.
+	UPROPERTY(EditAnywhere, Category = "PowerLine|Shape Cache")
+	bool bUseShapeCache = true;
+
+	UPROPERTY(EditAnywhere, Category = "PowerLine|Shape Cache", meta = (ClampMin = "16", EditCondition = "bUseShapeCache"))
+	int32 ShapeCacheMaxEntries = 4096;
+
+	// Hits + Misses + Bypassed = static wires built since the last reset.
+	UFUNCTION(BlueprintCallable, Category = "PowerLine|Shape Cache")
+	void GetShapeCacheStats(int64& OutHits, int64& OutMisses, int64& OutBypassed, int32& OutEntries) const;
+
+	UFUNCTION(BlueprintCallable, Category = "PowerLine|Shape Cache")
+	void ResetShapeCache();
+
+	// Static wires drawn from a shared shape as of their chunk's last rebuild, instances of one shape next to
+	// each other (ShapeId order): one instanced draw per shape.
+	void GetShapeInstances(TArray<FPowerLineShapeInstance>& Out) const;
+
+	// Headless: keep only logical wire data (resolved spans, chunk membership); no render components,
+	// HISMs, hanging meshes, segment buffers or mesh streaming.
+	UPROPERTY(EditAnywhere, Category = "PowerLine|Server")
+	EPowerLineHeadlessMode HeadlessMode = EPowerLineHeadlessMode::Auto;
+
+	UFUNCTION(BlueprintPure, Category = "PowerLine|Server")
+	bool IsHeadless() const;
+
+	// Dirty wires are rebuilt serially below this count, with one ParallelFor task per chunk above it.
+	UPROPERTY(EditAnywhere, Category = "PowerLine|Rebuild", meta = (ClampMin = "0"))
+	int32 ParallelRebuildMinWires = 256;
+
+	// Batch edits: inside a batch, dirtying, target rebinds and district refreshes are queued (de-duplicated)
+	// and flushed as one rebuild when the outermost batch ends. In C++ prefer FPowerLineBatchEditScope.
+	UFUNCTION(BlueprintCallable, Category = "PowerLine|Batch")
+	void BeginBatchEdit();
+
+	UFUNCTION(BlueprintCallable, Category = "PowerLine|Batch")
+	void EndBatchEdit();
+
+	UFUNCTION(BlueprintPure, Category = "PowerLine|Batch")
+	bool IsInBatchEdit() const { return BatchEditDepth > 0; }
+
+	// Opens a batch that is closed at the start of the next Tick (editor multi-object edits, undo/redo).
+	void BeginFrameBatchEdit();
+
+	// In-place sag rescale of a district's wires (APowerLineDistrictDataManager::SetSagScale). Segments are
+	// offset vertically and re-uploaded; endpoints, districts and arc-length sampling are not recomputed.
+	// Returns false when a full refresh is needed instead (old scale 0, inside a batch).
+	bool RescaleDistrictSag(APowerLineDistrictDataManager* District, float OldScale, float NewScale);
+
+	// Procedural wiring: links poles found by a spatial-hash neighbour search within MaxSpanCm. Poles only link to
+	// poles with the same attach keys (their wires resolve the far end by key). With bApply the result is bound as
+	// DefaultTargetActor in one batch edit (undoable in the editor). Returns the number of links added to OutLinks.
+	UFUNCTION(BlueprintCallable, Category = "PowerLine|AutoWire")
+	int32 AutoWirePoles(const TArray<APowerLine_Pole*>& Poles, EPowerLineAutoWirePolicy Policy, float MaxSpanCm, int32 NearestK,
+		bool bApply, TArray<FPowerLineAutoWireLink>& OutLinks);
+
+	// Same search over the nodes of a multi-pole component (at their wire attach points, spline-generated nodes
+	// included). Nodes share one attach key, so only MaxSpanCm limits the links. Returns the node index pairs added.
+	UFUNCTION(BlueprintCallable, Category = "PowerLine|AutoWire")
+	int32 AutoWireMultiPoleNodes(UPowerLineMultiPoleComponent* MultiPole, EPowerLineAutoWirePolicy Policy, float MaxSpanCm, int32 NearestK,
+		TArray<FIntPoint>& OutLinks);
+
+	// Queue while batching. Return false when not batching (caller does the work immediately).
+	bool DeferTargetRebind(UPowerLineComponent* Line);
+	bool DeferDistrictRefresh(APowerLineDistrictDataManager* District);
+
+	// Wire styles: segments store a palette index, so restyling never rebuilds geometry. Wires share one style
+	// per LineColor/LineThickness pair; create styles for runtime state (powered, selected, ...) and point wires at them.
+	UFUNCTION(BlueprintCallable, Category = "PowerLine|Style")
+	int32 CreateLineStyle(FColor Color, float Thickness);
+
+	// O(1): one render command, every wire using Style changes on the next frame.
+	UFUNCTION(BlueprintCallable, Category = "PowerLine|Style")
+	void SetLineStyle(int32 Style, FColor Color, float Thickness);
+
+	// The slot is reused once no wire points at it anymore.
+	UFUNCTION(BlueprintCallable, Category = "PowerLine|Style")
+	void ReleaseLineStyle(int32 Style);
+
+	// Points a wire at a created style (INDEX_NONE = back to its LineColor/LineThickness).
+	// Only the palette index of its segments is rewritten (no curve rebuild); chunks are re-uploaded once in Tick.
+	UFUNCTION(BlueprintCallable, Category = "PowerLine|Style")
+	void SetWireStyle(UPowerLineComponent* Line, int32 Style);
+
+	// Palette index of a wire (override, or the shared style of its LineColor/LineThickness). Game thread.
+	int32 ResolveWireStyle(UPowerLineComponent* Line);
+
+	// Shared style for a color/thickness pair. InOutHeld is the caller's current slot: the user count moves to the
+	// returned slot, and a shared slot is freed when its last user moves away or releases it.
+	int32 AcquireSharedStyle(FColor Color, float Thickness, int32& InOutHeld);
+	void ReleaseSharedStyle(int32& InOutHeld);
+
+	const FPowerLineStylePalettePtr& GetStylePalette() const { return StylePaletteRT; }
+
+	// Electrical connectivity: actors are vertices and every registered wire is an edge from its owner to its
+	// effective target (TargetActor, else the pole's DefaultTargetActor). A multi-pole group is part of its owner
+	// actor. Updated on register/unregister and RefreshTargetBinding, also on headless servers. Game thread only.
+	UFUNCTION(BlueprintCallable, Category = "PowerLine|Grid")
+	void SetPowerSource(AActor* Actor, bool bIsSource);
+
+	// Connected (through any wires) to a power source.
+	UFUNCTION(BlueprintCallable, Category = "PowerLine|Grid")
+	bool IsPowered(AActor* Actor) const;
+
+	UFUNCTION(BlueprintCallable, Category = "PowerLine|Grid")
+	bool AreConnected(AActor* A, AActor* B) const;
+
+	// Every actor connected to Actor (Actor included). Returns the number added.
+	UFUNCTION(BlueprintCallable, Category = "PowerLine|Grid")
+	int32 GetConnectedActors(AActor* Actor, TArray<AActor*>& OutActors) const;
+
+	// Wires whose effective target is Actor. Returns the number added.
+	UFUNCTION(BlueprintCallable, Category = "PowerLine|Grid")
+	int32 GetWiresFeedingActor(AActor* Actor, TArray<UPowerLineComponent*>& OutWires) const;
+
+	UFUNCTION(BlueprintCallable, Category = "PowerLine|Grid")
+	void GetGridStats(int32& OutActors, int32& OutWires, int32& OutComponents) const;
+
+	// Re-reads the wire's owner/target edge (RefreshTargetBinding, register).
+	void UpdateWireConnection(UPowerLineComponent* Line);
+
+	// Cuts a wire at BreakT (0..1 along its length); both ends then hang from their attach points. Only the wire's own
+	// segment range is rewritten (same segment count, chunk layout untouched), its hanging mesh is dropped and its
+	// connectivity edge removed. Replicated on servers. Bundles break all their conductors.
+	UFUNCTION(BlueprintCallable, Category = "PowerLine|Break")
+	bool BreakWire(UPowerLineComponent* Line, float BreakT);
+
+	// Repairs a broken wire through the same in-place path (edge and hanging mesh come back).
+	UFUNCTION(BlueprintCallable, Category = "PowerLine|Break")
+	bool ReconnectWire(UPowerLineComponent* Line);
+
+	UFUNCTION(BlueprintCallable, Category = "PowerLine|Break")
+	bool IsWireBroken(const UPowerLineComponent* Line) const { return Line && Line->IsBroken(); }
+
+	// Runtime connection change (rebinds and rebuilds the wire). On a server this is replicated to clients.
+	UFUNCTION(BlueprintCallable, Category = "PowerLine|Network")
+	void SetWireTarget(UPowerLineComponent* Line, AActor* Target);
+
+	// Replicated wire-state traffic (powerline.NetStats). Bytes are summed over all client connections.
+	UFUNCTION(BlueprintCallable, Category = "PowerLine|Network")
+	void GetNetStats(int32& OutChanges, int64& OutBytesSent, int64& OutBytesReceived, int32& OutDeltasSent) const;
+
+	// Starts a new measurement window (powerline.NetStats reset, powerline.NetBench).
+	UFUNCTION(BlueprintCallable, Category = "PowerLine|Network")
+	void ResetNetStats();
+
+	// True on listen/dedicated servers: runtime wire changes go into the replicated state.
+	bool IsNetServer() const;
+
+	// Client side of APowerLineNetState (fast array callbacks).
+	void ApplyNetStyle(const FPowerLineNetStyle& Item);
+	void RemoveNetStyle(const FPowerLineNetStyle& Item);
+	void ApplyNetWire(const FPowerLineNetWire& Item);
+	void RemoveNetWire(const FPowerLineNetWire& Item);
+
+	// Wire queries: per-chunk BVHs over the wire curves, rebuilt with their chunk (no physics bodies).
+	UPROPERTY(EditAnywhere, Category = "PowerLine|Query")
+	bool bEnableWireQueries = true;
+
+	// Wire thickness for RaycastWires / SegmentIntersectsWires (cm, radius).
+	UPROPERTY(EditAnywhere, Category = "PowerLine|Query", meta = (ClampMin = "0", EditCondition = "bEnableWireQueries"))
+	float WireQueryRadius = 2.f;
+
+	// Closest wire along Start->End. Safe to call from any thread.
+	UFUNCTION(BlueprintCallable, Category = "PowerLine|Query")
+	bool RaycastWires(const FVector& Start, const FVector& End, FPowerLineWireHit& OutHit) const;
+
+	// Closest wire touched by a sphere moving Start->End. Safe to call from any thread.
+	UFUNCTION(BlueprintCallable, Category = "PowerLine|Query")
+	bool SweepSphereWires(const FVector& Start, const FVector& End, float SphereRadius, FPowerLineWireHit& OutHit) const;
+
+	// Any wire crossing Start->End (line of sight; stops at the first hit). Safe to call from any thread.
+	UFUNCTION(BlueprintCallable, Category = "PowerLine|Query")
+	bool SegmentIntersectsWires(const FVector& Start, const FVector& End) const;
+
+	// Closest wire to Point (MaxDistance <= 0: unlimited). Safe to call from any thread.
+	UFUNCTION(BlueprintCallable, Category = "PowerLine|Query")
+	bool FindNearestWire(const FVector& Point, float MaxDistance, FPowerLineWireHit& OutHit) const;
+
+	// Every wire within Radius of Point, closest first (one hit per wire). Safe to call from any thread.
+	UFUNCTION(BlueprintCallable, Category = "PowerLine|Query")
+	int32 FindWiresInRadius(const FVector& Point, float Radius, TArray<FPowerLineWireHit>& OutHits) const;
+
+	// Latest published query data (null before the first build). Tasks running many queries should
+	// grab it once; it stays valid (and unchanged) for as long as they hold it.
+	FPowerLineQuerySnapshotPtr GetQuerySnapshot() const;
+
+	// Snapshot version/size/memory plus sampled query latency (powerline.QueryStats).
+	void DumpQueryStats(FOutputDevice& Ar, int32 Samples = 1000) const;
+
+	// Wind sway: applied per vertex by the render proxies at draw time (no rebuild, no upload, no game-thread cost).
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PowerLine|Wind")
+	FPowerLineWindSettings Wind;
+
+	UFUNCTION(BlueprintCallable, Category = "PowerLine|Wind")
+	void SetWind(const FPowerLineWindSettings& NewWind);
+
+	// Wind as last pushed to the render components.
+	const PowerLineCore::FWindParams& GetWindParams() const { return PushedWind; }
+	float GetMaxWindScale() const { return PushedMaxWindScale; }
+
+	// Cable simulation tier: wires near a camera or hit by AddCableImpulse are simulated (Verlet, worker threads)
+	// within a fixed particle budget and go back to their static curve once settled. Needs bEnableWireQueries.
+	UPROPERTY(EditAnywhere, Category = "PowerLine|Simulation")
+	bool bEnableCableSimulation = false;
+
+	// Wires closer than this to a view are simulated while they stay in range (0 = impulses only).
+	UPROPERTY(EditAnywhere, Category = "PowerLine|Simulation", meta = (ClampMin = "0", EditCondition = "bEnableCableSimulation"))
+	float SimulationCameraRadius = 3000.f;
+
+	// Max simulated particles (segments + 1 per wire). Nearest wires win when over budget.
+	UPROPERTY(EditAnywhere, Category = "PowerLine|Simulation", meta = (ClampMin = "0", EditCondition = "bEnableCableSimulation"))
+	int32 SimulationParticleBudget = 4096;
+
+	// Wires slower than SettleSpeed for SettleSeconds (and out of camera range) are demoted.
+	UPROPERTY(EditAnywhere, Category = "PowerLine|Simulation", meta = (ClampMin = "0", EditCondition = "bEnableCableSimulation"))
+	float SimulationSettleSpeed = 5.f;
+
+	UPROPERTY(EditAnywhere, Category = "PowerLine|Simulation", meta = (ClampMin = "0", EditCondition = "bEnableCableSimulation"))
+	float SimulationSettleSeconds = 1.5f;
+
+	UPROPERTY(EditAnywhere, Category = "PowerLine|Simulation", meta = (ClampMin = "0", ClampMax = "1", EditCondition = "bEnableCableSimulation"))
+	float SimulationDamping = 0.02f;
+
+	UPROPERTY(EditAnywhere, Category = "PowerLine|Simulation", meta = (ClampMin = "1", ClampMax = "32", EditCondition = "bEnableCableSimulation"))
+	int32 SimulationIterations = 6;
+
+	// Pushes wires within Radius of Center (explosion, hit pole). Returns the number of wires affected.
+	UFUNCTION(BlueprintCallable, Category = "PowerLine|Simulation")
+	int32 AddCableImpulse(const FVector& Center, float Radius, const FVector& VelocityCmPerSec);
+
+	// Simulated wires/particles and solver time of the last frame.
+	UFUNCTION(BlueprintCallable, Category = "PowerLine|Simulation")
+	void GetCableSimStats(int32& OutWires, int32& OutParticles, float& OutSolveMs) const;
+
+	// Empty chunks are reclaimed after this long (their render component goes back to the pool).
+	UPROPERTY(EditAnywhere, Category = "PowerLine|Chunks", meta = (ClampMin = "0"))
+	float EmptyChunkGraceSeconds = 5.f;
+
+	// Render components kept for reuse; extra ones are destroyed.
+	UPROPERTY(EditAnywhere, Category = "PowerLine|Chunks", meta = (ClampMin = "0"))
+	int32 MaxPooledRenderComponents = 32;
+
+	// Live = chunks with wires, Pooled = idle render components, Empty = chunks waiting for reclaim.
+	UFUNCTION(BlueprintCallable, Category = "PowerLine|Chunks")
+	void GetChunkStats(int32& OutLive, int32& OutPooled, int32& OutEmpty) const;
+
+	// Auto wires seen moving on this many frames (within DynamicMotionWindowSeconds between moves) become dynamic.
+	UPROPERTY(EditAnywhere, Category = "PowerLine|Dynamic", meta = (ClampMin = "1"))
+	int32 DynamicPromoteMoveCount = 3;
+
+	UPROPERTY(EditAnywhere, Category = "PowerLine|Dynamic", meta = (ClampMin = "0.01"))
+	float DynamicMotionWindowSeconds = 0.5f;
+
+	// Auto dynamic wires that did not move for this long go back to static chunks.
+	UPROPERTY(EditAnywhere, Category = "PowerLine|Dynamic", meta = (ClampMin = "0"))
+	float DynamicSettleSeconds = 2.f;
+
 	// UWorldSubsystem
 	virtual bool ShouldCreateSubsystem(UObject* Outer) const override { return true; }
 
@@ -607,13 +1606,25 @@ public:
 
 	virtual TStatId GetStatId() const override
 	{
-		RETURN_QUICK_DECLARE_CYCLE_STAT(UPowerLineSubsystem, STATGROUP_Tickables);
+		RETURN_QUICK_DECLARE_CYCLE_STAT(UPowerLineSubsystem, STATGROUP_PowerLine);
 	}
 
 	// API for component
 	void RegisterPowerLine(UPowerLineComponent* Line);
 	void UnregisterPowerLine(UPowerLineComponent* Line);
-	void MarkPowerLineDirty(UPowerLineComponent* Line);
+	void MarkPowerLineDirty(UPowerLineComponent* Line, EPowerLineDirtyCause Cause = EPowerLineDirtyCause::Property);
+
+	// Own/target transform changed (feeds Auto mobility classification).
+	void MarkPowerLineMoved(UPowerLineComponent* Line, EPowerLineDirtyCause Cause = EPowerLineDirtyCause::OwnTransform);
+
+	int32 GetNumDynamicLines() const { return DynamicLines.Num(); }
+
+	// Bytes per chunk and per district (powerline.MemReport). MaxChunks < 0 lists every chunk.
+	void DumpMemoryReport(FOutputDevice& Ar, int32 MaxChunks = 20) const;
+	FPowerLineMemoryStats GetMemoryStats() const;
+
+	// Rolling top-N most expensive / most often dirtied wires (powerline.Watchdog=1, powerline.DumpWatchdog).
+	void DumpWatchdog(FOutputDevice& Ar, int32 TopN = 10) const;
 
 	// Poles batching (HISM)
 	void RegisterPole(UPowerLinePoleComponent* Pole);
@@ -624,14 +1635,102 @@ public:
 	void UpdateHangingForLine(UPowerLineComponent* Line);
 	void RemoveHangingForLine(UPowerLineComponent* Line);
 
+	// Mesh streaming (soft references).
+	// Returns the mesh if loaded, otherwise starts an async load and notifies Requester when done
+	// (wires re-place hanging meshes, poles re-add instances, multi-poles rebuild).
+	UStaticMesh* RequestMesh(const TSoftObjectPtr<UStaticMesh>& Mesh, UObject* Requester);
+
+	// Use counting: streamed meshes are released when the last HISM/component using them goes away.
+	void AddMeshUser(const UStaticMesh* Mesh);
+	void ReleaseMeshUser(const FSoftObjectPath& Path);
+
+	int32 GetNumStreamedMeshes() const { return StreamedMeshes.Num(); }
+
 private:
 	// Hidden host actor for render components (spawned once)
 	AActor* EnsureRenderHost();
 	FPowerLineChunkKey CalcKey(const FVector& Pos) const;
+
+	// Fixed grid key (level 0). Poles always use it so HISMs don't churn on splits.
+	FPowerLineChunkKey CalcRootKey(const FVector& Pos) const;
+	FPowerLineChunkKey CalcKeyAtLevel(const FVector& Pos, int32 Level) const;
+	static FPowerLineChunkKey GetParentKey(const FPowerLineChunkKey& Key);
 	void EnsureRenderComponent(const FPowerLineChunkKey& Key);
 
+	// Chunk lifecycle
+	void ReleaseRenderComponent(const FPowerLineChunkKey& Key);
+	void ReclaimEmptyChunks();
+
 	// Move line between chunks if needed
 	void UpdateLineChunk(UPowerLineComponent* Line, const FPowerLineChunkKey& NewKey);
+	void RemoveLineFromChunk(UPowerLineComponent* Line);
+
+	// Static <-> dynamic
+	void PromoteToDynamic(UPowerLineComponent* Line);
+	void DemoteToStatic(UPowerLineComponent* Line);
+	void RemoveFromDynamic(UPowerLineComponent* Line);
+
+	// Adaptive chunking
+	void SplitChunk(const FPowerLineChunkKey& Key);
+	void MergeSparseChunks();
+	void RehomeChunkLines(const FPowerLineChunkKey& Key);
+
+	// Tick stages
+	void RebuildDirtyChunks();
+	void UpdateDynamicLines();
+	void ProcessDirtyPoles();
+
+	// Watchdog
+	void RecordWireRebuild(UPowerLineComponent* Line, double Ms);
+	void UpdateWatchdog(double TickMs);
+
+	// Batch edits
+	void FlushBatchEdit();
+
+	// Headless: resolve dirty wires only (no chunk-wide rebuilds); chunks just track membership.
+	void UpdateHeadlessLines();
+	void RebuildDirtyChunksHeadless();
+
+	// Debug view (powerline.Debug.Heatmap)
+	FBox GetChunkCellBox(const FPowerLineChunkKey& Key) const;
+	void DrawDebugHeatmap(int32 Mode) const;
+
+	// Wind
+	void PushWindToRenderComponents();
+	// Wind scale slot of a district's wires (allocated on first use, game thread).
+	uint16 ResolveWindGroup(APowerLineDistrictDataManager* District);
+
+	// Style slot and wind group of a resolved build (the game-thread steps of every rebuild path).
+	void ResolveBuildResources(UPowerLineComponent* Line, FPowerLineWireBuild& Build);
+	void PushWindScale(int32 Group);
+
+	// Breaks: rewrite a wire's segment range from its resolved span
+	void UpdateWireInPlace(UPowerLineComponent* Line);
+	// Ground under both anchors of a breaking wire (BreakGroundZ).
+	void TraceBreakGround(UPowerLineComponent* Line) const;
+
+	// Styles
+	int32 AllocateStyle(const FPowerLineStyle& Style, bool bShared);
+	void FreeStyle(int32 Index);
+	// Runtime style user count of a wire's StyleOverride (registered wires only).
+	void AddStyleUser(int32 Index);
+	void RemoveStyleUser(int32 Index);
+	void PushStyle(int32 Index);
+
+	// Connectivity
+	int32 FindOrAddGridVertex(AActor* Actor);
+	int32 FindGridVertex(AActor* Actor) const;
+	void ReleaseGridVertex(int32 Vertex);
+	void RemoveWireConnection(UPowerLineComponent* Line);
+
+	// Cable simulation
+	void UpdateCableSimulation(float DeltaTime);
+	int32 PromoteToSimulation(UPowerLineComponent* Line);
+	void RemoveFromSimulation(int32 Index);
+
+	// Wire queries
+	void UpdateWireQueries();
+	void PublishQuerySnapshot(double BuildStart);
 
 private:
 	UPROPERTY(Transient)
@@ -641,6 +1740,123 @@ private:
 	TMap<FPowerLineChunkKey, TWeakObjectPtr<UPowerLineRenderComponent>> RenderComponents;
 	TSet<FPowerLineChunkKey> DirtyChunks;
 
+	// Chunks rebuilt with no lines (candidates for reclaim) and idle render components.
+	TSet<FPowerLineChunkKey> EmptyChunks;
+	TArray<TWeakObjectPtr<UPowerLineRenderComponent>> RenderComponentPool;
+
+	// Adaptive chunking: keys that are subdivided (their lines live in children).
+	TSet<FPowerLineChunkKey> SplitChunks;
+	double LastMergeCheckTime = 0.0;
+
+	PowerLineCore::FShapeCache ShapeCache;
+
+	PowerLineCore::FWindParams PushedWind;
+
+	// District wind scales by group (slot 0 = no district). Segments keep the group, the proxies look the scale up.
+	TMap<TWeakObjectPtr<APowerLineDistrictDataManager>, uint16> WindGroups;
+	TArray<TWeakObjectPtr<APowerLineDistrictDataManager>> WindGroupDistricts;
+	TArray<float> PushedWindScales = { 1.f };
+	float PushedMaxWindScale = 1.f;
+
+	// ===== Styles =====
+	struct FStyleSlot
+	{
+		FPowerLineStyle Style;
+		int32 Users = 0;       // Wires with StyleOverride == this slot (shared: holders of the slot)
+		bool bLive = false;
+		bool bShared = false;  // LineColor/LineThickness style (SharedStyles)
+		bool bReleased = false; // Freed once Users drops to 0
+		uint32 Serial = 0;      // Unique per allocation
+	};
+
+	TArray<FStyleSlot> StyleSlots;
+	TArray<int32> FreeStyles;
+	uint32 NextStyleSerial = 0;
+	TMap<uint64, int32> SharedStyles; // Packed color + thickness -> slot
+	TSet<FPowerLineChunkKey> InPlaceUploadChunks; // Segments rewritten in place (styles, breaks), uploaded once in Tick
+	FPowerLineStylePalettePtr StylePaletteRT = MakeShared<FPowerLineStylePalette, ESPMode::ThreadSafe>();
+
+	// ===== Headless =====
+	TSet<TWeakObjectPtr<UPowerLineComponent>> HeadlessDirtyLines;
+
+	// ===== Connectivity graph =====
+	PowerLineCore::FConnectivityGraph Grid;
+	TMap<TWeakObjectPtr<AActor>, int32> GridVertexByActor;
+	TArray<TWeakObjectPtr<AActor>> GridActors;                  // By vertex
+	TArray<int32> GridVertexRefs;                               // Wire ends + source flag
+	TArray<TWeakObjectPtr<UPowerLineComponent>> GridEdgeWires;  // By edge
+	TSet<TWeakObjectPtr<AActor>> PowerSources;
+
+	// ===== Network state =====
+	friend class APowerLineNetState;
+	TWeakObjectPtr<APowerLineNetState> NetState;  // Server: spawned on the first runtime change; clients: the replicated one
+	TMap<int32, int32> NetStyleToLocal;           // Client: server style index -> local slot
+	TMap<TWeakObjectPtr<UPowerLineComponent>, int32> NetStyleWaiting; // Client: wire -> server style not received yet
+
+	APowerLineNetState* EnsureNetState();
+	void ReplicateWireState(UPowerLineComponent* Line);
+	void ReplicateStyle(int32 Style);
+	int32 ResolveNetStyle(UPowerLineComponent* Line, int32 ServerStyle);
+
+	// ===== Wire queries =====
+	// Game thread only: per-chunk data, rebuilt at the end of Tick and published as a new snapshot.
+	TSet<FPowerLineChunkKey> QueryDirtyChunks;
+	bool bDynamicQueryDirty = false;
+	TMap<FPowerLineChunkKey, FPowerLineChunkQueryPtr> ChunkQueries;
+	FPowerLineChunkQueryPtr DynamicQuery;
+	uint32 QuerySnapshotVersion = 0;
+
+	// Only guards the pointer swap; queries run on their own reference.
+	mutable FRWLock QuerySnapshotLock;
+	FPowerLineQuerySnapshotPtr QuerySnapshot;
+
+	// ===== Batch edits =====
+	int32 BatchEditDepth = 0;
+	bool bFrameBatchOpen = false;
+	TMap<TWeakObjectPtr<UPowerLineComponent>, EPowerLineDirtyCause> DeferredDirty;
+	TSet<TWeakObjectPtr<UPowerLineComponent>> DeferredRebinds;
+	TSet<TWeakObjectPtr<APowerLineDistrictDataManager>> DeferredDistricts;
+
+	// ===== Watchdog (only filled while powerline.Watchdog is on) =====
+	struct FWatchdogEntry
+	{
+		// Decayed sums (halved every window), so the lists follow recent activity.
+		double Ms = 0.0;
+		float Rebuilds = 0.f;
+		float Dirties = 0.f;
+		double MaxMs = 0.0;
+		EPowerLineDirtyCause LastCause = EPowerLineDirtyCause::Unknown;
+	};
+
+	TMap<TWeakObjectPtr<UPowerLineComponent>, FWatchdogEntry> WatchdogEntries;
+	TArray<TPair<TWeakObjectPtr<UPowerLineComponent>, double>, TInlineAllocator<4>> WatchdogFrameWorst;
+	int32 WatchdogFrameRebuilds = 0;
+	double WatchdogWindowStart = 0.0;
+	double LastBudgetWarningTime = 0.0;
+
+	// ===== Cable simulation =====
+	struct FSimWire
+	{
+		TWeakObjectPtr<UPowerLineComponent> Line;
+		PowerLineCore::FCableState State;
+		FVector PinA = FVector::ZeroVector;
+		FVector PinB = FVector::ZeroVector;
+		double QuietSince = 0.0; // When it got slower than SimulationSettleSpeed (0 = moving)
+		bool bNearCamera = false;
+	};
+
+	TArray<FSimWire> SimWires;
+	int32 SimParticles = 0;
+	float SimSolveMs = 0.f;
+	TArray<FPowerLineSegment> SimSegments;
+	TWeakObjectPtr<UPowerLineRenderComponent> SimRender;
+
+	// ===== Dynamic wires (moving endpoints) =====
+	TArray<TWeakObjectPtr<UPowerLineComponent>> DynamicLines;
+	TArray<FPowerLineSegment> DynamicSegments;
+	TWeakObjectPtr<UPowerLineRenderComponent> DynamicRender;
+	bool bDynamicDirty = false;
+
 	// ===== Poles batching =====
 	struct FPoleHISMData
 	{
@@ -669,4 +1885,31 @@ private:
 
 	// One (optional) static mesh component per wire
 	TMap<TWeakObjectPtr<UPowerLineComponent>, TWeakObjectPtr<UStaticMeshComponent>> HangingByLine;
+
+	// ===== Mesh streaming =====
+	struct FStreamedMesh
+	{
+		TSharedPtr<FStreamableHandle> Handle;
+		TArray<TWeakObjectPtr<UObject>> Waiting;
+		int32 Users = 0;
+	};
+
+	FStreamableManager MeshStreamable;
+	TMap<FSoftObjectPath, FStreamedMesh> StreamedMeshes;
+
+	void OnMeshLoaded(FSoftObjectPath Path);
+	void DestroyHangingComponent(UStaticMeshComponent* Comp);
+};
+
+// RAII batch edit (nestable):
+//   { FPowerLineBatchEditScope Batch(GetWorld()); ...move/edit many poles... }  // one rebuild here
+struct PROGRAMM_API FPowerLineBatchEditScope
+{
+	explicit FPowerLineBatchEditScope(UWorld* World);
+	~FPowerLineBatchEditScope();
+
+	UE_NONCOPYABLE(FPowerLineBatchEditScope);
+
+private:
+	TWeakObjectPtr<UPowerLineSubsystem> Subsystem;
 };